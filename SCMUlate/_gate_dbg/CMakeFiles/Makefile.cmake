@@ -0,0 +1,156 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/SCMUlate/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/SCMUlate/apps/CMakeLists.txt"
+  "/root/repo/SCMUlate/apps/allInst/CMakeLists.txt"
+  "/root/repo/SCMUlate/apps/allInst/myProg.scm"
+  "/root/repo/SCMUlate/apps/matrixMult/CMakeLists.txt"
+  "/root/repo/SCMUlate/apps/matrixMult/Codelets/CMakeLists.txt"
+  "/root/repo/SCMUlate/apps/matrixMult/matMul128x1280.scm"
+  "/root/repo/SCMUlate/apps/matrixMult/matMul128x1280gpu.scm"
+  "/root/repo/SCMUlate/apps/matrixMult/matMul1tile.scm"
+  "/root/repo/SCMUlate/apps/matrixMult/matMul1tileGPU.scm"
+  "/root/repo/SCMUlate/apps/vectorAddition/CMakeLists.txt"
+  "/root/repo/SCMUlate/apps/vectorAddition/Codelets/CMakeLists.txt"
+  "/root/repo/SCMUlate/apps/vectorAddition/vectorAddLoop.scm"
+  "/root/repo/SCMUlate/apps/vectorAddition/vectorAddLoopUnrolled.scm"
+  "/root/repo/SCMUlate/apps/vectorAddition/vectorAddNoLoop.scm"
+  "/root/repo/SCMUlate/benchmarks/CMakeLists.txt"
+  "/root/repo/SCMUlate/src/CMakeLists.txt"
+  "/root/repo/SCMUlate/src/codelet_model/CMakeLists.txt"
+  "/root/repo/SCMUlate/src/common/CMakeLists.txt"
+  "/root/repo/SCMUlate/src/machines/CMakeLists.txt"
+  "/root/repo/SCMUlate/src/modules/CMakeLists.txt"
+  "/root/repo/SCMUlate/src/system_codelets/CMakeLists.txt"
+  "/root/repo/SCMUlate/tests/CMakeLists.txt"
+  "/root/repo/SCMUlate/tests/modules/CMakeLists.txt"
+  "/root/repo/SCMUlate/tests/modules/test_bad_immediate_file.txt"
+  "/root/repo/SCMUlate/tests/modules/test_bad_register_file.txt"
+  "/root/repo/SCMUlate/tests/modules/test_machine_file.txt"
+  "/root/repo/SCMUlate/tests/modules/test_mem_file.txt"
+  "/root/repo/SCMUlate/tests/modules/test_rename_file.txt"
+  "/root/repo/SCMUlate/tests/modules/test_run_error_file.txt"
+  "/root/repo/SCMUlate/tests/modules/test_run_file.txt"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckFunctionExists.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindBLAS.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/modules/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/machines/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/codelet_model/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/system_codelets/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/common/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/modules/test_machine_file.txt"
+  "tests/modules/test_mem_file.txt"
+  "tests/modules/test_rename_file.txt"
+  "tests/modules/test_bad_register_file.txt"
+  "tests/modules/test_bad_immediate_file.txt"
+  "tests/modules/test_rename_file.txt"
+  "tests/modules/test_run_file.txt"
+  "tests/modules/test_run_error_file.txt"
+  "tests/modules/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "apps/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "apps/allInst/myProg.scm"
+  "apps/allInst/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "apps/vectorAddition/vectorAddNoLoop.scm"
+  "apps/vectorAddition/vectorAddLoop.scm"
+  "apps/vectorAddition/vectorAddLoopUnrolled.scm"
+  "apps/vectorAddition/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "apps/vectorAddition/Codelets/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "apps/matrixMult/matMul1tile.scm"
+  "apps/matrixMult/matMul1tileGPU.scm"
+  "apps/matrixMult/matMul128x1280.scm"
+  "apps/matrixMult/matMul128x1280gpu.scm"
+  "apps/matrixMult/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "apps/matrixMult/Codelets/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmarks/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/SCMUlate.dir/DependInfo.cmake"
+  "src/modules/CMakeFiles/registers.dir/DependInfo.cmake"
+  "src/modules/CMakeFiles/instruction_mem.dir/DependInfo.cmake"
+  "src/modules/CMakeFiles/fetch_decode.dir/DependInfo.cmake"
+  "src/modules/CMakeFiles/executor.dir/DependInfo.cmake"
+  "src/modules/CMakeFiles/memory_interface.dir/DependInfo.cmake"
+  "src/modules/CMakeFiles/l2_memory.dir/DependInfo.cmake"
+  "src/modules/CMakeFiles/control_store.dir/DependInfo.cmake"
+  "src/modules/CMakeFiles/scm_timers_counters.dir/DependInfo.cmake"
+  "src/machines/CMakeFiles/scm_machine.dir/DependInfo.cmake"
+  "src/codelet_model/CMakeFiles/scm_codelet.dir/DependInfo.cmake"
+  "src/system_codelets/CMakeFiles/scm_system_codelets.dir/DependInfo.cmake"
+  "src/common/CMakeFiles/scm_string_helper.dir/DependInfo.cmake"
+  "src/common/CMakeFiles/scm_instructions.dir/DependInfo.cmake"
+  "src/common/CMakeFiles/scm_threads_config.dir/DependInfo.cmake"
+  "src/common/CMakeFiles/scm_memory_pages.dir/DependInfo.cmake"
+  "tests/modules/CMakeFiles/test_reg_file.dir/DependInfo.cmake"
+  "tests/modules/CMakeFiles/test_inst_mem.dir/DependInfo.cmake"
+  "tests/modules/CMakeFiles/test_instructions.dir/DependInfo.cmake"
+  "tests/modules/CMakeFiles/test_ilp_controller.dir/DependInfo.cmake"
+  "tests/modules/CMakeFiles/test_register_rename.dir/DependInfo.cmake"
+  "tests/modules/CMakeFiles/test_control_store.dir/DependInfo.cmake"
+  "tests/modules/CMakeFiles/test_sched_policy.dir/DependInfo.cmake"
+  "tests/modules/CMakeFiles/test_threads_config.dir/DependInfo.cmake"
+  "tests/modules/CMakeFiles/test_l2_memory.dir/DependInfo.cmake"
+  "tests/modules/CMakeFiles/test_register_arith.dir/DependInfo.cmake"
+  "tests/modules/CMakeFiles/test_timers_counters.dir/DependInfo.cmake"
+  "tests/modules/CMakeFiles/test_scm_machine.dir/DependInfo.cmake"
+  "tests/modules/CMakeFiles/test_scm_multi_machine.dir/DependInfo.cmake"
+  "apps/vectorAddition/CMakeFiles/VecAdd.dir/DependInfo.cmake"
+  "apps/vectorAddition/Codelets/CMakeFiles/vect_add_codelet.dir/DependInfo.cmake"
+  "apps/matrixMult/CMakeFiles/MatMul.dir/DependInfo.cmake"
+  "apps/matrixMult/CMakeFiles/SchedMatMul.dir/DependInfo.cmake"
+  "apps/matrixMult/Codelets/CMakeFiles/mat_mul_cod.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/benchProgramLoad.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/benchDispatch.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/benchIdlePolicy.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/benchMachineReuse.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/benchMultiTenant.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/benchRegisterArith.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,35 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/SCMUlate/main_SCMUlate.cpp" "CMakeFiles/SCMUlate.dir/main_SCMUlate.cpp.o" "gcc" "CMakeFiles/SCMUlate.dir/main_SCMUlate.cpp.o.d"
+  "/root/repo/SCMUlate/src/system_codelets/cod_print.cpp" "CMakeFiles/SCMUlate.dir/src/system_codelets/cod_print.cpp.o" "gcc" "CMakeFiles/SCMUlate.dir/src/system_codelets/cod_print.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/SCMUlate/_gate_dbg/src/machines/CMakeFiles/scm_machine.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/system_codelets/CMakeFiles/scm_system_codelets.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/modules/CMakeFiles/instruction_mem.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/modules/CMakeFiles/registers.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/modules/CMakeFiles/fetch_decode.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/modules/CMakeFiles/executor.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/modules/CMakeFiles/control_store.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/modules/CMakeFiles/memory_interface.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/modules/CMakeFiles/l2_memory.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/common/CMakeFiles/scm_memory_pages.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/common/CMakeFiles/scm_string_helper.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/modules/CMakeFiles/scm_timers_counters.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/common/CMakeFiles/scm_instructions.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/codelet_model/CMakeFiles/scm_codelet.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/common/CMakeFiles/scm_threads_config.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
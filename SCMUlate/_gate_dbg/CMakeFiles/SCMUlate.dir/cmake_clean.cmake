@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/SCMUlate.dir/main_SCMUlate.cpp.o"
+  "CMakeFiles/SCMUlate.dir/main_SCMUlate.cpp.o.d"
+  "CMakeFiles/SCMUlate.dir/src/system_codelets/cod_print.cpp.o"
+  "CMakeFiles/SCMUlate.dir/src/system_codelets/cod_print.cpp.o.d"
+  "SCMUlate"
+  "SCMUlate.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SCMUlate.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,10 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/SCMUlate
+# Build directory: /root/repo/SCMUlate/_gate_dbg
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("src")
+subdirs("tests")
+subdirs("apps")
+subdirs("benchmarks")
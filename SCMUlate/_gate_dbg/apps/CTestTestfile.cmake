@@ -0,0 +1,9 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/SCMUlate/apps
+# Build directory: /root/repo/SCMUlate/_gate_dbg/apps
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("allInst")
+subdirs("vectorAddition")
+subdirs("matrixMult")
@@ -0,0 +1,37 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/SCMUlate/apps/matrixMult/Codelets/MatMul.cpp" "apps/matrixMult/CMakeFiles/MatMul.dir/Codelets/MatMul.cpp.o" "gcc" "apps/matrixMult/CMakeFiles/MatMul.dir/Codelets/MatMul.cpp.o.d"
+  "/root/repo/SCMUlate/src/system_codelets/cod_print.cpp" "apps/matrixMult/CMakeFiles/MatMul.dir/__/__/src/system_codelets/cod_print.cpp.o" "gcc" "apps/matrixMult/CMakeFiles/MatMul.dir/__/__/src/system_codelets/cod_print.cpp.o.d"
+  "/root/repo/SCMUlate/apps/matrixMult/mainMatMul.cpp" "apps/matrixMult/CMakeFiles/MatMul.dir/mainMatMul.cpp.o" "gcc" "apps/matrixMult/CMakeFiles/MatMul.dir/mainMatMul.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/SCMUlate/_gate_dbg/src/machines/CMakeFiles/scm_machine.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/apps/matrixMult/Codelets/CMakeFiles/mat_mul_cod.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/system_codelets/CMakeFiles/scm_system_codelets.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/modules/CMakeFiles/instruction_mem.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/modules/CMakeFiles/registers.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/modules/CMakeFiles/fetch_decode.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/modules/CMakeFiles/executor.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/modules/CMakeFiles/control_store.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/modules/CMakeFiles/memory_interface.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/modules/CMakeFiles/l2_memory.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/common/CMakeFiles/scm_memory_pages.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/common/CMakeFiles/scm_string_helper.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/modules/CMakeFiles/scm_timers_counters.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/common/CMakeFiles/scm_instructions.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/common/CMakeFiles/scm_threads_config.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/codelet_model/CMakeFiles/scm_codelet.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/MatMul.dir/Codelets/MatMul.cpp.o"
+  "CMakeFiles/MatMul.dir/Codelets/MatMul.cpp.o.d"
+  "CMakeFiles/MatMul.dir/__/__/src/system_codelets/cod_print.cpp.o"
+  "CMakeFiles/MatMul.dir/__/__/src/system_codelets/cod_print.cpp.o.d"
+  "CMakeFiles/MatMul.dir/mainMatMul.cpp.o"
+  "CMakeFiles/MatMul.dir/mainMatMul.cpp.o.d"
+  "MatMul"
+  "MatMul.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/MatMul.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
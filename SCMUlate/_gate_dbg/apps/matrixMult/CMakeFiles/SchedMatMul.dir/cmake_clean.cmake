@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/SchedMatMul.dir/Codelets/MatMul.cpp.o"
+  "CMakeFiles/SchedMatMul.dir/Codelets/MatMul.cpp.o.d"
+  "CMakeFiles/SchedMatMul.dir/__/__/src/system_codelets/cod_print.cpp.o"
+  "CMakeFiles/SchedMatMul.dir/__/__/src/system_codelets/cod_print.cpp.o.d"
+  "CMakeFiles/SchedMatMul.dir/benchSchedMatMul.cpp.o"
+  "CMakeFiles/SchedMatMul.dir/benchSchedMatMul.cpp.o.d"
+  "SchedMatMul"
+  "SchedMatMul.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SchedMatMul.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
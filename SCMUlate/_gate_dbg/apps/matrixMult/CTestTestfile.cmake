@@ -0,0 +1,7 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/SCMUlate/apps/matrixMult
+# Build directory: /root/repo/SCMUlate/_gate_dbg/apps/matrixMult
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("Codelets")
@@ -0,0 +1,20 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/SCMUlate/apps/matrixMult/Codelets/MatMul.cpp" "apps/matrixMult/Codelets/CMakeFiles/mat_mul_cod.dir/MatMul.cpp.o" "gcc" "apps/matrixMult/Codelets/CMakeFiles/mat_mul_cod.dir/MatMul.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/SCMUlate/_gate_dbg/src/codelet_model/CMakeFiles/scm_codelet.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
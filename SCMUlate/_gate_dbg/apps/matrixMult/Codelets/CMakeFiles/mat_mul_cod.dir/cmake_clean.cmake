@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mat_mul_cod.dir/MatMul.cpp.o"
+  "CMakeFiles/mat_mul_cod.dir/MatMul.cpp.o.d"
+  "libmat_mul_cod.a"
+  "libmat_mul_cod.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mat_mul_cod.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
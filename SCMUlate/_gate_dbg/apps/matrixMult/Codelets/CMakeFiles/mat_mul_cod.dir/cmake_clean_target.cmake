@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "libmat_mul_cod.a"
+)
@@ -0,0 +1,6 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/SCMUlate/apps/matrixMult/Codelets
+# Build directory: /root/repo/SCMUlate/_gate_dbg/apps/matrixMult/Codelets
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/VecAdd.dir/Codelets/vecAdd.cpp.o"
+  "CMakeFiles/VecAdd.dir/Codelets/vecAdd.cpp.o.d"
+  "CMakeFiles/VecAdd.dir/__/__/src/system_codelets/cod_print.cpp.o"
+  "CMakeFiles/VecAdd.dir/__/__/src/system_codelets/cod_print.cpp.o.d"
+  "CMakeFiles/VecAdd.dir/mainVecAdd.cpp.o"
+  "CMakeFiles/VecAdd.dir/mainVecAdd.cpp.o.d"
+  "VecAdd"
+  "VecAdd.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/VecAdd.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
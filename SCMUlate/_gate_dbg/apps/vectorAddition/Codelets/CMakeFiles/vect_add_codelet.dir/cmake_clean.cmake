@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/vect_add_codelet.dir/vecAdd.cpp.o"
+  "CMakeFiles/vect_add_codelet.dir/vecAdd.cpp.o.d"
+  "libvect_add_codelet.a"
+  "libvect_add_codelet.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/vect_add_codelet.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "libvect_add_codelet.a"
+)
@@ -0,0 +1,17 @@
+// The host gives the base addresses of A, B and C in R64B_1, R64B_2 and R64B_3
+
+LDIMM R64B_4, 0; // For iteration variable
+LDIMM R64B_5, 0; // For offset
+LDIMM R64B_6, 400; // For number of iterations
+
+loop:
+  BREQ R64B_4, R64B_6, 8;
+  LDOFF R2048L_1, R64B_1, R64B_5;
+  LDOFF R2048L_2, R64B_2, R64B_5;
+  COD vecAdd_2048L R2048L_3, R2048L_1, R2048L_2;
+  STOFF R2048L_3, R64B_3, R64B_5;
+  ADD R64B_4, R64B_4, 1;
+  ADD R64B_5, R64B_5, 131072;
+  JMPLBL loop;
+
+COMMIT;
\ No newline at end of file
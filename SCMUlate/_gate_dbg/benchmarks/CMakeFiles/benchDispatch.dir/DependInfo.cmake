@@ -0,0 +1,24 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/SCMUlate/benchmarks/bench_dispatch.cpp" "benchmarks/CMakeFiles/benchDispatch.dir/bench_dispatch.cpp.o" "gcc" "benchmarks/CMakeFiles/benchDispatch.dir/bench_dispatch.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/SCMUlate/_gate_dbg/src/common/CMakeFiles/scm_instructions.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/modules/CMakeFiles/registers.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/common/CMakeFiles/scm_string_helper.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/codelet_model/CMakeFiles/scm_codelet.dir/DependInfo.cmake"
+  "/root/repo/SCMUlate/_gate_dbg/src/common/CMakeFiles/scm_memory_pages.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
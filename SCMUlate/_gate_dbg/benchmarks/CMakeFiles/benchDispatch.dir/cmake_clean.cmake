@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/benchDispatch.dir/bench_dispatch.cpp.o"
+  "CMakeFiles/benchDispatch.dir/bench_dispatch.cpp.o.d"
+  "benchDispatch"
+  "benchDispatch.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchDispatch.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
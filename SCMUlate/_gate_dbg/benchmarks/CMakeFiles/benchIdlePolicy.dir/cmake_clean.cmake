@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/benchIdlePolicy.dir/bench_idle_policy.cpp.o"
+  "CMakeFiles/benchIdlePolicy.dir/bench_idle_policy.cpp.o.d"
+  "benchIdlePolicy"
+  "benchIdlePolicy.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchIdlePolicy.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
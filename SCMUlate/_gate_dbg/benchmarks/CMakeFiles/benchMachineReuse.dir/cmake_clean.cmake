@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/benchMachineReuse.dir/__/src/system_codelets/cod_print.cpp.o"
+  "CMakeFiles/benchMachineReuse.dir/__/src/system_codelets/cod_print.cpp.o.d"
+  "CMakeFiles/benchMachineReuse.dir/bench_machine_reuse.cpp.o"
+  "CMakeFiles/benchMachineReuse.dir/bench_machine_reuse.cpp.o.d"
+  "benchMachineReuse"
+  "benchMachineReuse.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchMachineReuse.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/benchMultiTenant.dir/__/src/system_codelets/cod_print.cpp.o"
+  "CMakeFiles/benchMultiTenant.dir/__/src/system_codelets/cod_print.cpp.o.d"
+  "CMakeFiles/benchMultiTenant.dir/bench_multi_tenant.cpp.o"
+  "CMakeFiles/benchMultiTenant.dir/bench_multi_tenant.cpp.o.d"
+  "benchMultiTenant"
+  "benchMultiTenant.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchMultiTenant.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
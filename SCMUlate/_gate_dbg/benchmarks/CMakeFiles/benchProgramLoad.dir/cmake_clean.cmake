@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/benchProgramLoad.dir/__/src/system_codelets/cod_print.cpp.o"
+  "CMakeFiles/benchProgramLoad.dir/__/src/system_codelets/cod_print.cpp.o.d"
+  "CMakeFiles/benchProgramLoad.dir/bench_program_load.cpp.o"
+  "CMakeFiles/benchProgramLoad.dir/bench_program_load.cpp.o.d"
+  "benchProgramLoad"
+  "benchProgramLoad.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchProgramLoad.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
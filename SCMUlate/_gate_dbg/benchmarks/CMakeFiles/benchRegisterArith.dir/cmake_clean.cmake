@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/benchRegisterArith.dir/bench_register_arith.cpp.o"
+  "CMakeFiles/benchRegisterArith.dir/bench_register_arith.cpp.o.d"
+  "benchRegisterArith"
+  "benchRegisterArith.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchRegisterArith.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
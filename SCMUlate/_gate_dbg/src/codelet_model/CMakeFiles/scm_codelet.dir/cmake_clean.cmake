@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/scm_codelet.dir/codelet.cpp.o"
+  "CMakeFiles/scm_codelet.dir/codelet.cpp.o.d"
+  "libscm_codelet.a"
+  "libscm_codelet.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/scm_codelet.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
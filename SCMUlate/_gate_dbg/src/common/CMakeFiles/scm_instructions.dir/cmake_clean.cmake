@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/scm_instructions.dir/instructions.cpp.o"
+  "CMakeFiles/scm_instructions.dir/instructions.cpp.o.d"
+  "libscm_instructions.a"
+  "libscm_instructions.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/scm_instructions.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
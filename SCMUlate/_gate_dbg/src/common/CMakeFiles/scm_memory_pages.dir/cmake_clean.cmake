@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/scm_memory_pages.dir/memory_pages.cpp.o"
+  "CMakeFiles/scm_memory_pages.dir/memory_pages.cpp.o.d"
+  "libscm_memory_pages.a"
+  "libscm_memory_pages.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/scm_memory_pages.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
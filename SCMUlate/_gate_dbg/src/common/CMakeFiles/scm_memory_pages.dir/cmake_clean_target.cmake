@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "libscm_memory_pages.a"
+)
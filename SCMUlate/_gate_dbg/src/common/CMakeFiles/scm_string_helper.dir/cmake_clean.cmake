@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/scm_string_helper.dir/stringHelper.cpp.o"
+  "CMakeFiles/scm_string_helper.dir/stringHelper.cpp.o.d"
+  "libscm_string_helper.a"
+  "libscm_string_helper.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/scm_string_helper.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
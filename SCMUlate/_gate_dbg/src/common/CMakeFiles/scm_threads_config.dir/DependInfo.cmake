@@ -0,0 +1,20 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/SCMUlate/src/common/numa_placement.cpp" "src/common/CMakeFiles/scm_threads_config.dir/numa_placement.cpp.o" "gcc" "src/common/CMakeFiles/scm_threads_config.dir/numa_placement.cpp.o.d"
+  "/root/repo/SCMUlate/src/common/threads_configuration.cpp" "src/common/CMakeFiles/scm_threads_config.dir/threads_configuration.cpp.o" "gcc" "src/common/CMakeFiles/scm_threads_config.dir/threads_configuration.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
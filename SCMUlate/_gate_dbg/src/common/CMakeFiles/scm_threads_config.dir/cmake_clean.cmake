@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/scm_threads_config.dir/numa_placement.cpp.o"
+  "CMakeFiles/scm_threads_config.dir/numa_placement.cpp.o.d"
+  "CMakeFiles/scm_threads_config.dir/threads_configuration.cpp.o"
+  "CMakeFiles/scm_threads_config.dir/threads_configuration.cpp.o.d"
+  "libscm_threads_config.a"
+  "libscm_threads_config.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/scm_threads_config.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "libscm_threads_config.a"
+)
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/scm_machine.dir/__/system_codelets/cod_print.cpp.o"
+  "CMakeFiles/scm_machine.dir/__/system_codelets/cod_print.cpp.o.d"
+  "CMakeFiles/scm_machine.dir/scm_machine.cpp.o"
+  "CMakeFiles/scm_machine.dir/scm_machine.cpp.o.d"
+  "CMakeFiles/scm_machine.dir/scm_multi_machine.cpp.o"
+  "CMakeFiles/scm_machine.dir/scm_multi_machine.cpp.o.d"
+  "libscm_machine.a"
+  "libscm_machine.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/scm_machine.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/control_store.dir/control_store.cpp.o"
+  "CMakeFiles/control_store.dir/control_store.cpp.o.d"
+  "libcontrol_store.a"
+  "libcontrol_store.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/control_store.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
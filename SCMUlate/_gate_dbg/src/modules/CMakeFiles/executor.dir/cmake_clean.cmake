@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/executor.dir/executor.cpp.o"
+  "CMakeFiles/executor.dir/executor.cpp.o.d"
+  "libexecutor.a"
+  "libexecutor.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/executor.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
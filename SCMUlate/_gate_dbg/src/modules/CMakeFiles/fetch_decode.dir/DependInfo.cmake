@@ -0,0 +1,22 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/SCMUlate/src/modules/fetch_decode.cpp" "src/modules/CMakeFiles/fetch_decode.dir/fetch_decode.cpp.o" "gcc" "src/modules/CMakeFiles/fetch_decode.dir/fetch_decode.cpp.o.d"
+  "/root/repo/SCMUlate/src/modules/ilp_controller.cpp" "src/modules/CMakeFiles/fetch_decode.dir/ilp_controller.cpp.o" "gcc" "src/modules/CMakeFiles/fetch_decode.dir/ilp_controller.cpp.o.d"
+  "/root/repo/SCMUlate/src/modules/register_rename.cpp" "src/modules/CMakeFiles/fetch_decode.dir/register_rename.cpp.o" "gcc" "src/modules/CMakeFiles/fetch_decode.dir/register_rename.cpp.o.d"
+  "/root/repo/SCMUlate/src/modules/sched_policy.cpp" "src/modules/CMakeFiles/fetch_decode.dir/sched_policy.cpp.o" "gcc" "src/modules/CMakeFiles/fetch_decode.dir/sched_policy.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/fetch_decode.dir/fetch_decode.cpp.o"
+  "CMakeFiles/fetch_decode.dir/fetch_decode.cpp.o.d"
+  "CMakeFiles/fetch_decode.dir/ilp_controller.cpp.o"
+  "CMakeFiles/fetch_decode.dir/ilp_controller.cpp.o.d"
+  "CMakeFiles/fetch_decode.dir/register_rename.cpp.o"
+  "CMakeFiles/fetch_decode.dir/register_rename.cpp.o.d"
+  "CMakeFiles/fetch_decode.dir/sched_policy.cpp.o"
+  "CMakeFiles/fetch_decode.dir/sched_policy.cpp.o.d"
+  "libfetch_decode.a"
+  "libfetch_decode.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/fetch_decode.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "libfetch_decode.a"
+)
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/instruction_mem.dir/instruction_mem.cpp.o"
+  "CMakeFiles/instruction_mem.dir/instruction_mem.cpp.o.d"
+  "libinstruction_mem.a"
+  "libinstruction_mem.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/instruction_mem.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
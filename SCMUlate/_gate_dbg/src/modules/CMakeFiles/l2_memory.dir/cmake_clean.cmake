@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/l2_memory.dir/l2_memory.cpp.o"
+  "CMakeFiles/l2_memory.dir/l2_memory.cpp.o.d"
+  "libl2_memory.a"
+  "libl2_memory.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/l2_memory.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/memory_interface.dir/memory_interface.cpp.o"
+  "CMakeFiles/memory_interface.dir/memory_interface.cpp.o.d"
+  "libmemory_interface.a"
+  "libmemory_interface.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/memory_interface.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
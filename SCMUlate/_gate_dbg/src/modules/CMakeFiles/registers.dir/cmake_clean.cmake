@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/registers.dir/registers.cpp.o"
+  "CMakeFiles/registers.dir/registers.cpp.o.d"
+  "libregisters.a"
+  "libregisters.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/registers.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/scm_timers_counters.dir/timers_counters.cpp.o"
+  "CMakeFiles/scm_timers_counters.dir/timers_counters.cpp.o.d"
+  "libscm_timers_counters.a"
+  "libscm_timers_counters.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/scm_timers_counters.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
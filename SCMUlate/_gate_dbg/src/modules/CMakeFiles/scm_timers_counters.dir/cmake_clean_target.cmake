@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "libscm_timers_counters.a"
+)
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/scm_system_codelets.dir/cod_print.cpp.o"
+  "CMakeFiles/scm_system_codelets.dir/cod_print.cpp.o.d"
+  "libscm_system_codelets.a"
+  "libscm_system_codelets.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/scm_system_codelets.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,7 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/SCMUlate/tests
+# Build directory: /root/repo/SCMUlate/_gate_dbg/tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("modules")
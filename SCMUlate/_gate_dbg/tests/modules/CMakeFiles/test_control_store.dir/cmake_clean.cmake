@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_control_store.dir/test_control_store.cpp.o"
+  "CMakeFiles/test_control_store.dir/test_control_store.cpp.o.d"
+  "test_control_store"
+  "test_control_store.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_control_store.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
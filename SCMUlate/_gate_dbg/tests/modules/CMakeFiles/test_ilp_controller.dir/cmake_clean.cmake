@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_ilp_controller.dir/test_ilp_controller.cpp.o"
+  "CMakeFiles/test_ilp_controller.dir/test_ilp_controller.cpp.o.d"
+  "test_ilp_controller"
+  "test_ilp_controller.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_ilp_controller.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
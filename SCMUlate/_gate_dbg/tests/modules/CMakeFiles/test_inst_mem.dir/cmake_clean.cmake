@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_inst_mem.dir/test_instruction_mem.cpp.o"
+  "CMakeFiles/test_inst_mem.dir/test_instruction_mem.cpp.o.d"
+  "test_inst_mem"
+  "test_inst_mem.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_inst_mem.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
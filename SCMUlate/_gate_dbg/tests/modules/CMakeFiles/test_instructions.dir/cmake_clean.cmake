@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_instructions.dir/test_instructions.cpp.o"
+  "CMakeFiles/test_instructions.dir/test_instructions.cpp.o.d"
+  "test_instructions"
+  "test_instructions.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_instructions.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_l2_memory.dir/test_l2_memory.cpp.o"
+  "CMakeFiles/test_l2_memory.dir/test_l2_memory.cpp.o.d"
+  "test_l2_memory"
+  "test_l2_memory.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_l2_memory.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_reg_file.dir/test_register_file.cpp.o"
+  "CMakeFiles/test_reg_file.dir/test_register_file.cpp.o.d"
+  "test_reg_file"
+  "test_reg_file.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_reg_file.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_register_arith.dir/test_register_arith.cpp.o"
+  "CMakeFiles/test_register_arith.dir/test_register_arith.cpp.o.d"
+  "test_register_arith"
+  "test_register_arith.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_register_arith.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_register_rename.dir/test_register_rename.cpp.o"
+  "CMakeFiles/test_register_rename.dir/test_register_rename.cpp.o.d"
+  "test_register_rename"
+  "test_register_rename.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_register_rename.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
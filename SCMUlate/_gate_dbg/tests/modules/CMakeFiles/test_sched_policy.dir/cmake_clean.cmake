@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_sched_policy.dir/test_sched_policy.cpp.o"
+  "CMakeFiles/test_sched_policy.dir/test_sched_policy.cpp.o.d"
+  "test_sched_policy"
+  "test_sched_policy.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_sched_policy.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
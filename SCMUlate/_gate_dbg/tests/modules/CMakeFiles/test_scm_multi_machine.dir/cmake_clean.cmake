@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_scm_multi_machine.dir/__/__/src/system_codelets/cod_print.cpp.o"
+  "CMakeFiles/test_scm_multi_machine.dir/__/__/src/system_codelets/cod_print.cpp.o.d"
+  "CMakeFiles/test_scm_multi_machine.dir/test_scm_multi_machine.cpp.o"
+  "CMakeFiles/test_scm_multi_machine.dir/test_scm_multi_machine.cpp.o.d"
+  "test_scm_multi_machine"
+  "test_scm_multi_machine.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_scm_multi_machine.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
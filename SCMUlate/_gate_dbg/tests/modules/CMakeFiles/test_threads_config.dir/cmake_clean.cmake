@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_threads_config.dir/test_threads_config.cpp.o"
+  "CMakeFiles/test_threads_config.dir/test_threads_config.cpp.o.d"
+  "test_threads_config"
+  "test_threads_config.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_threads_config.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
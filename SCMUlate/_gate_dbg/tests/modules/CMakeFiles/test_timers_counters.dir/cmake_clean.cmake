@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_timers_counters.dir/test_timers_counters.cpp.o"
+  "CMakeFiles/test_timers_counters.dir/test_timers_counters.cpp.o.d"
+  "test_timers_counters"
+  "test_timers_counters.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_timers_counters.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,32 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/SCMUlate/tests/modules
+# Build directory: /root/repo/SCMUlate/_gate_dbg/tests/modules
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(test_reg_file "/root/repo/SCMUlate/_gate_dbg/tests/modules/test_reg_file")
+set_tests_properties(test_reg_file PROPERTIES  WORKING_DIRECTORY "/root/repo/SCMUlate/_gate_dbg/tests/modules" _BACKTRACE_TRIPLES "/root/repo/SCMUlate/tests/modules/CMakeLists.txt;10;add_test;/root/repo/SCMUlate/tests/modules/CMakeLists.txt;0;")
+add_test(test_inst_mem "/root/repo/SCMUlate/_gate_dbg/tests/modules/test_inst_mem")
+set_tests_properties(test_inst_mem PROPERTIES  WORKING_DIRECTORY "/root/repo/SCMUlate/_gate_dbg/tests/modules" _BACKTRACE_TRIPLES "/root/repo/SCMUlate/tests/modules/CMakeLists.txt;24;add_test;/root/repo/SCMUlate/tests/modules/CMakeLists.txt;0;")
+add_test(test_instructions "/root/repo/SCMUlate/_gate_dbg/tests/modules/test_instructions")
+set_tests_properties(test_instructions PROPERTIES  WORKING_DIRECTORY "/root/repo/SCMUlate/_gate_dbg/tests/modules" _BACKTRACE_TRIPLES "/root/repo/SCMUlate/tests/modules/CMakeLists.txt;34;add_test;/root/repo/SCMUlate/tests/modules/CMakeLists.txt;0;")
+add_test(test_ilp_controller "/root/repo/SCMUlate/_gate_dbg/tests/modules/test_ilp_controller")
+set_tests_properties(test_ilp_controller PROPERTIES  WORKING_DIRECTORY "/root/repo/SCMUlate/_gate_dbg/tests/modules" _BACKTRACE_TRIPLES "/root/repo/SCMUlate/tests/modules/CMakeLists.txt;44;add_test;/root/repo/SCMUlate/tests/modules/CMakeLists.txt;0;")
+add_test(test_register_rename "/root/repo/SCMUlate/_gate_dbg/tests/modules/test_register_rename")
+set_tests_properties(test_register_rename PROPERTIES  WORKING_DIRECTORY "/root/repo/SCMUlate/_gate_dbg/tests/modules" _BACKTRACE_TRIPLES "/root/repo/SCMUlate/tests/modules/CMakeLists.txt;55;add_test;/root/repo/SCMUlate/tests/modules/CMakeLists.txt;0;")
+add_test(test_control_store "/root/repo/SCMUlate/_gate_dbg/tests/modules/test_control_store")
+set_tests_properties(test_control_store PROPERTIES  WORKING_DIRECTORY "/root/repo/SCMUlate/_gate_dbg/tests/modules" _BACKTRACE_TRIPLES "/root/repo/SCMUlate/tests/modules/CMakeLists.txt;65;add_test;/root/repo/SCMUlate/tests/modules/CMakeLists.txt;0;")
+add_test(test_sched_policy "/root/repo/SCMUlate/_gate_dbg/tests/modules/test_sched_policy")
+set_tests_properties(test_sched_policy PROPERTIES  WORKING_DIRECTORY "/root/repo/SCMUlate/_gate_dbg/tests/modules" _BACKTRACE_TRIPLES "/root/repo/SCMUlate/tests/modules/CMakeLists.txt;75;add_test;/root/repo/SCMUlate/tests/modules/CMakeLists.txt;0;")
+add_test(test_threads_config "/root/repo/SCMUlate/_gate_dbg/tests/modules/test_threads_config")
+set_tests_properties(test_threads_config PROPERTIES  WORKING_DIRECTORY "/root/repo/SCMUlate/_gate_dbg/tests/modules" _BACKTRACE_TRIPLES "/root/repo/SCMUlate/tests/modules/CMakeLists.txt;85;add_test;/root/repo/SCMUlate/tests/modules/CMakeLists.txt;0;")
+add_test(test_l2_memory "/root/repo/SCMUlate/_gate_dbg/tests/modules/test_l2_memory")
+set_tests_properties(test_l2_memory PROPERTIES  WORKING_DIRECTORY "/root/repo/SCMUlate/_gate_dbg/tests/modules" _BACKTRACE_TRIPLES "/root/repo/SCMUlate/tests/modules/CMakeLists.txt;95;add_test;/root/repo/SCMUlate/tests/modules/CMakeLists.txt;0;")
+add_test(test_register_arith "/root/repo/SCMUlate/_gate_dbg/tests/modules/test_register_arith")
+set_tests_properties(test_register_arith PROPERTIES  WORKING_DIRECTORY "/root/repo/SCMUlate/_gate_dbg/tests/modules" _BACKTRACE_TRIPLES "/root/repo/SCMUlate/tests/modules/CMakeLists.txt;104;add_test;/root/repo/SCMUlate/tests/modules/CMakeLists.txt;0;")
+add_test(scm_timers_counters "scm_timers_counters")
+set_tests_properties(scm_timers_counters PROPERTIES  WORKING_DIRECTORY "/root/repo/SCMUlate/_gate_dbg/tests/modules" _BACKTRACE_TRIPLES "/root/repo/SCMUlate/tests/modules/CMakeLists.txt;114;add_test;/root/repo/SCMUlate/tests/modules/CMakeLists.txt;0;")
+add_test(test_scm_machine "/root/repo/SCMUlate/_gate_dbg/tests/modules/test_scm_machine")
+set_tests_properties(test_scm_machine PROPERTIES  TIMEOUT "120" WORKING_DIRECTORY "/root/repo/SCMUlate/_gate_dbg/tests/modules" _BACKTRACE_TRIPLES "/root/repo/SCMUlate/tests/modules/CMakeLists.txt;126;add_test;/root/repo/SCMUlate/tests/modules/CMakeLists.txt;0;")
+add_test(test_scm_multi_machine "/root/repo/SCMUlate/_gate_dbg/tests/modules/test_scm_multi_machine")
+set_tests_properties(test_scm_multi_machine PROPERTIES  TIMEOUT "120" WORKING_DIRECTORY "/root/repo/SCMUlate/_gate_dbg/tests/modules" _BACKTRACE_TRIPLES "/root/repo/SCMUlate/tests/modules/CMakeLists.txt;137;add_test;/root/repo/SCMUlate/tests/modules/CMakeLists.txt;0;")
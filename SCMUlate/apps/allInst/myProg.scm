@@ -23,10 +23,12 @@
     ADD R64B_2, R64B_1, R64B_1; 
     SUB R64B_1, R64B_2, R64B_1; 
     SUB R64B_1, R64B_2, 100; 
-    //SHFL R64B_1, R64B_2;
-    //SHFL R64B_1, -100;
-    //SHFR R64B_1, R64B_2;
-    //SHFR R64B_1, -100;
+    SHFL R64B_1, R64B_2;
+    SHFL R64B_1, 3;
+    SHFR R64B_1, R64B_2;
+    SHFR R64B_1, -3;
+    MULT R64B_1, R64B_1, 3;
+    MULT R64B_2, R64B_1, R64B_1;
     LDIMM R64B_2, 0;
     LDIMM R64B_3, 0;
     LDADR R64B_1, R64B_2;
@@ -12,6 +12,6 @@ DEFINE_CODELET(MatMultGPU_2048L, 3, scm::OP_IO::OP1_WR | scm::OP_IO::OP1_RD | sc
 
 // [Rx_2048L, address, padding] = Store to addr 128x128 elements from register with offset padding  
 // Loads tile of 128x128 
-DEFINE_CODELET(StoreSqTileGPU_2048L, 2, scm::OP_IO::OP1_WR | scm::OP_IO::OP2_RD | scm::OP_IO::OP3_RD); 
+DEFINE_CODELET(StoreSqTileGPU_2048L, 2, scm::OP_IO::OP1_RD | scm::OP_IO::OP2_RD | scm::OP_IO::OP3_RD); 
 
 #endif
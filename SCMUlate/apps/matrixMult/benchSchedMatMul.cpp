@@ -0,0 +1,184 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "MatMul.hpp"
+#include "scm_machine.hpp"
+#include <cstring>
+#include <chrono>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <linux/perf_event.h>
+
+/**
+ * CU scheduling policies benchmark. It runs matMul128x1280.scm once per policy and
+ * reports the time of the run and the hardware cache misses of all the threads of the
+ * machine, with the difference against ROUND_ROBIN. Each run is a child process, the
+ * counters are attached to it by this process and inherited by the SU and CU threads,
+ * so they are only enabled during scm_machine::run(). If the counters are not available
+ * (e.g. /proc/sys/kernel/perf_event_paranoid) only the times are reported.
+ *
+ * usage: SchedMatMul [-i <matMul128x1280.scm>]
+ */
+
+#define REG_SIZE (64*2048)
+#define TILES 10
+#define B_offset (REG_SIZE*TILES)
+#define C_offset (REG_SIZE*TILES*2)
+#define NumElements_AB ((REG_SIZE*TILES)/sizeof(double))
+#define NumElements_C ((REG_SIZE)/sizeof(double))
+#define SIZEOFMEM (C_offset + REG_SIZE)
+
+static struct {
+  char * fileName = const_cast<char *>("matMul128x1280.scm");
+} program_options;
+
+static const scm::SCHED_POLICIES policies[] = {scm::ROUND_ROBIN, scm::LEAST_LOADED, scm::REG_AFFINITY};
+static const char * policyNames[] = {"ROUND_ROBIN", "LEAST_LOADED", "REG_AFFINITY"};
+
+// Generic cache misses (usually the last level) and L1 data read misses
+static const int NUM_COUNTERS = 2;
+static const char * counterNames[NUM_COUNTERS] = {"cache-misses", "L1D-read-misses"};
+static const uint32_t counterTypes[NUM_COUNTERS] = {PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE};
+static const uint64_t counterConfigs[NUM_COUNTERS] = {PERF_COUNT_HW_CACHE_MISSES,
+  PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)};
+
+struct run_result_t {
+  double seconds;
+  bool countersValid;
+  uint64_t counters[NUM_COUNTERS];
+  bool success;
+};
+
+void parseProgramOptions(int argc, char* argv[]);
+
+static int openCounter(pid_t pid, uint32_t type, uint64_t config) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.disabled = 1;
+  attr.inherit = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return syscall(__NR_perf_event_open, &attr, pid, -1, -1, 0);
+}
+
+// Runs in the child process. The parent enables the counters between 'r' and 'd'
+static int runMachine(scm::SCHED_POLICIES policy, int toParent, int fromParent) {
+  char sync;
+  unsigned char * memory = new unsigned char[SIZEOFMEM];
+  double *A = reinterpret_cast<double*> (memory);
+  double *B = reinterpret_cast<double*> (&memory[B_offset]);
+  double *C = reinterpret_cast<double*> (&memory[C_offset]);
+  for (uint64_t i = 0; i < NumElements_AB; i++) {
+    A[i] = i;
+    B[i] = i;
+  }
+  memset(C, 0, NumElements_C*sizeof(double));
+
+  scm::scm_machine * myMachine = new scm::scm_machine(program_options.fileName, memory, scm::SUPERSCALAR, policy);
+  if (write(toParent, "r", 1) != 1 || read(fromParent, &sync, 1) != 1)
+    return 1;
+  scm::run_status status = myMachine->run();
+  if (write(toParent, "d", 1) != 1)
+    return 1;
+
+  // Every element of C is the sum of the same number of products, check it is not zero
+  bool success = status == scm::SCM_RUN_SUCCESS;
+  for (uint64_t i = 1; i < NumElements_C && success; i++)
+    success = C[i] != 0;
+  delete myMachine;
+  delete [] memory;
+  return success ? 0 : 1;
+}
+
+static bool runPolicy(scm::SCHED_POLICIES policy, run_result_t & result) {
+  int toParent[2], toChild[2];
+  char sync;
+  if (pipe(toParent) != 0 || pipe(toChild) != 0)
+    return false;
+  pid_t child = fork();
+  if (child == 0)
+    _exit(runMachine(policy, toParent[1], toChild[0]));
+
+  int fds[NUM_COUNTERS];
+  result.countersValid = true;
+  for (int i = 0; i < NUM_COUNTERS; i++) {
+    fds[i] = openCounter(child, counterTypes[i], counterConfigs[i]);
+    result.countersValid &= fds[i] != -1;
+  }
+
+  bool started = read(toParent[0], &sync, 1) == 1;
+  for (int i = 0; i < NUM_COUNTERS; i++)
+    if (fds[i] != -1)
+      ioctl(fds[i], PERF_EVENT_IOC_ENABLE, 0);
+  std::chrono::time_point<std::chrono::high_resolution_clock> initTimer = std::chrono::high_resolution_clock::now();
+  started = started && write(toChild[1], "g", 1) == 1;
+  bool finished = started && read(toParent[0], &sync, 1) == 1;
+  std::chrono::duration<double> diff = std::chrono::high_resolution_clock::now() - initTimer;
+  for (int i = 0; i < NUM_COUNTERS; i++)
+    if (fds[i] != -1)
+      ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+  result.seconds = diff.count();
+
+  // The counts of the threads are added to the counter when they exit
+  int status = 1;
+  waitpid(child, &status, 0);
+  result.success = finished && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+  for (int i = 0; i < NUM_COUNTERS; i++) {
+    result.counters[i] = 0;
+    if (fds[i] != -1) {
+      if (read(fds[i], &result.counters[i], sizeof(uint64_t)) != sizeof(uint64_t))
+        result.countersValid = false;
+      close(fds[i]);
+    }
+  }
+  close(toParent[0]); close(toParent[1]);
+  close(toChild[0]); close(toChild[1]);
+  return true;
+}
+
+int main (int argc, char * argv[]) {
+  parseProgramOptions(argc, argv);
+  if (strstr(program_options.fileName, "matMul128x1280") == nullptr) {
+    printf("ERROR: only matMul128x1280.scm is supported\n");
+    return 1;
+  }
+
+  const int numPolicies = sizeof(policies)/sizeof(policies[0]);
+  run_result_t results[numPolicies];
+  int errors = 0;
+  for (int p = 0; p < numPolicies; p++) {
+    if (!runPolicy(policies[p], results[p]) || !results[p].success) {
+      printf("ERROR: %s run failed\n", policyNames[p]);
+      errors++;
+    }
+  }
+
+  printf("%-14s %12s", "policy", "time (s)");
+  for (int c = 0; c < NUM_COUNTERS; c++)
+    printf(" %18s %10s", counterNames[c], "delta");
+  printf("\n");
+  for (int p = 0; p < numPolicies; p++) {
+    printf("%-14s %12f", policyNames[p], results[p].seconds);
+    for (int c = 0; c < NUM_COUNTERS; c++) {
+      if (results[p].countersValid && results[0].countersValid && results[0].counters[c] != 0)
+        printf(" %18lu %+9.2f%%", results[p].counters[c], 100.0*((double)results[p].counters[c] - results[0].counters[c])/results[0].counters[c]);
+      else
+        printf(" %18s %10s", "n/a", "n/a");
+    }
+    printf("\n");
+  }
+  return errors == 0 ? 0 : 1;
+}
+
+void parseProgramOptions(int argc, char* argv[]) {
+  // there are other arguments
+  for (int i = 1; i + 1 < argc; i++) {
+    if (strcmp(argv[i], "-i") == 0) {
+      program_options.fileName = argv[++i];
+    }
+  }
+}
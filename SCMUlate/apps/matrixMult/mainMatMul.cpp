@@ -31,6 +31,12 @@ uint32_t KDIM;
 static struct {
   bool fileInput = false;
   char * fileName;
+  uint32_t numCUs = NUM_CUS;
+  char * cpuList = nullptr;
+  scm::IDLE_POLICIES idlePolicy = scm::IDLE_SPIN;
+  scm::THREAD_BACKENDS backend = scm::OPENMP_BACKEND;
+  scm::NUMA_PLACEMENTS placement = scm::NUMA_NONE;
+  char * machineFile = nullptr;
 } program_options;
 
  // 4 GB
@@ -63,6 +69,9 @@ int main (int argc, char * argv[]) {
   scm::_cod_MatMult_2048L warmCod(vars);
   warmCod.implementation();
   parseProgramOptions(argc, argv);
+  scm::register_geometry registers;
+  if (program_options.machineFile && !registers.readFile(program_options.machineFile))
+    return 1;
   // TODO: Harcoding these for now, until we have a general 
   if (strcmp(program_options.fileName, "matMul1tile.scm") == 0 || strcmp(program_options.fileName, "matMul1tileGPU.scm") == 0) {
     TILES = 1;
@@ -109,16 +118,24 @@ int main (int argc, char * argv[]) {
   scm::scm_machine * myMachine;
   if (program_options.fileInput) {
     SCMULATE_INFOMSG(0, "Reading program file %s", program_options.fileName);
-    myMachine = new scm::scm_machine(program_options.fileName, memory, scm::SEQUENTIAL);
+    scm::threads_config threads(program_options.numCUs, program_options.cpuList);
+    threads.setIdlePolicy(program_options.idlePolicy);
+    threads.setBackend(program_options.backend);
+    threads.setPlacement(program_options.placement);
+    myMachine = new scm::scm_machine(program_options.fileName, memory, scm::SUPERSCALAR, scm::ROUND_ROBIN, threads, registers);
   } else {
     std::cout << "Need to give a file to read. use -i <filename>" << std::endl;
     return 1;
   }
+  // The matrices were touched by the main thread, their pages are moved to the nodes of the CUs
+  myMachine->placeMemory(memory, SIZEOFMEM);
 
   if (myMachine->run() != scm::SCM_RUN_SUCCESS) {
     SCMULATE_ERROR(0, "THERE WAS AN ERROR WHEN RUNNING THE SCM MACHINE");
     return 1;
   }
+  if (program_options.placement != scm::NUMA_NONE)
+    myMachine->printBandwidthReport();
 
   TIMERS_COUNTERS_GUARD(
     myMachine->setTimersOutput("trace.json");
@@ -155,6 +172,21 @@ void parseProgramOptions(int argc, char* argv[]) {
     if (strcmp(argv[i], "-i") == 0) {
       program_options.fileInput = true;
       program_options.fileName = argv[++i];
+    } else if (strcmp(argv[i], "-c") == 0) {
+      program_options.numCUs = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "-a") == 0) {
+      program_options.cpuList = argv[++i];
+    } else if (strcmp(argv[i], "-w") == 0) {
+      if (!scm::threads_config::parseIdlePolicy(argv[++i], program_options.idlePolicy))
+        std::cout << "Unknown idle policy " << argv[i] << ", use spin, yield or block" << std::endl;
+    } else if (strcmp(argv[i], "-b") == 0) {
+      if (!scm::threads_config::parseBackend(argv[++i], program_options.backend))
+        std::cout << "Unknown threads backend " << argv[i] << ", use omp or threads" << std::endl;
+    } else if (strcmp(argv[i], "-m") == 0) {
+      if (!scm::threads_config::parsePlacement(argv[++i], program_options.placement))
+        std::cout << "Unknown NUMA placement " << argv[i] << ", use none, interleave or blocked" << std::endl;
+    } else if (strcmp(argv[i], "-r") == 0) {
+      program_options.machineFile = argv[++i];
     }
   }
 }
@@ -4,18 +4,23 @@
 #include "scm_machine.hpp"
 #include <cstring>
 #include <iostream>
+#include <algorithm>
 
 // Reps
 #define REPS 400
-//B offset = sizeRegister*400 = 52428800
-#define B_offset (64*2048*REPS)
-//C offset = sizeRegister*400*2 = 104857600
-#define C_offset (64*2048*REPS*2)
-#define NumElements ((64*2048*REPS)/sizeof(double))
+#define SegmentElements ((64*2048)/sizeof(double))
+#define NumElements (SegmentElements*REPS)
 
 static struct {
   bool fileInput = false;
   char * fileName;
+  uint32_t numCUs = NUM_CUS;
+  char * cpuList = nullptr;
+  scm::IDLE_POLICIES idlePolicy = scm::IDLE_SPIN;
+  scm::THREAD_BACKENDS backend = scm::OPENMP_BACKEND;
+  scm::NUMA_PLACEMENTS placement = scm::NUMA_NONE;
+  char * machineFile = nullptr;
+  unsigned long segments = REPS; /**< Segments of 2048 lines added by the program */
 } program_options;
 
  // 4 GB
@@ -27,46 +32,56 @@ void parseProgramOptions(int argc, char* argv[]);
 int SCMUlate();
 
 int main (int argc, char * argv[]) {
-  unsigned char * memory;
   parseProgramOptions(argc, argv);
-  try
-  {
-    memory = new unsigned char[SIZEOFMEM];
-  }
-  catch (int e)
-  {
-    std::cout << "An exception occurred. Exception Nr. " << e << '\n';
+  scm::register_geometry registers;
+  if (program_options.machineFile && !registers.readFile(program_options.machineFile))
     return 1;
-  }
   
-  double *A = reinterpret_cast<double*> (memory); 
-  double *B = reinterpret_cast<double*> (&memory[B_offset]); 
-  double *C = reinterpret_cast<double*> (&memory[C_offset]); 
-
-  for (unsigned long i = 0; i < NumElements; ++i) {
-      A[i] = i;
-      B[i] = i;
-  }
-  // SCM MACHINE
+  // SCM MACHINE, it owns its L2 memory
   scm::scm_machine * myMachine;
   if (program_options.fileInput) {
     SCMULATE_INFOMSG(0, "Reading program file %s", program_options.fileName);
-    myMachine = new scm::scm_machine(program_options.fileName, memory, scm::SUPERSCALAR);
+    scm::threads_config threads(program_options.numCUs, program_options.cpuList);
+    threads.setIdlePolicy(program_options.idlePolicy);
+    threads.setBackend(program_options.backend);
+    threads.setPlacement(program_options.placement);
+    myMachine = new scm::scm_machine(program_options.fileName, SIZEOFMEM, scm::SUPERSCALAR, scm::ROUND_ROBIN, threads, true, registers);
   } else {
     std::cout << "Need to give a file to read. use -i <filename>" << std::endl;
     return 1;
   }
 
+  // The arrays are allocated one after the other, at the addresses the unrolled program uses. 
+  // vectorAddLoop.scm and vectorAddNoLoop.scm receive them in R64B_1, R64B_2 and R64B_3
+  scm::l2_memory_module * l2 = myMachine->getL2Memory();
+  double *A = l2 ? reinterpret_cast<double*> (l2->l2Malloc(NumElements*sizeof(double))) : nullptr;
+  double *B = l2 ? reinterpret_cast<double*> (l2->l2Malloc(NumElements*sizeof(double))) : nullptr;
+  double *C = l2 ? reinterpret_cast<double*> (l2->l2Malloc(NumElements*sizeof(double))) : nullptr;
+  if (!A || !B || !C) {
+    std::cout << "Could not allocate the vectors in the L2 memory" << std::endl;
+    delete myMachine;
+    return 1;
+  }
+  myMachine->setRegister64B(1, l2->offsetOf(reinterpret_cast<l2_memory_t>(A)));
+  myMachine->setRegister64B(2, l2->offsetOf(reinterpret_cast<l2_memory_t>(B)));
+  myMachine->setRegister64B(3, l2->offsetOf(reinterpret_cast<l2_memory_t>(C)));
+
+  for (unsigned long i = 0; i < NumElements; ++i) {
+      A[i] = i;
+      B[i] = i;
+  }
 
   myMachine->run();
+  if (program_options.placement != scm::NUMA_NONE)
+    myMachine->printBandwidthReport();
 
   TIMERS_COUNTERS_GUARD(
     myMachine->setTimersOutput("trace.json");
   );
 
-  // Checking result
+  // Checking result, only the segments the program adds
   bool success = true;
-  for (long unsigned i = 0; i < NumElements; ++i) {
+  for (long unsigned i = 0; i < std::min(program_options.segments, (unsigned long) REPS)*SegmentElements; ++i) {
     if (C[i] != i+i) {
       success = false;
       SCMULATE_ERROR(0, "RESULT ERROR in i = %ld, value C[i] = %f", i, C[i]);
@@ -85,6 +100,23 @@ void parseProgramOptions(int argc, char* argv[]) {
     if (strcmp(argv[i], "-i") == 0) {
       program_options.fileInput = true;
       program_options.fileName = argv[++i];
+    } else if (strcmp(argv[i], "-c") == 0) {
+      program_options.numCUs = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "-a") == 0) {
+      program_options.cpuList = argv[++i];
+    } else if (strcmp(argv[i], "-w") == 0) {
+      if (!scm::threads_config::parseIdlePolicy(argv[++i], program_options.idlePolicy))
+        std::cout << "Unknown idle policy " << argv[i] << ", use spin, yield or block" << std::endl;
+    } else if (strcmp(argv[i], "-b") == 0) {
+      if (!scm::threads_config::parseBackend(argv[++i], program_options.backend))
+        std::cout << "Unknown threads backend " << argv[i] << ", use omp or threads" << std::endl;
+    } else if (strcmp(argv[i], "-m") == 0) {
+      if (!scm::threads_config::parsePlacement(argv[++i], program_options.placement))
+        std::cout << "Unknown NUMA placement " << argv[i] << ", use none, interleave or blocked" << std::endl;
+    } else if (strcmp(argv[i], "-r") == 0) {
+      program_options.machineFile = argv[++i];
+    } else if (strcmp(argv[i], "-s") == 0) {
+      program_options.segments = strtoul(argv[++i], nullptr, 10);
     }
   }
 }
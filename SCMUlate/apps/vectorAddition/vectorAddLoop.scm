@@ -1,6 +1,4 @@
-LDIMM R64B_1, 0; // Loading base address A
-LDIMM R64B_2, 52428800; // Loading base address B
-LDIMM R64B_3, 104857600; // Loading base address C
+// The host gives the base addresses of A, B and C in R64B_1, R64B_2 and R64B_3
 
 LDIMM R64B_4, 0; // For iteration variable
 LDIMM R64B_5, 0; // For offset
@@ -1,6 +1,5 @@
-ADD R64B_1, R64B_1, 0; // Loading base address A
-ADD R64B_2, R64B_2, 524288; // Loading base address B
-ADD R64B_3, R64B_3, 1048576; // Loading base address C
+// The host gives the base addresses of A, B and C in R64B_1, R64B_2 and R64B_3
+// Only the first 4 segments are added, run it with -s 4
 
 // First segment
 LDOFF R2048L_1, R64B_1, 0; // Offset 0
@@ -22,4 +21,4 @@ LDOFF R2048L_1, R64B_1, 393216; // Offset 3
 LDOFF R2048L_2, R64B_2, 393216; // Offset 3
 COD vecAdd_2048L R2048L_3, R2048L_1, R2048L_2;
 STOFF R2048L_3, R64B_3, 393216; // Offset 3
-COMMIT
+COMMIT;
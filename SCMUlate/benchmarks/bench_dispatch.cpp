@@ -0,0 +1,143 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <cstring>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "instructions.hpp"
+
+/**
+ * Instruction dispatch benchmark. It decodes a mix of control, arithmetic and memory
+ * instructions and measures the cost of selecting the handler of each instruction.
+ * The first method is the previous one: a chain of comparisons against the instruction
+ * name, where each comparison gets a copy of the name. The second method is the switch
+ * over the opcode used by the fetch_decode_module, the mem_interface_module and the
+ * ilp_controller. The handlers only increment a counter, so the difference between both
+ * times is the gain per dispatched instruction.
+ *
+ * usage: benchDispatch [-n <dispatches>]
+ */
+
+static struct {
+  uint64_t dispatches = 10000000;
+} program_options;
+
+static const char * instructionMix[] = {
+  "JMPLBL loop;",
+  "JMPPC 2;",
+  "BREQ R64B_4, R64B_6, 8;",
+  "BGT R64B_4, R64B_6, 8;",
+  "BGET R64B_4, R64B_6, 8;",
+  "BLT R64B_4, R64B_6, 8;",
+  "BLET R64B_4, R64B_6, 8;",
+  "ADD R64B_4, R64B_4, 1;",
+  "SUB R64B_5, R64B_5, 131072;",
+  "SHFL R64B_5, 3;",
+  "SHFR R64B_5, 3;",
+  "MULT R64B_5, R64B_5, 3;",
+  "LDIMM R64B_6, 400;",
+  "LDADR R2048L_1, R64B_1;",
+  "LDOFF R2048L_1, R64B_1, R64B_5;",
+  "STADR R2048L_3, R64B_3;",
+  "STOFF R2048L_3, R64B_3, R64B_5;"
+};
+
+static const char * instructionNames[] = {
+  "JMPLBL", "JMPPC", "BREQ", "BGT", "BGET", "BLT", "BLET",
+  "ADD", "SUB", "SHFL", "SHFR", "MULT",
+  "LDIMM", "LDADR", "LDOFF", "STADR", "STOFF"
+};
+
+void parseProgramOptions(int argc, char* argv[]);
+
+// The name used to be returned by value, every comparison created a new string
+static inline std::string getNameCopy(scm::decoded_instruction_t * inst) {
+  return inst->getInstruction();
+}
+
+static inline void stringDispatch(scm::decoded_instruction_t * inst, uint64_t * handled) {
+  const uint32_t numNames = sizeof(instructionNames)/sizeof(instructionNames[0]);
+  for (uint32_t i = 0; i < numNames; i++) {
+    if (getNameCopy(inst) == instructionNames[i]) {
+      handled[i]++;
+      return;
+    }
+  }
+}
+
+static inline void opcodeDispatch(scm::decoded_instruction_t * inst, uint64_t * handled) {
+  switch (inst->getOpcode()) {
+    case scm::OPC_JMPLBL: handled[0]++; break;
+    case scm::OPC_JMPPC: handled[1]++; break;
+    case scm::OPC_BREQ: handled[2]++; break;
+    case scm::OPC_BGT: handled[3]++; break;
+    case scm::OPC_BGET: handled[4]++; break;
+    case scm::OPC_BLT: handled[5]++; break;
+    case scm::OPC_BLET: handled[6]++; break;
+    case scm::OPC_ADD: handled[7]++; break;
+    case scm::OPC_SUB: handled[8]++; break;
+    case scm::OPC_SHFL: handled[9]++; break;
+    case scm::OPC_SHFR: handled[10]++; break;
+    case scm::OPC_MULT: handled[11]++; break;
+    case scm::OPC_LDIMM: handled[12]++; break;
+    case scm::OPC_LDADR: handled[13]++; break;
+    case scm::OPC_LDOFF: handled[14]++; break;
+    case scm::OPC_STADR: handled[15]++; break;
+    case scm::OPC_STOFF: handled[16]++; break;
+    default: break;
+  }
+}
+
+template <void (*DISPATCH)(scm::decoded_instruction_t *, uint64_t *)>
+double runDispatch(std::vector<scm::decoded_instruction_t *> & insts, uint64_t * handled) {
+  std::chrono::time_point<std::chrono::high_resolution_clock> initTimer = std::chrono::high_resolution_clock::now();
+  for (uint64_t i = 0; i < program_options.dispatches; i++)
+    DISPATCH(insts[i % insts.size()], handled);
+  std::chrono::duration<double> diff = std::chrono::high_resolution_clock::now() - initTimer;
+  return diff.count();
+}
+
+int main (int argc, char * argv[]) {
+  parseProgramOptions(argc, argv);
+  const uint32_t numInsts = sizeof(instructionMix)/sizeof(instructionMix[0]);
+
+  std::vector<scm::inst_text_t> text(numInsts);
+  std::vector<scm::decoded_instruction_t> decoded;
+  std::vector<scm::decoded_instruction_t *> insts;
+  for (uint32_t i = 0; i < numInsts; i++) {
+    decoded.push_back(scm::instructions::findInstType(instructionMix[i], text[i]));
+    if (decoded.back().getType() == scm::UNKNOWN || decoded.back().getOpcode() == scm::OPC_UNKNOWN) {
+      printf("ERROR: could not decode %s\n", instructionMix[i]);
+      return 1;
+    }
+  }
+  for (auto & inst : decoded)
+    insts.push_back(&inst);
+
+  uint64_t handledString[numInsts] = {0}, handledOpcode[numInsts] = {0};
+  double stringTime = runDispatch<stringDispatch>(insts, handledString);
+  double opcodeTime = runDispatch<opcodeDispatch>(insts, handledOpcode);
+
+  printf("dispatches = %lu\n", program_options.dispatches);
+  printf("string compare dispatch: %f s (%f ns/inst)\n", stringTime, stringTime*1e9/program_options.dispatches);
+  printf("opcode switch dispatch: %f s (%f ns/inst)\n", opcodeTime, opcodeTime*1e9/program_options.dispatches);
+  printf("gain = %f ns/inst (%.2fx)\n", (stringTime - opcodeTime)*1e9/program_options.dispatches, stringTime/opcodeTime);
+
+  int result = 0;
+  for (uint32_t i = 0; i < numInsts; i++) {
+    if (handledString[i] != handledOpcode[i]) {
+      printf("ERROR: both dispatchers must select the same handler for %s\n", instructionNames[i]);
+      result = 1;
+    }
+  }
+  return result;
+}
+
+void parseProgramOptions(int argc, char* argv[]) {
+  // there are other arguments
+  for (int i = 1; i + 1 < argc; i++) {
+    if (strcmp(argv[i], "-n") == 0) {
+      program_options.dispatches = strtoull(argv[++i], nullptr, 10);
+    }
+  }
+}
@@ -0,0 +1,118 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <cstring>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <time.h>
+#include <omp.h>
+#include "executor.hpp"
+
+/**
+ * CU idle policy benchmark. A thread plays the SU and assigns an instruction to a
+ * single execution slot every interval, and waits for it to complete. Another thread
+ * plays the CU with the same loop and backoff of cu_executor_module. For each idle
+ * policy it reports the latency from the assignment until the CU starts the instruction,
+ * and the CPU time of the CU thread relative to the elapsed time. A spinning CU uses
+ * 100% of its CPU, a blocked one should use almost nothing while it waits.
+ *
+ * usage: benchIdlePolicy [-n <instructions>] [-t <interval in us>]
+ */
+
+static struct {
+  uint64_t instructions = 2000;
+  uint64_t interval = 200;
+} program_options;
+
+static const scm::IDLE_POLICIES policies[] = {scm::IDLE_SPIN, scm::IDLE_YIELD, scm::IDLE_BLOCK};
+static const char * policyNames[] = {"IDLE_SPIN", "IDLE_YIELD", "IDLE_BLOCK"};
+
+void parseProgramOptions(int argc, char* argv[]);
+
+static double threadCPUTime() {
+  struct timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+
+int main (int argc, char * argv[]) {
+  parseProgramOptions(argc, argv);
+  typedef std::chrono::time_point<std::chrono::high_resolution_clock> time_point_t;
+  const uint64_t numInsts = program_options.instructions;
+  int errors = 0;
+
+  printf("instructions = %lu, interval = %lu us\n", numInsts, program_options.interval);
+  printf("%-12s %14s %14s %14s %12s\n", "policy", "mean lat (us)", "p50 lat (us)", "p99 lat (us)", "CU CPU (%)");
+  for (uint32_t p = 0; p < sizeof(policies)/sizeof(policies[0]); p++) {
+    scm::threads_config threads(1, std::vector<int>());
+    threads.setIdlePolicy(policies[p]);
+    scm::control_store_module ctrl(1, 1);
+    scm::execution_slot * slot = ctrl.get_executor(0);
+    std::vector<scm::decoded_instruction_t> insts(numInsts, scm::decoded_instruction_t(scm::EXECUTE_INST));
+    std::vector<time_point_t> assigned(numInsts), started(numInsts);
+    volatile bool alive = true;
+    double cuCPUTime = 0, elapsed = 0;
+
+    #pragma omp parallel num_threads(2) shared(alive)
+    {
+      if (omp_get_thread_num() == 0) {
+        time_point_t initTimer = std::chrono::high_resolution_clock::now();
+        for (uint64_t i = 0; i < numInsts; i++) {
+          std::this_thread::sleep_for(std::chrono::microseconds(program_options.interval));
+          assigned[i] = std::chrono::high_resolution_clock::now();
+          while (!slot->assign(&insts[i]))
+            std::this_thread::yield();
+          while (ctrl.getCompletionQueue()->pop() == nullptr)
+            std::this_thread::yield();
+        }
+        std::chrono::duration<double> diff = std::chrono::high_resolution_clock::now() - initTimer;
+        elapsed = diff.count();
+        #pragma omp atomic write
+        alive = false;
+        ctrl.wakeAll();
+      } else {
+        scm::cu_idle_backoff backoff(threads);
+        double initCPU = threadCPUTime();
+        while (alive) {
+          scm::decoded_instruction_t * inst = slot->steal(slot);
+          if (!inst) {
+            backoff.idle(slot, &alive);
+            continue;
+          }
+          backoff.reset();
+          started[inst - insts.data()] = std::chrono::high_resolution_clock::now();
+          slot->done_execution();
+        }
+        cuCPUTime = threadCPUTime() - initCPU;
+      }
+    }
+
+    std::vector<double> latencies(numInsts);
+    double sum = 0;
+    for (uint64_t i = 0; i < numInsts; i++) {
+      std::chrono::duration<double> diff = started[i] - assigned[i];
+      latencies[i] = diff.count()*1e6;
+      sum += latencies[i];
+    }
+    std::sort(latencies.begin(), latencies.end());
+    if (latencies.front() < 0) {
+      printf("ERROR: an instruction started before it was assigned\n");
+      errors++;
+    }
+    printf("%-12s %14.2f %14.2f %14.2f %12.1f\n", policyNames[p], sum/numInsts, latencies[numInsts/2],
+           latencies[std::min(numInsts - 1, numInsts*99/100)], 100*cuCPUTime/elapsed);
+  }
+  return errors == 0 ? 0 : 1;
+}
+
+void parseProgramOptions(int argc, char* argv[]) {
+  // there are other arguments
+  for (int i = 1; i + 1 < argc; i++) {
+    if (strcmp(argv[i], "-n") == 0) {
+      program_options.instructions = strtoull(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "-t") == 0) {
+      program_options.interval = strtoull(argv[++i], nullptr, 10);
+    }
+  }
+}
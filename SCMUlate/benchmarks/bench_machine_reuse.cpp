@@ -0,0 +1,109 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <cstring>
+#include <chrono>
+#include <fstream>
+#include "scm_machine.hpp"
+
+/**
+ * Machine reuse benchmark. It runs a small SCM kernel many times, as a service that
+ * receives a stream of programs would do. The first method creates a new scm_machine
+ * for every kernel (register file, executors, threads and program load). The second
+ * one creates a single machine and calls load(), reset() and run() for every kernel.
+ * The third one only calls run() again on the loaded kernel. Both machines use the
+ * persistent threads backend and blocked idle CUs, so the difference is the setup cost.
+ *
+ * usage: benchMachineReuse [-n <kernels>] [-c <CUs>]
+ */
+
+static struct {
+  uint64_t kernels = 200;
+  uint32_t numCUs = 2;
+} program_options;
+
+// Counts up to 10 in R64B_1
+static const char * kernelText =
+  "LDIMM R64B_1, 0;\n"
+  "LDIMM R64B_2, 10;\n"
+  "loop:\n"
+  "  BREQ R64B_1, R64B_2, 3;\n"
+  "  ADD R64B_1, R64B_1, 1;\n"
+  "  JMPLBL loop;\n"
+  "COMMIT;\n";
+
+#define SIZEOFMEM (1024*1024)
+
+void parseProgramOptions(int argc, char* argv[]);
+
+static bool checkKernel(scm::scm_machine * machine) {
+  unsigned char * reg = machine->getRegFile()->getRegisterByName("64B", 1);
+  return reg[7] == 10;
+}
+
+int main (int argc, char * argv[]) {
+  parseProgramOptions(argc, argv);
+  char fileName[] = "bench_machine_reuse.scm";
+  std::ofstream programFile(fileName);
+  programFile << kernelText;
+  programFile.close();
+
+  unsigned char * memory = new unsigned char[SIZEOFMEM];
+  scm::threads_config threads(program_options.numCUs, std::vector<int>());
+  threads.setBackend(scm::STD_THREAD_BACKEND);
+  threads.setIdlePolicy(scm::IDLE_BLOCK);
+  uint64_t errors = 0;
+
+  // A new machine for each kernel
+  std::chrono::time_point<std::chrono::high_resolution_clock> initTimer = std::chrono::high_resolution_clock::now();
+  for (uint64_t i = 0; i < program_options.kernels; i++) {
+    scm::scm_machine * machine = new scm::scm_machine(fileName, memory, scm::SUPERSCALAR, scm::ROUND_ROBIN, threads);
+    if (machine->run() != scm::SCM_RUN_SUCCESS || !checkKernel(machine))
+      errors++;
+    delete machine;
+  }
+  std::chrono::duration<double> newTime = std::chrono::high_resolution_clock::now() - initTimer;
+
+  // One machine, load and reset for each kernel
+  scm::scm_machine * machine = new scm::scm_machine(fileName, memory, scm::SUPERSCALAR, scm::ROUND_ROBIN, threads);
+  initTimer = std::chrono::high_resolution_clock::now();
+  for (uint64_t i = 0; i < program_options.kernels; i++) {
+    if (!machine->load(fileName))
+      errors++;
+    machine->reset();
+    if (machine->run() != scm::SCM_RUN_SUCCESS || !checkKernel(machine))
+      errors++;
+  }
+  std::chrono::duration<double> reuseTime = std::chrono::high_resolution_clock::now() - initTimer;
+
+  // Only run the loaded kernel again
+  initTimer = std::chrono::high_resolution_clock::now();
+  for (uint64_t i = 0; i < program_options.kernels; i++) {
+    if (machine->run() != scm::SCM_RUN_SUCCESS || !checkKernel(machine))
+      errors++;
+  }
+  std::chrono::duration<double> rerunTime = std::chrono::high_resolution_clock::now() - initTimer;
+  delete machine;
+  delete [] memory;
+  remove(fileName);
+
+  printf("kernels = %lu, CUs = %u\n", program_options.kernels, program_options.numCUs);
+  printf("new machine per kernel: %f s (%f us/kernel)\n", newTime.count(), newTime.count()*1e6/program_options.kernels);
+  printf("load + reset + run: %f s (%f us/kernel, %.2fx)\n", reuseTime.count(), reuseTime.count()*1e6/program_options.kernels, newTime.count()/reuseTime.count());
+  printf("run again: %f s (%f us/kernel, %.2fx)\n", rerunTime.count(), rerunTime.count()*1e6/program_options.kernels, newTime.count()/rerunTime.count());
+  if (errors != 0) {
+    printf("ERROR: %lu kernels failed\n", errors);
+    return 1;
+  }
+  return 0;
+}
+
+void parseProgramOptions(int argc, char* argv[]) {
+  // there are other arguments
+  for (int i = 1; i + 1 < argc; i++) {
+    if (strcmp(argv[i], "-n") == 0) {
+      program_options.kernels = strtoull(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "-c") == 0) {
+      program_options.numCUs = strtoul(argv[++i], nullptr, 10);
+    }
+  }
+}
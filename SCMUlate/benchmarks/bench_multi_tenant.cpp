@@ -0,0 +1,145 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <cstring>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "scm_multi_machine.hpp"
+
+/**
+ * Multi-tenant benchmark. A batch of independent programs copies blocks of 128KB with
+ * LDOFF and STOFF (SUPERSCALAR, so the copies of a program run in parallel). The programs
+ * have 1 to 4 times the base number of blocks, so the batch has a tail. It reports the
+ * throughput of the batch:
+ *  - one scm_machine with all the CUs that runs the programs one after another (load, reset, run)
+ *  - scm_multi_machine with the CUs divided evenly between the SUs, without rebalancing
+ *  - scm_multi_machine with rebalancing, the CUs of an SU without programs go to the others
+ *
+ * usage: benchMultiTenant [-n <programs>] [-s <SUs>] [-c <CUs>] [-b <base blocks>]
+ */
+
+static struct {
+  uint32_t programs = 16;
+  uint32_t numSUs = 2;
+  uint32_t numCUs = 4;
+  uint32_t blocks = 8;
+} program_options;
+
+#define BLOCK_SIZE (64*2048)
+#define LENGTHS 4
+
+void parseProgramOptions(int argc, char* argv[]);
+
+// Copies blocks from address 0 to address blocks*BLOCK_SIZE
+static void writeProgram(const char * fileName, uint32_t blocks) {
+  std::ofstream program(fileName);
+  program << "LDIMM R64B_1, 0;\n"
+          << "LDIMM R64B_2, " << blocks*BLOCK_SIZE << ";\n"
+          << "LDIMM R64B_3, 0;\n"
+          << "LDIMM R64B_4, 0;\n"
+          << "LDIMM R64B_5, " << blocks << ";\n"
+          << "loop:\n"
+          << "  BREQ R64B_4, R64B_5, 6;\n"
+          << "  LDOFF R2048L_1, R64B_1, R64B_3;\n"
+          << "  STOFF R2048L_1, R64B_2, R64B_3;\n"
+          << "  ADD R64B_4, R64B_4, 1;\n"
+          << "  ADD R64B_3, R64B_3, " << BLOCK_SIZE << ";\n"
+          << "  JMPLBL loop;\n"
+          << "COMMIT;\n";
+}
+
+static uint32_t programBlocks(uint32_t program) {
+  return program_options.blocks*(1 + program % LENGTHS);
+}
+
+static void printResult(const char * name, double seconds, uint64_t bytes) {
+  printf("%-32s %10.4f s %10.2f programs/s %10.2f GB/s\n", name, seconds, program_options.programs/seconds, bytes/seconds/1e9);
+}
+
+int main (int argc, char * argv[]) {
+  parseProgramOptions(argc, argv);
+  char fileNames[LENGTHS][32];
+  for (uint32_t l = 0; l < LENGTHS; l++) {
+    snprintf(fileNames[l], sizeof(fileNames[l]), "bench_multi_tenant_%u.scm", l);
+    writeProgram(fileNames[l], programBlocks(l));
+  }
+
+  // Each program has its own memory, source and destination
+  uint64_t memSize = 2l*programBlocks(LENGTHS - 1)*BLOCK_SIZE;
+  std::vector<unsigned char *> memories(program_options.programs);
+  uint64_t bytes = 0;
+  for (uint32_t p = 0; p < program_options.programs; p++) {
+    memories[p] = new unsigned char[memSize];
+    for (uint64_t i = 0; i < memSize/2; i++)
+      memories[p][i] = (p + i) & 0xFF;
+    bytes += 2l*programBlocks(p)*BLOCK_SIZE;
+  }
+  int errors = 0;
+  printf("programs = %u, SUs = %u, CUs = %u, blocks = %u to %u\n", program_options.programs, program_options.numSUs,
+         program_options.numCUs, programBlocks(0), programBlocks(LENGTHS - 1));
+
+  // One program at a time with all the CUs
+  scm::threads_config threads(program_options.numCUs, std::vector<int>());
+  threads.setBackend(scm::STD_THREAD_BACKEND);
+  threads.setIdlePolicy(scm::IDLE_BLOCK);
+  scm::scm_machine * machine = new scm::scm_machine(fileNames[0], memories[0], scm::SUPERSCALAR, scm::ROUND_ROBIN, threads);
+  std::chrono::time_point<std::chrono::high_resolution_clock> initTimer = std::chrono::high_resolution_clock::now();
+  for (uint32_t p = 0; p < program_options.programs; p++) {
+    machine->load(fileNames[p % LENGTHS]);
+    machine->reset();
+    if (machine->run() != scm::SCM_RUN_SUCCESS)
+      errors++;
+  }
+  std::chrono::duration<double> diff = std::chrono::high_resolution_clock::now() - initTimer;
+  delete machine;
+  printResult("scm_machine, one at a time", diff.count(), bytes);
+
+  for (int rebalance = 0; rebalance < 2; rebalance++) {
+    for (uint32_t p = 0; p < program_options.programs; p++)
+      memset(memories[p] + memSize/2, 0, memSize/2);
+    std::vector<scm::scm_job_t> batch;
+    for (uint32_t p = 0; p < program_options.programs; p++)
+      batch.emplace_back(fileNames[p % LENGTHS], memories[p]);
+    scm::scm_multi_machine multiMachine(program_options.numSUs, scm::SUPERSCALAR, scm::ROUND_ROBIN, threads);
+    multiMachine.setRebalancing(rebalance == 1);
+    initTimer = std::chrono::high_resolution_clock::now();
+    if (multiMachine.run(batch) != scm::SCM_RUN_SUCCESS)
+      errors++;
+    diff = std::chrono::high_resolution_clock::now() - initTimer;
+
+    uint32_t maxCUs = 0;
+    for (uint32_t p = 0; p < program_options.programs; p++) {
+      uint64_t copied = programBlocks(p)*BLOCK_SIZE;
+      if (memcmp(memories[p], memories[p] + copied, copied) != 0) {
+        printf("ERROR: program %u did not copy its blocks\n", p);
+        errors++;
+      }
+      maxCUs = std::max(maxCUs, batch[p].max_cus);
+    }
+    std::string name = std::string("scm_multi_machine, ") + (rebalance ? "rebalancing" : "static");
+    printResult(name.c_str(), diff.count(), bytes);
+    printf("%-32s largest partition %u CUs\n", "", maxCUs);
+  }
+
+  for (uint32_t p = 0; p < program_options.programs; p++)
+    delete [] memories[p];
+  for (uint32_t l = 0; l < LENGTHS; l++)
+    remove(fileNames[l]);
+  return errors == 0 ? 0 : 1;
+}
+
+void parseProgramOptions(int argc, char* argv[]) {
+  // there are other arguments
+  for (int i = 1; i + 1 < argc; i++) {
+    if (strcmp(argv[i], "-n") == 0) {
+      program_options.programs = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "-s") == 0) {
+      program_options.numSUs = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "-c") == 0) {
+      program_options.numCUs = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "-b") == 0) {
+      program_options.blocks = strtoul(argv[++i], nullptr, 10);
+    }
+  }
+}
@@ -0,0 +1,123 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <cstring>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "instruction_mem.hpp"
+#include "regex_decoder.hpp"
+
+/**
+ * Program load benchmark. It generates a synthetic SCM program and compares the time
+ * it takes to classify and decode every line with the regular expressions decoder and
+ * with the inst_lexer that is used by the instruction memory. It also reports the time
+ * of a complete inst_mem_module load (decode + operands + labels) of the same program, 
+ * both from the text and from its binary image.
+ *
+ * usage: benchProgramLoad [-n <lines>]
+ */
+
+static struct {
+  uint64_t lines = 5000;
+} program_options;
+
+static const char * programBody[] = {
+  "loop:",
+  "  BREQ R64B_4, R64B_6, 8;",
+  "  LDOFF R2048L_1, R64B_1, R64B_5; // A",
+  "  LDOFF R2048L_2, R64B_2, R64B_5;",
+  "  COD print R64B_1, 8;",
+  "  STOFF R2048L_3, R64B_3, R64B_5;",
+  "  ADD R64B_4, R64B_4, 1;",
+  "  SUB R64B_5, R64B_5, 131072;",
+  "// Comment line",
+  "  LDIMM R64B_6, 400;",
+  "  JMPLBL loop;"
+};
+
+void parseProgramOptions(int argc, char* argv[]);
+
+template <typename DECODER>
+double decodeLines(std::vector<std::string> & lines, uint64_t & decoded) {
+  std::chrono::time_point<std::chrono::high_resolution_clock> initTimer = std::chrono::high_resolution_clock::now();
+  for (auto & line : lines) {
+    if (DECODER::isLabel(line)) {
+      volatile size_t len = DECODER::getLabel(line).length();
+      (void) len;
+    } else if (!DECODER::isComment(line)) {
+      scm::inst_text_t text;
+      scm::decoded_instruction_t inst = DECODER::findInstType(line, text);
+      if (inst.getType() != scm::UNKNOWN)
+        decoded++;
+    }
+  }
+  std::chrono::duration<double> diff = std::chrono::high_resolution_clock::now() - initTimer;
+  return diff.count();
+}
+
+int main (int argc, char * argv[]) {
+  parseProgramOptions(argc, argv);
+  const uint64_t bodySize = sizeof(programBody)/sizeof(programBody[0]);
+
+  // Generate the program. Labels must be unique for the loader
+  std::vector<std::string> lines;
+  lines.reserve(program_options.lines + 1);
+  for (uint64_t i = 0; i < program_options.lines; i++) {
+    if (i % bodySize == 0)
+      lines.push_back("loop" + std::to_string(i/bodySize) + ":");
+    else if (i % bodySize == bodySize - 1)
+      lines.push_back("  JMPLBL loop" + std::to_string(i/bodySize) + ";");
+    else
+      lines.push_back(programBody[i % bodySize]);
+  }
+  lines.push_back("COMMIT;");
+
+  uint64_t decodedRegex = 0, decodedLexer = 0;
+  double regexTime = decodeLines<scm::regex_instructions>(lines, decodedRegex);
+  double lexerTime = decodeLines<scm::instructions>(lines, decodedLexer);
+
+  printf("lines = %lu\n", lines.size());
+  printf("std::regex decode: %f s (%lu instructions, %f us/line)\n", regexTime, decodedRegex, regexTime*1e6/lines.size());
+  printf("inst_lexer decode: %f s (%lu instructions, %f us/line)\n", lexerTime, decodedLexer, lexerTime*1e6/lines.size());
+  printf("speedup = %.2fx\n", regexTime/lexerTime);
+  if (decodedRegex != decodedLexer) {
+    printf("ERROR: both decoders must recognize the same instructions\n");
+    return 1;
+  }
+
+  // Complete load through the instruction memory
+  char fileName[] = "bench_program_load.scm";
+  std::ofstream programFile(fileName);
+  for (auto & line : lines)
+    programFile << line << "\n";
+  programFile.close();
+
+  scm::reg_file_module reg_file_m;
+  std::chrono::time_point<std::chrono::high_resolution_clock> initTimer = std::chrono::high_resolution_clock::now();
+  scm::inst_mem_module inst_mem_m(fileName, &reg_file_m);
+  std::chrono::duration<double> diff = std::chrono::high_resolution_clock::now() - initTimer;
+  printf("inst_mem_module text load: %f s (%u instructions, valid = %d)\n", diff.count(), inst_mem_m.getMemSize(), inst_mem_m.isValid());
+  remove(fileName);
+
+  // Complete load of the binary image of the same program
+  char imageName[] = "bench_program_load.scmb";
+  if (!inst_mem_m.writeImage(imageName))
+    return 1;
+  initTimer = std::chrono::high_resolution_clock::now();
+  scm::inst_mem_module image_mem_m(imageName, &reg_file_m);
+  diff = std::chrono::high_resolution_clock::now() - initTimer;
+  printf("inst_mem_module image load: %f s (%u instructions, valid = %d)\n", diff.count(), image_mem_m.getMemSize(), image_mem_m.isValid());
+  remove(imageName);
+
+  return (inst_mem_m.isValid() && image_mem_m.isValid()) ? 0 : 1;
+}
+
+void parseProgramOptions(int argc, char* argv[]) {
+  // there are other arguments
+  for (int i = 1; i + 1 < argc; i++) {
+    if (strcmp(argv[i], "-n") == 0) {
+      program_options.lines = strtoull(argv[++i], nullptr, 10);
+    }
+  }
+}
@@ -0,0 +1,89 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <cstring>
+#include <chrono>
+#include <vector>
+#include <random>
+#include "register_arith.hpp"
+#include "register_config.hpp"
+
+/**
+ * Register arithmetic benchmark. For each register size it measures ADD, SHFL, SHFR
+ * and MULT with the limb kernels of register_arith.hpp, and ADD and SHFL with a byte
+ * by byte loop over the big-endian register, like ADD used to be done. MULT is
+ * measured with the destination of the same size as the sources (the lower half of
+ * the product), which is what a program does with MULT R2048L_1, R2048L_2, R2048L_3.
+ * The time of each operation is the average of -n repetitions (fewer for the large
+ * registers so their products do not take too long).
+ *
+ * usage: benchRegisterArith [-n <repetitions>]
+ */
+
+static struct {
+  uint64_t repetitions = 100000;
+} program_options;
+
+void parseProgramOptions(int argc, char* argv[]);
+
+static void byteAdd(unsigned char * r1, const unsigned char * r2, const unsigned char * r3, uint32_t size) {
+  uint32_t temp = 0;
+  for (int32_t i = size - 1; i >= 0; --i) {
+    temp += r3[i] + r2[i];
+    r1[i] = temp & 255;
+    temp = temp > 255 ? 1 : 0;
+  }
+}
+
+static void byteShiftLeft(unsigned char * reg, uint32_t size, uint32_t bits) {
+  for (uint32_t b = 0; b < bits; b++) {
+    unsigned char carry = 0;
+    for (int32_t i = size - 1; i >= 0; --i) {
+      unsigned char out = reg[i] >> 7;
+      reg[i] = (reg[i] << 1) | carry;
+      carry = out;
+    }
+  }
+}
+
+template <typename OP>
+double timeOp(uint64_t repetitions, OP op) {
+  std::chrono::time_point<std::chrono::high_resolution_clock> initTimer = std::chrono::high_resolution_clock::now();
+  for (uint64_t i = 0; i < repetitions; i++)
+    op();
+  std::chrono::duration<double> diff = std::chrono::high_resolution_clock::now() - initTimer;
+  return diff.count()*1e9/repetitions;
+}
+
+int main (int argc, char * argv[]) {
+  parseProgramOptions(argc, argv);
+  std::mt19937_64 random(1);
+  printf("%-6s %10s %14s %14s %14s %14s %14s %14s\n", "reg", "bytes", "byte ADD ns", "ADD ns", "byte SHFL ns", "SHFL ns", "SHFR ns", "MULT ns");
+  for (uint8_t sizeClass = 0; sizeClass < scm::REG_SIZE_CLASSES; sizeClass++) {
+    uint32_t size = scm::register_geometry::getRegisterSizeInBytes(sizeClass);
+    std::vector<unsigned char> a(size), b(size), c(size);
+    for (uint32_t i = 0; i < size; i++) {
+      a[i] = random();
+      b[i] = random();
+    }
+    // The time of the products grows with size^1.58
+    uint64_t repetitions = program_options.repetitions/(size/8 > 64 ? size/512 : 1) + 1;
+    double byteAddTime = timeOp(repetitions, [&] { byteAdd(c.data(), a.data(), b.data(), size); });
+    double addTime = timeOp(repetitions, [&] { scm::register_arith::add(c.data(), size, a.data(), size, b.data(), size); });
+    double byteShiftTime = timeOp(repetitions, [&] { byteShiftLeft(c.data(), size, 3); });
+    double shiftLeftTime = timeOp(repetitions, [&] { scm::register_arith::shiftLeft(c.data(), size, 3); });
+    double shiftRightTime = timeOp(repetitions, [&] { scm::register_arith::shiftRight(c.data(), size, 3); });
+    double multTime = timeOp(repetitions, [&] { scm::register_arith::mult(c.data(), size, a.data(), size, b.data(), size); });
+    printf("%-6s %10u %14.1f %14.1f %14.1f %14.1f %14.1f %14.1f\n", scm::register_geometry::getRegisterSizeName(sizeClass), size,
+        byteAddTime, addTime, byteShiftTime, shiftLeftTime, shiftRightTime, multTime);
+  }
+  return 0;
+}
+
+void parseProgramOptions(int argc, char* argv[]) {
+  // there are other arguments
+  for (int i = 1; i + 1 < argc; i++) {
+    if (strcmp(argv[i], "-n") == 0) {
+      program_options.repetitions = strtoull(argv[++i], nullptr, 10);
+    }
+  }
+}
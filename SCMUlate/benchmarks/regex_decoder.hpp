@@ -0,0 +1,256 @@
+#ifndef __BENCH_REGEX_DECODER__
+#define __BENCH_REGEX_DECODER__
+
+/**
+ * Regular expressions based decoder that was used by the instruction memory before
+ * the inst_lexer was introduced. It is only kept to compare the load time of both
+ * implementations in the benchmarks. Do not use it in the machine.
+ */
+
+#include <string>
+#include <regex>
+#include "instructions.hpp"
+
+// Grammar of the instructions as regular expressions. The instruction definitions do not keep them anymore
+#define REGISTER_REGEX "R[BbLl0-9_]+"
+#define REGISTER_SPLIT_REGEX "R([BbLl0-9]+)_([0-9]+)"
+#define INMIDIATE_REGEX "[-]?[0-9]+"
+#define LABEL_REGEX "([a-zA-Z0-9_]+)"
+#define COMMENT_REGEX "([ ]*//.*)"
+#define COMMIT_INST_REGEX "[ ]*(COMMIT;).*"
+#define LABEL_INST_REGEX "[ ]*([a-zA-Z0-9_]+)[ ]*:.*"
+#define CODELET_INST_REGEX "[ ]*COD[ ]+([a-zA-Z0-9_]+)[ ]+([a-zA-Z0-9_, ]*);.*"
+
+namespace scm {
+  // Same order as controlInsts
+  static const char * const controlRegex[] = {
+    "[ ]*(JMPLBL)[ ]+(" LABEL_REGEX ");.*",
+    "[ ]*(JMPPC)[ ]+(" INMIDIATE_REGEX ");.*",
+    "[ ]*(BREQ)[ ]+(" REGISTER_REGEX ")[ ]*,[ ]*(" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX ");.*",
+    "[ ]*(BGT)[ ]+(" REGISTER_REGEX ")[ ]*,[ ]*(" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX ");.*",
+    "[ ]*(BGET)[ ]+(" REGISTER_REGEX ")[ ]*,[ ]*(" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX ");.*",
+    "[ ]*(BLT)[ ]+(" REGISTER_REGEX ")[ ]*,[ ]*(" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX ");.*",
+    "[ ]*(BLET)[ ]+(" REGISTER_REGEX ")[ ]*,[ ]*(" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX ");.*"};
+  // Same order as basicArithInsts
+  static const char * const basicArithRegex[] = {
+    "[ ]*(ADD)[ ]+(" REGISTER_REGEX ")[ ]*,[ ]*(" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX "|" REGISTER_REGEX ")[ ]*;.*",
+    "[ ]*(SUB)[ ]+(" REGISTER_REGEX ")[ ]*,[ ]*(" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX "|" REGISTER_REGEX ")[ ]*;.*",
+    "[ ]*(SHFL)[ ]+(" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX "|" REGISTER_REGEX ")[ ]*;.*",
+    "[ ]*(SHFR)[ ]+(" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX "|" REGISTER_REGEX ")[ ]*;.*",
+    "[ ]*(MULT)[ ]+(" REGISTER_REGEX ")[ ]*,[ ]*(" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX "|" REGISTER_REGEX ")[ ]*;.*"};
+  // Same order as memInsts
+  static const char * const memRegex[] = {
+    "[ ]*(LDIMM)[ ]+(" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX ")[ ]*;.*",
+    "[ ]*(LDADR)[ ]+(" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX "|" REGISTER_REGEX ")[ ]*;.*",
+    "[ ]*(LDOFF)[ ]+(" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX "|" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX "|" REGISTER_REGEX ")[ ]*;.*",
+    "[ ]*(STADR)[ ]+(" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX "|" REGISTER_REGEX ")[ ]*;.*",
+    "[ ]*(STOFF)[ ]+(" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX "|" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX "|" REGISTER_REGEX ")[ ]*;.*"};
+
+  class regex_instructions {
+    public:
+      static inline decoded_instruction_t findInstType(std::string const inst, inst_text_t & text);
+      static inline bool isComment(std::string const inst);
+      static inline bool isLabel(std::string const inst);
+      static inline bool isCommit(std::string const inst, inst_text_t & text, decoded_instruction_t * decInst);
+      static inline decoded_reg_t decodeRegister(std::string const op);
+      static inline bool isRegister(std::string const op);
+      static inline bool isControlInst(std::string const inst, inst_text_t & text, decoded_instruction_t * decInst);
+      static inline bool isBasicArith(std::string const inst, inst_text_t & text, decoded_instruction_t * decInst);
+      static inline bool isExecution(std::string const inst, inst_text_t & text, decoded_instruction_t * decInst);
+      static inline bool isMemory(std::string const ints, inst_text_t & text, decoded_instruction_t * decInst);
+      static inline std::string getLabel(std::string const inst);
+  };
+
+  decoded_instruction_t
+    regex_instructions::findInstType(std::string const instruction, inst_text_t & text) {
+      decoded_instruction_t dec(UNKNOWN, &text);
+      if (!isCommit(instruction, text, &dec) && !isControlInst(instruction, text, &dec) && !isBasicArith(instruction, text, &dec) &&
+          !isExecution(instruction, text, &dec) && !isMemory(instruction, text, &dec))
+        dec = decoded_instruction_t(UNKNOWN, &text);
+
+      SCMULATE_INFOMSG(4, "decoded: {type = %d, opcode = %s, op1 = %s, op2 = %s, op3 = %s}, ", dec.getType(), dec.getInstruction().c_str(), dec.getOp1Str().c_str(), dec.getOp2Str().c_str(), dec.getOp3Str().c_str());
+      
+
+      return dec;
+    }
+
+  bool 
+    regex_instructions::isCommit(std::string const inst, inst_text_t & text, decoded_instruction_t * decInst) {
+      std::regex search_exp(COMMIT_INST_REGEX, std::regex_constants::ECMAScript);
+      std::smatch matches;
+      if (std::regex_search(inst.begin(), inst.end(), matches, search_exp)) {
+        *decInst = decoded_instruction_t(COMMIT, &text);
+        return true;
+      }
+      return false;
+    }
+
+  bool 
+    regex_instructions::isRegister(std::string const op) {
+      std::regex search_exp(REGISTER_REGEX, std::regex_constants::ECMAScript);
+      if (std::regex_match(op, search_exp))
+        return true;
+      return false;
+    }
+
+  bool 
+    regex_instructions::isComment(std::string const inst) {
+      std::regex search_exp(COMMENT_REGEX, std::regex_constants::ECMAScript);
+      if (std::regex_match(inst, search_exp))
+        return true;
+      return false;
+    }
+
+  bool 
+    regex_instructions::isLabel(std::string const inst) {
+      std::regex search_exp(LABEL_INST_REGEX, std::regex_constants::ECMAScript);
+      if (std::regex_match(inst, search_exp))
+        return true;
+      return false;
+    }
+
+  decoded_reg_t
+    regex_instructions::decodeRegister(std::string const op) {
+      std::regex search_exp(REGISTER_SPLIT_REGEX, std::regex_constants::ECMAScript);
+      std::smatch matches;
+      decoded_reg_t res(reg_file_module::NUM_REG_SIZE_CLASSES, 0, 0, decoded_reg_t::NO_REG_ID, nullptr);
+      if (std::regex_search(op.begin(), op.end(), matches, search_exp)) {
+         res.reg_size_class = reg_file_module::getRegisterSizeClass(matches[1].str());
+         res.reg_number = std::stoi(matches[2]);
+      }
+      return res;
+    }
+
+  std::string
+    regex_instructions::getLabel(std::string const inst) {
+      std::regex search_exp(LABEL_INST_REGEX, std::regex_constants::ECMAScript);
+      std::smatch matches;
+      if (std::regex_search(inst.begin(), inst.end(), matches, search_exp)) {
+        return matches[1];
+      }
+      return "";
+    }
+
+  bool 
+    regex_instructions::isControlInst(std::string const inst, inst_text_t & text, decoded_instruction_t * decInst) {
+      for (size_t i = 0; i < NUM_OF_INST(controlInsts); i++) {
+        std::regex search_exp(controlRegex[i], std::regex_constants::ECMAScript);
+        std::smatch matches;
+        if (std::regex_search(inst.begin(), inst.end(), matches, search_exp)) {
+          if (controlInsts[i].num_op == 0) {
+            text = {matches[1], "" , "", ""};
+            *decInst = decoded_instruction_t(CONTROL_INST, controlInsts[i].opcode, &text);
+          } else if (controlInsts[i].num_op == 1) {
+            text = {matches[1], matches[2] , "", ""};
+            *decInst = decoded_instruction_t(CONTROL_INST, controlInsts[i].opcode, &text);
+          } else if (controlInsts[i].num_op == 2) {
+            text = {matches[1], matches[2] , matches[3], ""};
+            *decInst = decoded_instruction_t(CONTROL_INST, controlInsts[i].opcode, &text);
+          } else if (controlInsts[i].num_op == 3) {
+            text = {matches[1], matches[2] , matches[3], matches[4]};
+            *decInst = decoded_instruction_t(CONTROL_INST, controlInsts[i].opcode, &text);
+          } else {
+            SCMULATE_ERROR(0, "Unsupported number of operands for CONTROL instruction");
+          }
+          decInst->setOpIO(controlInsts[i].op_in_out);
+          return true; 
+        }
+      }
+      return false;
+    }
+
+  bool 
+    regex_instructions::isBasicArith(std::string const inst, inst_text_t & text, decoded_instruction_t * decInst) {
+      for (size_t i = 0; i < NUM_OF_INST(basicArithInsts); i++) {
+        std::regex search_exp(basicArithRegex[i], std::regex_constants::ECMAScript);
+        std::smatch matches;
+        if (std::regex_search(inst.begin(), inst.end(), matches, search_exp)) {
+          if (basicArithInsts[i].num_op == 0) {
+            text = {matches[1], "" , "", ""};
+            *decInst = decoded_instruction_t(BASIC_ARITH_INST, basicArithInsts[i].opcode, &text);
+          } else if (basicArithInsts[i].num_op == 1) {
+            text = {matches[1], matches[2] , "", ""};
+            *decInst = decoded_instruction_t(BASIC_ARITH_INST, basicArithInsts[i].opcode, &text);
+          } else if (basicArithInsts[i].num_op == 2) {
+            text = {matches[1], matches[2] , matches[3], ""};
+            *decInst = decoded_instruction_t(BASIC_ARITH_INST, basicArithInsts[i].opcode, &text);
+          } else if (basicArithInsts[i].num_op == 3) {
+            text = {matches[1], matches[2] , matches[3], matches[4]};
+            *decInst = decoded_instruction_t(BASIC_ARITH_INST, basicArithInsts[i].opcode, &text);
+          } else {
+            SCMULATE_ERROR(0, "Unsupported number of operands for BASIC_ARITH_INST instruction");
+          }
+          decInst->setOpIO(basicArithInsts[i].op_in_out);
+          return true; 
+        }
+      }
+      return false;
+    }
+
+  bool 
+    regex_instructions::isExecution(std::string const inst, inst_text_t & text, decoded_instruction_t * decInst) {
+      std::regex search_exp(CODELET_INST_REGEX, std::regex_constants::ECMAScript);
+      std::smatch matches;
+      if (std::regex_search(inst.begin(), inst.end(), matches, search_exp)) {
+        std::string operands = matches[2];
+        std::string delimiter = ",";
+        size_t pos = 0;
+        size_t opNum = 0;
+        std::string token;
+        text = {matches[1], "", "", ""};
+        *decInst = decoded_instruction_t(EXECUTE_INST, &text);
+        while (operands.length() != 0) {
+          pos = operands.find(delimiter);
+          if (pos == std::string::npos) pos = operands.length();
+          token = operands.substr(0, pos);
+          token = trim(token);
+          if (opNum == 0) {
+            text.op1_s = token;
+          } else if (opNum == 1) {
+            text.op2_s = token;
+          } else if (opNum == 2) {
+            text.op3_s = token;
+          } else {
+            SCMULATE_ERROR(0, "Unsupported number of operands for EXECUTE_INST instruction");
+            break;
+          }
+          operands.erase(0, pos + delimiter.length());
+          opNum++;
+        }
+        return true; 
+      }
+      return false;
+    }
+    
+  bool 
+    regex_instructions::isMemory(std::string const inst, inst_text_t & text, decoded_instruction_t * decInst) {
+      for (size_t i = 0; i < NUM_OF_INST(memInsts); i++) {
+        std::regex search_exp(memRegex[i], std::regex_constants::ECMAScript);
+        std::smatch matches;
+        if (std::regex_search(inst.begin(), inst.end(), matches, search_exp)) {
+          if (memInsts[i].num_op == 0) {
+            text = {matches[1], "" , "", ""};
+            *decInst = decoded_instruction_t(MEMORY_INST, memInsts[i].opcode, &text);
+          } else if (memInsts[i].num_op == 1) {
+            text = {matches[1], matches[2] , "", ""};
+            *decInst = decoded_instruction_t(MEMORY_INST, memInsts[i].opcode, &text);
+          } else if (memInsts[i].num_op == 2) {
+            text = {matches[1], matches[2] , matches[3], ""};
+            *decInst = decoded_instruction_t(MEMORY_INST, memInsts[i].opcode, &text);
+          } else if (memInsts[i].num_op == 3) {
+            text = {matches[1], matches[2] , matches[3], matches[4]};
+            *decInst = decoded_instruction_t(MEMORY_INST, memInsts[i].opcode, &text);
+          } else {
+            SCMULATE_ERROR(0, "Unsupported number of operands for MEMORY_INST instruction");
+          }
+          decInst->setOpIO(memInsts[i].op_in_out);
+          return true; 
+        }
+      }
+      return false;
+    }
+
+
+}
+
+#endif
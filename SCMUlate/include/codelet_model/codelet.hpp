@@ -22,6 +22,10 @@ namespace scm {
       codelet () : params(nullptr) {};
       codelet (uint32_t nparms, void * params, std::uint_fast16_t opIO): numParams(nparms), params(params), op_in_out(opIO) {};
       virtual void implementation() = 0;
+      /** \brief new codelet of the same kind that works on other parameters 
+       *  Used when the registers of an instruction are renamed
+       */
+      virtual codelet * clone(void * parms) = 0;
       inline void * getParams() { return this->params; };
       inline std::uint_fast16_t& getOpIO() { return op_in_out; };
       inline void setExecutor (cu_executor_module * exec) {this->myExecutor = exec;}
@@ -36,6 +40,7 @@ namespace scm {
     public:
       static std::map <std::string, creatorFnc> *registeredCodelets;
       static void registerCreator(std::string name, creatorFnc fnc);
+      static creatorFnc getCreator(std::string name);
       static codelet* createCodelet(std::string name, void * usedParams);
   };
 }
@@ -63,6 +68,7 @@ namespace scm {
       \
       /* Implementation function */ \
       virtual void implementation(); \
+      virtual codelet * clone(void * parms) { return new COD_CLASS_NAME(name)(parms); } \
       \
       /* destructor */ \
       ~COD_CLASS_NAME(name)() {} \
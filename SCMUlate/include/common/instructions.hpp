@@ -2,23 +2,22 @@
 #define __INSTRUCTIONS__
 
 /**
- * This file contains all the definitions of the regular expressions that allow to identify 
- * an instruction and its operands. It also defines the enum with the different instruction types
- * that is used by the SCM machine during fetch_decode of the program
+ * This file defines the scm::instructions class that contains static methods that can be used
+ * to identify the type of an instruction, as well as to extract the operands of the instruction.
+ * The supported instructions are defined in instructions_def.hpp
  *
- * This file also defines the scm::instructions class that contains static methods that can be used
- * to identify the type of an instruction, as well as to extract the operands of the instruction
- *
- * The purpose of this file is to separate the definiton of the supported instructions
- * from the fetch_decode operation, as well as the instruction meomry operation
- *
- * TODO: This file should be replace by some sort of parser, but for now I have not definied the 
- * language correctly, and I am no front end expert, so this will have to do until then. 
+ * Lines are decoded by a small hand written lexer (inst_lexer) in a single pass, using the 
+ * operand formats of each instruction definition:
+ *   - Registers are R<size>_<number>, e.g. R64B_1 or R2048L_3
+ *   - Immediates are [-]?[0-9]+
+ *   - Labels are [a-zA-Z0-9_]+, a label line is "label:"
+ *   - Instructions end with ';', and "//" starts a comment
  *
  */
 
 #include <string>
-#include <regex>
+#include <string_view>
+#include <type_traits>
 #include <iostream>
 #include "codelet.hpp"
 #include "SCMUlate_tools.hpp"
@@ -28,6 +27,18 @@
 
 
 namespace scm {
+  /** \brief Source text of a decoded instruction
+   *
+   *  The text is only needed to decode the operands, for debugging and for messages, so it is
+   *  kept in a side table (see inst_mem_module) instead of inside the decoded_instruction_t
+   */
+  struct inst_text_t {
+    std::string instruction;
+    std::string op1_s;
+    std::string op2_s;
+    std::string op3_s;
+  };
+
   class decoded_instruction_t {
     private:
       /** \brief contains the break down of an instruction
@@ -35,39 +46,64 @@ namespace scm {
        * innitially we use only 3 address instructions. If it contains 2 or 1 operands the other 
        * are ignored by the fetch_decode
        *
+       * It is a fixed size record with everything the machine needs to execute the instruction,
+       * (opcode, operands, register pointers and immediate values) so the instruction memory is a flat
+       * array of them, and it can be copied as plain memory. The source text is only referenced. 
+       * The codelet of an EXECUTE_INST is owned by whoever owns the record (e.g. the inst_mem_module),
+       * see releaseCodelet()
+       *
        */
       instType type;
-      std::string instruction;
-      std::string op1_s;
-      std::string op2_s;
-      std::string op3_s;
-      std::uint_fast16_t op_in_out;
-      codelet * cod_exec;
+      opcode_t opcode;
+      std::uint16_t op_in_out;
       operand_t op1;
       operand_t op2;
       operand_t op3;
+      codelet * cod_exec;
+      inst_text_t * text;
+
+      static inline const std::string & noText() {
+        static const std::string empty("");
+        return empty;
+      }
 
    public:
       // Constructors
-      decoded_instruction_t (instType type) :
-        type(type), instruction(""), op1_s(""), op2_s(""), op3_s(""), op_in_out(OP_IO::NO_RD_WR), cod_exec(nullptr), op1(), op2(), op3() {}
-      decoded_instruction_t (instType type, std::string inst, std::string op1s, std::string op2s, std::string op3s) :
-        type(type), instruction(inst), op1_s(op1s), op2_s(op2s), op3_s(op3s), op_in_out(OP_IO::NO_RD_WR), cod_exec(nullptr), op1(), op2(), op3()  {}
+      decoded_instruction_t (instType type = UNKNOWN, inst_text_t * text = nullptr) :
+        type(type), opcode(defaultOpcode(type)), op_in_out(OP_IO::NO_RD_WR), op1(), op2(), op3(), cod_exec(nullptr), text(text) {}
+      decoded_instruction_t (instType type, opcode_t opc, inst_text_t * text) :
+        type(type), opcode(opc), op_in_out(OP_IO::NO_RD_WR), op1(), op2(), op3(), cod_exec(nullptr), text(text) {}
+
+      /** \brief opcode of the instructions types that do not have a definitions group
+       */
+      static inline opcode_t defaultOpcode(instType type) {
+        return type == COMMIT ? OPC_COMMIT : (type == EXECUTE_INST ? OPC_CODELET : OPC_UNKNOWN);
+      }
 
       // Getters and setters
       /** \brief get the instruction type
        *  \sa istType
        */
       inline instType& getType() { return type; }
+      /** \brief get the instruction opcode
+       *  \sa opcode_t
+       */
+      inline opcode_t getOpcode() { return opcode; }
       /** \brief get the instruction name
        */
-      inline std::string getInstruction() { return instruction; }
+      inline const std::string & getInstruction() { return text ? text->instruction : noText(); }
       /** \brief get Codelet
        */
       inline codelet * getExecCodelet() { return cod_exec; }
-      /** \brief set the instruction name
+      /** \brief set the codelet of an EXECUTE_INST. The caller keeps its ownership
+       */
+      inline void setExecCodelet(codelet * newCod) { cod_exec = newCod; }
+      /** \brief get the source text of the instruction. It may be nullptr
        */
-      inline void setInstruction(std::string newInstName) { instruction = newInstName; }
+      inline inst_text_t * getText() { return text; }
+      /** \brief set the source text of the instruction
+       */
+      inline void setText(inst_text_t * newText) { text = newText; }
       /** \brief set the op_in_out name
        */
       inline void setOpIO(std::uint_fast16_t opIO) { op_in_out = opIO; }
@@ -94,37 +130,145 @@ namespace scm {
       inline operand_t& getOp3() { return op3; }
       /** \brief get the op1_s
        */
-      inline std::string getOp1Str() { return op1_s; }
+      inline const std::string & getOp1Str() { return text ? text->op1_s : noText(); }
       /** \brief get the op2_s
        */
-      inline std::string getOp2Str() { return op2_s; }
+      inline const std::string & getOp2Str() { return text ? text->op2_s : noText(); }
       /** \brief get the op3_s
        */
-      inline std::string getOp3Str() { return op3_s; }
-      /** \brief set the op1_s 
-       */
-      inline void setOp1Str(std::string str) { op1_s = str; }
-      /** \brief set the op2_s
-       */
-      inline void setOp2Str(std::string str) { op2_s = str; }
-      /** \brief set the op3_s
+      inline const std::string & getOp3Str() { return text ? text->op3_s : noText(); }
+
+      /** \brief decode the operands strings into registers and immediate values
+       *  \param reg_file_m register file used to resolve the registers
+       *  \param createCodelet if false, the codelet of an EXECUTE_INST is not created (e.g. to only assemble the program)
+       *  \returns false if an operand or the codelet could not be decoded
        */
-      inline void setOp3Str(std::string str) { op3_s = str; }
+      bool decodeOperands(reg_file_module * const reg_file_m, bool createCodelet = true);
 
-      bool decodeOperands(reg_file_module * const reg_file_m);
+      /** \brief create the codelet of an EXECUTE_INST
+       *  The operands must have been decoded already. They are passed as the parameters of the codelet
+       *  \param creator the creator function of the codelet obtained from the codeletFactory
+       *  \returns false if the codelet could not be created
+       */
+      bool bindCodelet(creatorFnc creator);
 
-      ~decoded_instruction_t() {
-        if (type == EXECUTE_INST) {
+      /** \brief delete the codelet of an EXECUTE_INST and its parameters
+       *  Records are plain memory, so the owner of the record must call this once
+       */
+      inline void releaseCodelet() {
+        if (type == EXECUTE_INST && cod_exec) {
           // TODO depending on the type this to change the casting
           unsigned char ** params = reinterpret_cast<unsigned char **> (cod_exec->getParams());
           delete[] params;
           delete cod_exec;
+          cod_exec = nullptr;
         }
       }
   };
 
+  // The SU fetches one record per instruction, it should not span more than two cache lines
+  static_assert(sizeof(decoded_instruction_t) <= 2*CACHE_LINE_SIZE, "decoded_instruction_t must fit in two cache lines");
+  static_assert(std::is_trivially_copyable<decoded_instruction_t>::value, "decoded_instruction_t must be a plain record");
+
+  /** \brief Scanner for a single line of the SCM language
+   *
+   *  The lexer works on a view of the line, so it never copies or allocates while
+   *  it classifies the line and splits it in tokens. Tokens are returned as views
+   *  into the original line, therefore the line must outlive the lexer and its tokens.
+   *
+   *  The accepted syntax is described at the top of this file
+   */
+  class inst_lexer {
+    private:
+      std::string_view line;
+      size_t pos;
+
+    public:
+      inst_lexer(std::string_view l) : line(l), pos(0) {}
+
+      static inline bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+      static inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+      static inline bool isIdentChar(char c) { return isDigit(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_'; }
+
+      /** \brief skip the blank characters at the current position
+       *  \returns true if at least one blank character was skipped
+       */
+      inline bool skipSpaces() {
+        size_t start = pos;
+        while (pos < line.size() && isSpace(line[pos])) pos++;
+        return pos != start;
+      }
+
+      /** \brief check if there is nothing but blank characters left
+       */
+      inline bool atEnd() { skipSpaces(); return pos >= line.size(); }
+
+      /** \brief check if the remainder of the line starts with the given text
+       */
+      inline bool startsWith(std::string_view text) { skipSpaces(); return line.substr(pos, text.size()) == text; }
+
+      /** \brief consume a single character if it is the next non blank one
+       *  \returns true if the character was found and consumed
+       */
+      inline bool consume(char c) {
+        skipSpaces();
+        if (pos < line.size() && line[pos] == c) {
+          pos++;
+          return true;
+        }
+        return false;
+      }
+
+      /** \brief consume an identifier ([a-zA-Z0-9_]+)
+       *  \returns the identifier or an empty view if there is none
+       */
+      inline std::string_view identifier() {
+        skipSpaces();
+        size_t start = pos;
+        while (pos < line.size() && isIdentChar(line[pos])) pos++;
+        return line.substr(start, pos - start);
+      }
+
+      /** \brief consume an operand token. Either an identifier or a possibly negative number
+       *  \returns the operand or an empty view if there is none
+       */
+      inline std::string_view operand() {
+        skipSpaces();
+        size_t start = pos;
+        if (pos < line.size() && line[pos] == '-') pos++;
+        while (pos < line.size() && isIdentChar(line[pos])) pos++;
+        return line.substr(start, pos - start);
+      }
+  };
+
   class instructions {
     private:
+      /** \brief Find the definition of an instruction by name in one of the groups
+       *  \returns the definition or nullptr if the name is not part of the group
+       */
+      template <size_t N>
+      static inline const inst_def_t * findDef(const inst_def_t (&group)[N], std::string_view name) {
+        for (size_t i = 0; i < N; i++)
+          if (group[i].inst_name == name)
+            return &group[i];
+        return nullptr;
+      }
+
+      /** \brief Parse the operands of an instruction according to its definition
+       *  \param lex lexer positioned after the instruction name
+       *  \param def definition of the instruction that contains the operand formats
+       *  \param ops where to store the operands
+       *  \returns true if the operands and the final ';' match the definition
+       */
+      static inline bool parseOperands(inst_lexer & lex, const inst_def_t & def, std::string_view (&ops)[3]);
+
+      /** \brief Does the operand token satisfy the format
+       */
+      static inline bool matchesFormat(std::string_view op, std::uint_fast8_t fmt);
+
+      /** \brief Build the decoded instruction of one of the instruction groups
+       */
+      static inline decoded_instruction_t buildDecoded(instType type, const inst_def_t & def, std::string_view (&ops)[3], inst_text_t & text);
 
     public:
       /** \brief Helper instructions class for the identification of the instructions
@@ -136,262 +280,249 @@ namespace scm {
 
       /** \brief Find the instruction type
        *  \param inst the corresponding instruction text to identify
-       *  \returns the instType with the corresponding type
+       *  \param text where to store the source text of the instruction. The decoded instruction references it
+       *  \returns the decoded instruction with the corresponding type
        *  \sa instType
        */
-      static inline decoded_instruction_t* findInstType(std::string const inst);
+      static inline decoded_instruction_t findInstType(std::string_view const inst, inst_text_t & text);
 
       /** \brief Is the instruction type COMMENT
        *  \param inst the corresponding instruction text to identify
        *  \returns true or false if the instruction is COMMENT type
        */
-      static inline bool isComment(std::string const inst);
+      static inline bool isComment(std::string_view const inst);
 
       /** \brief Is the instruction type LABEL
        *  \param inst the corresponding instruction text to identify
        *  \returns true or false if the instruction is LABEL type
        */
-      static inline bool isLabel(std::string const inst);
-
-      /** \brief Is the instruction type COMMIT
-       *  \param inst the corresponding instruction text to identify
-       *  \returns true or false if the instruction is COMMIT type
-       */
-      static inline bool isCommit(std::string const inst, decoded_instruction_t ** decInst);
+      static inline bool isLabel(std::string_view const inst);
 
-      /** \brief Obtain name and size of register
+      /** \brief Obtain size class and number of register
        *  \param op the operand that contains the enconded register
-       *  \returns a decoded_reg_t that contains name and value separately
+       *  \returns a decoded_reg_t that contains size class and number separately. The size class
+       *  is reg_file_module::NUM_REG_SIZE_CLASSES if the register is not valid. The ID depends on 
+       *  the register file, it is NO_REG_ID
        *  \sa decoded_reg_t
        */
-      static inline decoded_reg_t decodeRegister(std::string const op);
+      static inline decoded_reg_t decodeRegister(std::string_view const op);
 
       /** \brief Is the operand a register type or inmediate value
        *  \param op the operand that we want to check
        *  \returns true if the operand encodes a register, false otherwise 
        */
-      static inline bool isRegister(std::string const op);
+      static inline bool isRegister(std::string_view const op);
 
-      /** \brief Is the instruction type CONTROL_INST
-       *  \param inst the corresponding instruction text to identify
-       *  \returns true or false if the instruction is CONTROL type
-       *  \sa instType
+      /** \brief Is the operand an inmediate value
+       *  \param op the operand that we want to check
+       *  \returns true if the operand encodes a number, false otherwise 
        */
-      static inline bool isControlInst(std::string const inst, decoded_instruction_t ** decInst);
+      static inline bool isImmediate(std::string_view const op);
 
-      /** \brief Is the instruction type BASIC_ARITH_INST
-       *  \param inst the corresponding instruction text to identify
-       *  \returns true or false if the instruction is CONTROL type
-       *  \sa instType
+      /** \brief Get the definitions of the group that corresponds to the instruction type
+       *  \param type CONTROL_INST, BASIC_ARITH_INST or MEMORY_INST
+       *  \param size where the number of definitions of the group is stored
+       *  \returns the group or nullptr if the type has no definitions group
        */
-      static inline bool isBasicArith(std::string const inst, decoded_instruction_t ** decInst);
+      static inline const inst_def_t * getDefGroup(instType type, size_t & size);
 
-      /** \brief Is the instruction type EXECUTE_INST
-       *  \param inst the corresponding instruction text to identify
-       *  \returns true or false if the instruction is CONTROL type
-       *  \sa instType
-       */
-      static inline bool isExecution(std::string const inst, decoded_instruction_t ** decInst);
-      
-      /** \brief Is the instruction type MEMORY_INST
-       *  \param inst the corresponding instruction text to identify
-       *  \returns true or false if the instruction is CONTROL type
-       *  \sa instType
+      /** \brief Get the definition of an instruction from its opcode
+       *  \returns the definition or nullptr if the opcode does not have a definition in the groups
        */
-      static inline bool isMemory(std::string const ints, decoded_instruction_t ** decInst);
+      static inline const inst_def_t * getDef(opcode_t opcode);
 
       /** \brief extract the label from the instruction name
        *  \param inst the corresponding instruction text to extract the label from
        *  \returns the label in a string
        *  \se isLabel
        */
-      static inline std::string getLabel(std::string const inst);
+      static inline std::string getLabel(std::string_view const inst);
 
   };
 
-  decoded_instruction_t *
-    instructions::findInstType(std::string const instruction) {
-      decoded_instruction_t* dec = NULL;
-      isCommit(instruction, &dec);
-      if (!dec) isControlInst(instruction, &dec);
-      if (!dec) isBasicArith(instruction, &dec);
-      if (!dec) isExecution(instruction, &dec);
-      if (!dec) isMemory(instruction, &dec);
-      if (!dec) dec = new decoded_instruction_t(UNKNOWN);
-
-      SCMULATE_INFOMSG(4, "decoded: {type = %d, opcode = %s, op1 = %s, op2 = %s, op3 = %s}, ", dec->getType(), dec->getInstruction().c_str(), dec->getOp1Str().c_str(), dec->getOp2Str().c_str(), dec->getOp3Str().c_str());
-      
+  decoded_instruction_t
+    instructions::findInstType(std::string_view const instruction, inst_text_t & text) {
+      decoded_instruction_t dec(UNKNOWN, &text);
+      text = inst_text_t();
+      inst_lexer lex(instruction);
+      std::string_view name = lex.identifier();
+      std::string_view ops[3];
+      const inst_def_t * def = nullptr;
+
+      if (name == "COMMIT") {
+        // COMMIT;
+        if (lex.consume(';')) {
+          text.instruction = "COMMIT";
+          dec = decoded_instruction_t(COMMIT, &text);
+        }
+      } else if (name == "COD") {
+        // COD codelet_name arg1, arg2, arg3;
+        bool hasSpace = lex.skipSpaces();
+        std::string_view codName = lex.identifier();
+        if (hasSpace && codName.size() != 0 && (lex.skipSpaces() || lex.startsWith(";"))) {
+          size_t opNum = 0;
+          bool correct = true;
+          while (!lex.consume(';')) {
+            std::string_view token = lex.identifier();
+            if (token.size() == 0 && !lex.startsWith(",")) {
+              correct = false;
+              break;
+            }
+            if (opNum < 3)
+              ops[opNum] = token;
+            else if (opNum == 3)
+              SCMULATE_ERROR(0, "Unsupported number of operands for EXECUTE_INST instruction");
+            opNum++;
+            lex.consume(',');
+          }
+          if (correct) {
+            text = {std::string(codName), std::string(ops[0]), std::string(ops[1]), std::string(ops[2])};
+            dec = decoded_instruction_t(EXECUTE_INST, &text);
+          }
+        }
+      } else if ((def = findDef(controlInsts, name))) {
+        if (parseOperands(lex, *def, ops)) dec = buildDecoded(CONTROL_INST, *def, ops, text);
+      } else if ((def = findDef(basicArithInsts, name))) {
+        if (parseOperands(lex, *def, ops)) dec = buildDecoded(BASIC_ARITH_INST, *def, ops, text);
+      } else if ((def = findDef(memInsts, name))) {
+        if (parseOperands(lex, *def, ops)) dec = buildDecoded(MEMORY_INST, *def, ops, text);
+      }
+      SCMULATE_INFOMSG(4, "decoded: {type = %d, opcode = %s, op1 = %s, op2 = %s, op3 = %s}, ", dec.getType(), dec.getInstruction().c_str(), dec.getOp1Str().c_str(), dec.getOp2Str().c_str(), dec.getOp3Str().c_str());
 
       return dec;
     }
 
-  bool 
-    instructions::isCommit(std::string const inst, decoded_instruction_t ** decInst) {
-      std::regex search_exp(COMMIT_INST.inst_regex, std::regex_constants::ECMAScript);
-      std::smatch matches;
-      if (std::regex_search(inst.begin(), inst.end(), matches, search_exp)) {
-        *decInst = new decoded_instruction_t(COMMIT);
-        return true;
+  bool
+    instructions::parseOperands(inst_lexer & lex, const inst_def_t & def, std::string_view (&ops)[3]) {
+      if (def.num_op < 0 || def.num_op > 3)
+        return false;
+      // At least one space between the instruction name and its operands
+      if (def.num_op != 0 && !lex.skipSpaces())
+        return false;
+      for (int i = 0; i < def.num_op; i++) {
+        if (i != 0 && !lex.consume(','))
+          return false;
+        ops[i] = lex.operand();
+        if (!matchesFormat(ops[i], def.op_fmt[i]))
+          return false;
       }
-      decInst = NULL;
-      return false;
+      return lex.consume(';');
     }
 
-  bool 
-    instructions::isRegister(std::string const op) {
-      std::regex search_exp(REGISTER_REGEX, std::regex_constants::ECMAScript);
-      if (std::regex_match(op, search_exp))
+  bool
+    instructions::matchesFormat(std::string_view op, std::uint_fast8_t fmt) {
+      if (op.size() == 0)
+        return false;
+      if ((fmt & OP_FMT::REG) && isRegister(op))
         return true;
-      return false;
-    }
-
-  bool 
-    instructions::isComment(std::string const inst) {
-      std::regex search_exp(COMMENT_REGEX, std::regex_constants::ECMAScript);
-      if (std::regex_match(inst, search_exp))
+      if ((fmt & OP_FMT::IMM) && isImmediate(op))
+        return true;
+      if ((fmt & OP_FMT::LBL) && op[0] != '-')
         return true;
       return false;
     }
 
-  bool 
-    instructions::isLabel(std::string const inst) {
-      std::regex search_exp(LABEL_INST.inst_regex, std::regex_constants::ECMAScript);
-      if (std::regex_match(inst, search_exp))
-        return true;
-      return false;
+  decoded_instruction_t
+    instructions::buildDecoded(instType type, const inst_def_t & def, std::string_view (&ops)[3], inst_text_t & text) {
+      text = {def.inst_name, std::string(ops[0]), std::string(ops[1]), std::string(ops[2])};
+      decoded_instruction_t dec(type, def.opcode, &text);
+      dec.setOpIO(def.op_in_out);
+      return dec;
     }
 
-  decoded_reg_t
-    instructions::decodeRegister(std::string const op) {
-      std::regex search_exp(REGISTER_SPLIT_REGEX, std::regex_constants::ECMAScript);
-      std::smatch matches;
-      decoded_reg_t res(op, std::string(""), 0, 0, nullptr);
-      if (std::regex_search(op.begin(), op.end(), matches, search_exp)) {
-         res.reg_size = matches[1];
-         res.reg_number = std::stoi(matches[2]);
+  const inst_def_t *
+    instructions::getDefGroup(instType type, size_t & size) {
+      switch (type) {
+        case CONTROL_INST:
+          size = NUM_OF_INST(controlInsts);
+          return controlInsts;
+        case BASIC_ARITH_INST:
+          size = NUM_OF_INST(basicArithInsts);
+          return basicArithInsts;
+        case MEMORY_INST:
+          size = NUM_OF_INST(memInsts);
+          return memInsts;
+        default:
+          size = 0;
+          return nullptr;
       }
-      return res;
     }
 
-  std::string
-    instructions::getLabel(std::string const inst) {
-      std::regex search_exp(LABEL_INST.inst_regex, std::regex_constants::ECMAScript);
-      std::smatch matches;
-      if (std::regex_search(inst.begin(), inst.end(), matches, search_exp)) {
-        return matches[1];
+  const inst_def_t *
+    instructions::getDef(opcode_t opcode) {
+      const instType types[] = {CONTROL_INST, BASIC_ARITH_INST, MEMORY_INST};
+      for (instType type : types) {
+        size_t size = 0;
+        const inst_def_t * group = getDefGroup(type, size);
+        for (size_t i = 0; i < size; i++)
+          if (group[i].opcode == opcode)
+            return &group[i];
       }
-      return "";
+      return nullptr;
     }
 
   bool 
-    instructions::isControlInst(std::string const inst, decoded_instruction_t ** decInst) {
-      for (size_t i = 0; i < NUM_OF_INST(controlInsts); i++) {
-        std::regex search_exp(controlInsts[i].inst_regex, std::regex_constants::ECMAScript);
-        std::smatch matches;
-        if (std::regex_search(inst.begin(), inst.end(), matches, search_exp)) {
-          if (controlInsts[i].num_op == 0) {
-            *decInst = new decoded_instruction_t(CONTROL_INST, matches[1], "" , "", "");
-          } else if (controlInsts[i].num_op == 1) {
-            *decInst = new decoded_instruction_t(CONTROL_INST, matches[1], matches[2] , "", "");
-          } else if (controlInsts[i].num_op == 2) {
-            *decInst = new decoded_instruction_t(CONTROL_INST, matches[1], matches[2] , matches[3], "");
-          } else if (controlInsts[i].num_op == 3) {
-            *decInst = new decoded_instruction_t(CONTROL_INST, matches[1], matches[2] , matches[3], matches[4]);
-          } else {
-            SCMULATE_ERROR(0, "Unsupported number of operands for CONTROL instruction");
-          }
-          (*decInst)->setOpIO(controlInsts[i].op_in_out);
-          return true; 
-        }
+    instructions::isRegister(std::string_view const op) {
+      // R[BbLl0-9_]+
+      if (op.size() < 2 || op[0] != 'R')
+        return false;
+      for (size_t i = 1; i < op.size(); i++) {
+        char c = op[i];
+        if (!inst_lexer::isDigit(c) && c != 'B' && c != 'b' && c != 'L' && c != 'l' && c != '_')
+          return false;
       }
-      decInst = NULL;
-      return false;
+      return true;
     }
 
   bool 
-    instructions::isBasicArith(std::string const inst, decoded_instruction_t ** decInst) {
-      for (size_t i = 0; i < NUM_OF_INST(basicArithInsts); i++) {
-        std::regex search_exp(basicArithInsts[i].inst_regex, std::regex_constants::ECMAScript);
-        std::smatch matches;
-        if (std::regex_search(inst.begin(), inst.end(), matches, search_exp)) {
-          if (basicArithInsts[i].num_op == 0) {
-            *decInst = new decoded_instruction_t(BASIC_ARITH_INST, matches[1], "" , "", "");
-          } else if (basicArithInsts[i].num_op == 1) {
-            *decInst = new decoded_instruction_t(BASIC_ARITH_INST, matches[1], matches[2] , "", "");
-          } else if (basicArithInsts[i].num_op == 2) {
-            *decInst = new decoded_instruction_t(BASIC_ARITH_INST, matches[1], matches[2] , matches[3], "");
-          } else if (basicArithInsts[i].num_op == 3) {
-            *decInst = new decoded_instruction_t(BASIC_ARITH_INST, matches[1], matches[2] , matches[3], matches[4]);
-          } else {
-            SCMULATE_ERROR(0, "Unsupported number of operands for BASIC_ARITH_INST instruction");
-          }
-          (*decInst)->setOpIO(basicArithInsts[i].op_in_out);
-          return true; 
-        }
-      }
-      decInst = NULL;
-      return false;
+    instructions::isImmediate(std::string_view const op) {
+      // [-]?[0-9]+
+      size_t i = (op.size() != 0 && op[0] == '-') ? 1 : 0;
+      if (i == op.size())
+        return false;
+      for (; i < op.size(); i++)
+        if (!inst_lexer::isDigit(op[i]))
+          return false;
+      return true;
     }
 
   bool 
-    instructions::isExecution(std::string const inst, decoded_instruction_t ** decInst) {
-      std::regex search_exp(CODELET_INST.inst_regex, std::regex_constants::ECMAScript);
-      std::smatch matches;
-      if (std::regex_search(inst.begin(), inst.end(), matches, search_exp)) {
-        std::string operands = matches[2];
-        std::string delimiter = ",";
-        size_t pos = 0;
-        size_t opNum = 0;
-        std::string token;
-        *decInst = new decoded_instruction_t(EXECUTE_INST);
-        (*decInst)->setInstruction(matches[1]);
-        while (operands.length() != 0) {
-          pos = operands.find(delimiter);
-          if (pos == std::string::npos) pos = operands.length();
-          token = operands.substr(0, pos);
-          token = trim(token);
-          if (opNum == 0) {
-            (*decInst)->setOp1Str(token);
-          } else if (opNum == 1) {
-            (*decInst)->setOp2Str(token);
-          } else if (opNum == 2) {
-            (*decInst)->setOp3Str(token);
-          } else {
-            SCMULATE_ERROR(0, "Unsupported number of operands for EXECUTE_INST instruction");
-            break;
-          }
-          operands.erase(0, pos + delimiter.length());
-          opNum++;
-        }
-        return true; 
-      }
-      decInst = NULL;
-      return false;
+    instructions::isComment(std::string_view const inst) {
+      inst_lexer lex(inst);
+      return lex.startsWith("//");
     }
-    
+
   bool 
-    instructions::isMemory(std::string const inst, decoded_instruction_t ** decInst) {
-      for (size_t i = 0; i < NUM_OF_INST(memInsts); i++) {
-        std::regex search_exp(memInsts[i].inst_regex, std::regex_constants::ECMAScript);
-        std::smatch matches;
-        if (std::regex_search(inst.begin(), inst.end(), matches, search_exp)) {
-          if (memInsts[i].num_op == 0) {
-            *decInst = new decoded_instruction_t(MEMORY_INST, matches[1], "" , "", "");
-          } else if (memInsts[i].num_op == 1) {
-            *decInst = new decoded_instruction_t(MEMORY_INST, matches[1], matches[2] , "", "");
-          } else if (memInsts[i].num_op == 2) {
-            *decInst = new decoded_instruction_t(MEMORY_INST, matches[1], matches[2] , matches[3], "");
-          } else if (memInsts[i].num_op == 3) {
-            *decInst = new decoded_instruction_t(MEMORY_INST, matches[1], matches[2] , matches[3], matches[4]);
-          } else {
-            SCMULATE_ERROR(0, "Unsupported number of operands for MEMORY_INST instruction");
-          }
-          (*decInst)->setOpIO(memInsts[i].op_in_out);
-          return true; 
-        }
+    instructions::isLabel(std::string_view const inst) {
+      inst_lexer lex(inst);
+      return lex.identifier().size() != 0 && lex.consume(':');
+    }
+
+  decoded_reg_t
+    instructions::decodeRegister(std::string_view const op) {
+      // R([BbLl0-9]+)_([0-9]+)
+      decoded_reg_t res(reg_file_module::NUM_REG_SIZE_CLASSES, 0, 0, decoded_reg_t::NO_REG_ID, nullptr);
+      size_t split = op.find('_');
+      if (op.size() < 4 || op[0] != 'R' || split == std::string_view::npos || split == 1 || split + 1 == op.size())
+        return res;
+      uint32_t number = 0;
+      for (size_t i = split + 1; i < op.size(); i++) {
+        if (!inst_lexer::isDigit(op[i]))
+          return res;
+        number = number * 10 + (op[i] - '0');
       }
-      decInst = NULL;
-      return false;
+      res.reg_size_class = reg_file_module::getRegisterSizeClass(op.substr(1, split - 1));
+      res.reg_number = number;
+      return res;
+    }
+
+  std::string
+    instructions::getLabel(std::string_view const inst) {
+      inst_lexer lex(inst);
+      std::string_view label = lex.identifier();
+      if (label.size() != 0 && lex.consume(':'))
+        return std::string(label);
+      return "";
     }
 
 }
@@ -3,30 +3,23 @@
 
 
 /**
- * This file contains all the definitions of the regular expressions that allow to identify 
- * an instruction and its operands. It also defines the enum with the different instruction types
- * that is used by the SCM machine during fetch_decode of the program
+ * This file contains the definitions of the supported instructions: their names, opcodes, number
+ * of operands, the format of each operand and which operands are read and written. It also defines
+ * the enum with the different instruction types that is used by the SCM machine during fetch_decode
+ * of the program, and the decoded instruction records.
  *
- * This file also defines the scm::instructions class that contains static methods that can be used
- * to identify the type of an instruction, as well as to extract the operands of the instruction
+ * The scm::instructions class (instructions.hpp) decodes the text of an instruction with a single
+ * pass lexer (inst_lexer) that checks the operands against these definitions.
  *
  * The purpose of this file is to separate the definiton of the supported instructions
  * from the fetch_decode operation, as well as the instruction meomry operation
  *
- * TODO: This file should be replace by some sort of parser, but for now I have not definied the 
- * language correctly, and I am no front end expert, so this will have to do until then. 
- *
  */
 
 #include <string>
+#include <cstdint>
 
-#define REGISTER_REGEX "R[BbLl0-9_]+"
-#define REGISTER_SPLIT_REGEX "R([BbLl0-9]+)_([0-9]+)"
-#define INMIDIATE_REGEX "[-]?[0-9]+"
-#define LABEL_REGEX "([a-zA-Z0-9_]+)"
-#define COMMENT_REGEX "([ ]*//.*)"
-
-#define DEF_INST(name, regExp, numOp, opInOut) {#name, regExp, numOp, opInOut}
+#define DEF_INST(name, numOp, opInOut, ...) {#name, OPC_ ## name, numOp, opInOut, {__VA_ARGS__}}
 #define NUM_OF_INST(a) sizeof(a)/sizeof(inst_def_t)
 
 namespace scm {
@@ -58,68 +51,97 @@ namespace scm {
       static constexpr std::uint_fast16_t OP8_WR { 0b1000'0000'0000'0000 }; // represents bit 16
   };
 
+  /** \brief Opcodes of all the instructions
+   *
+   *  Each instruction definition (DEF_INST) is assigned a dense opcode when it is decoded.
+   *  The machine modules dispatch on the opcode (switch/jump table) instead of comparing 
+   *  the instruction name. OPC_LABEL is a pseudo instruction, it is never placed in the 
+   *  instruction memory. All codelets share OPC_CODELET.
+   *
+   *  When adding an instruction, its opcode must be added here with the same name used in DEF_INST()
+   */
+  enum opcode_t : std::uint8_t {
+    OPC_UNKNOWN,
+    // SCM specific
+    OPC_COMMIT, OPC_LABEL, OPC_CODELET,
+    // Control flow
+    OPC_JMPLBL, OPC_JMPPC, OPC_BREQ, OPC_BGT, OPC_BGET, OPC_BLT, OPC_BLET,
+    // Basic arithmetic
+    OPC_ADD, OPC_SUB, OPC_SHFL, OPC_SHFR, OPC_MULT,
+    // Memory
+    OPC_LDIMM, OPC_LDADR, OPC_LDOFF, OPC_STADR, OPC_STOFF,
+    NUM_OPCODES
+  };
+
+  /** \brief Operands format descriptor bits
+   *
+   *  Describe what kind of token is accepted on each operand position. They are used
+   *  by the instructions lexer to validate an instruction without regular expressions.
+   *  An operand position can accept more than one kind (e.g. REG | IMM)
+   *
+   */
+  class OP_FMT {
+    public:
+      static constexpr std::uint_fast8_t NONE { 0b0000 };
+      static constexpr std::uint_fast8_t REG  { 0b0001 }; // R<size>_<num>
+      static constexpr std::uint_fast8_t IMM  { 0b0010 }; // [-]?[0-9]+
+      static constexpr std::uint_fast8_t LBL  { 0b0100 }; // [a-zA-Z0-9_]+
+      static constexpr std::uint_fast8_t REG_IMM { REG | IMM };
+  };
+
   /** \brief Instruction definition
    *
    *  This struct contains all the information needed for the definition of a instruction 
    *  from the language perspective
    *
    *  To add an instruction you must create it with DEF_INST() and then add it to the vector for 
-   *  the corresponding group
+   *  the corresponding group. The trailing arguments of DEF_INST() are the OP_FMT of each operand,
+   *  which is what the lexer uses to accept or reject the instruction.
    */
   struct inst_def_t {
     std::string inst_name;
-    std::string inst_regex;
+    opcode_t opcode;
     int num_op;
     std::uint_fast16_t op_in_out;
+    std::uint_fast8_t op_fmt[3];
   };
 
   // SCM specific insctructions
-  const inst_def_t COMMIT_INST = DEF_INST(COMMIT, "[ ]*(COMMIT;).*", 0, OP_IO::NO_RD_WR);                                          /* COMMIT; */
-  const inst_def_t LABEL_INST = DEF_INST(LABEL,   "[ ]*([a-zA-Z0-9_]+)[ ]*:.*", 0, OP_IO::NO_RD_WR);                                 /* myLabel: */
-  const inst_def_t CODELET_INST = DEF_INST(CODELET, "[ ]*COD[ ]+([a-zA-Z0-9_]+)[ ]+([a-zA-Z0-9_, ]*);.*", 0, OP_IO::NO_RD_WR);      /* COD codelet_name arg1, arg2, arg3; */
+  const inst_def_t COMMIT_INST = DEF_INST(COMMIT, 0, OP_IO::NO_RD_WR);   /* COMMIT; */
+  const inst_def_t LABEL_INST = DEF_INST(LABEL, 0, OP_IO::NO_RD_WR);     /* myLabel: */
+  const inst_def_t CODELET_INST = DEF_INST(CODELET, 0, OP_IO::NO_RD_WR); /* COD codelet_name arg1, arg2, arg3; */
   
   // CONTROL FLOW INSTRUCTIONS
   /** \brief All the control instructions
-   *
-   * All the different regular expressions used for Control flow instructions.  
-   * each has its own format. This regexp can be used to identify the instruction
-   * or to obtain the parameters
    */
   static inst_def_t const controlInsts[] = {
-    DEF_INST( JMPLBL,  "[ ]*(JMPLBL)[ ]+(" LABEL_REGEX ");.*", 1, OP_IO::NO_RD_WR),                                                   /* JMPLBL destination;*/
-    DEF_INST( JMPPC,   "[ ]*(JMPPC)[ ]+(" INMIDIATE_REGEX ");.*", 1, OP_IO::NO_RD_WR),                                                      /* JMPPC -100;*/
-    DEF_INST( BREQ,    "[ ]*(BREQ)[ ]+(" REGISTER_REGEX ")[ ]*,[ ]*(" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX ");.*", 3, OP_IO::OP1_RD | OP_IO::OP2_RD),            /* BREQ R1, R2, -100; */
-    DEF_INST( BGT,     "[ ]*(BGT)[ ]+(" REGISTER_REGEX ")[ ]*,[ ]*(" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX ");.*", 3, OP_IO::OP1_RD | OP_IO::OP2_RD),             /* BGT R1, R2, -100; */
-    DEF_INST( BGET,    "[ ]*(BGET)[ ]+(" REGISTER_REGEX ")[ ]*,[ ]*(" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX ");.*", 3, OP_IO::OP1_RD | OP_IO::OP2_RD),            /* BGET R1, R2, -100; */
-    DEF_INST( BLT,     "[ ]*(BLT)[ ]+(" REGISTER_REGEX ")[ ]*,[ ]*(" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX ");.*", 3, OP_IO::OP1_RD | OP_IO::OP2_RD),             /* BLT R1, R2, -100; */
-    DEF_INST( BLET,    "[ ]*(BLET)[ ]+(" REGISTER_REGEX ")[ ]*,[ ]*(" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX ");.*", 3, OP_IO::OP1_RD | OP_IO::OP2_RD)};            /* BLET R1, R2, -100; */
+    DEF_INST( JMPLBL,  1, OP_IO::NO_RD_WR, OP_FMT::LBL),                                                   /* JMPLBL destination;*/
+    DEF_INST( JMPPC,   1, OP_IO::NO_RD_WR, OP_FMT::IMM),                                                      /* JMPPC -100;*/
+    DEF_INST( BREQ,    3, OP_IO::OP1_RD | OP_IO::OP2_RD, OP_FMT::REG, OP_FMT::REG, OP_FMT::IMM),            /* BREQ R1, R2, -100; */
+    DEF_INST( BGT,     3, OP_IO::OP1_RD | OP_IO::OP2_RD, OP_FMT::REG, OP_FMT::REG, OP_FMT::IMM),             /* BGT R1, R2, -100; */
+    DEF_INST( BGET,    3, OP_IO::OP1_RD | OP_IO::OP2_RD, OP_FMT::REG, OP_FMT::REG, OP_FMT::IMM),            /* BGET R1, R2, -100; */
+    DEF_INST( BLT,     3, OP_IO::OP1_RD | OP_IO::OP2_RD, OP_FMT::REG, OP_FMT::REG, OP_FMT::IMM),             /* BLT R1, R2, -100; */
+    DEF_INST( BLET,    3, OP_IO::OP1_RD | OP_IO::OP2_RD, OP_FMT::REG, OP_FMT::REG, OP_FMT::IMM)};            /* BLET R1, R2, -100; */
 
   //BASIC ARITHMETIC INSTRUCTIONS
   /** \brief All the basic arithmetic instructions
-   *
-   * All the different regular expressions used for basic arithmetic instructions.  
-   * each has its own format. This regexp can be used to identify the instruction
-   * or to obtain the parameters
    */
   static inst_def_t const basicArithInsts[] = {
-  DEF_INST( ADD,  "[ ]*(ADD)[ ]+(" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX "|" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX "|" REGISTER_REGEX ")[ ]*;.*", 3, OP_IO::OP1_WR | OP_IO::OP2_RD | OP_IO::OP3_RD),     /* ADD R1, R2, R3; R2 and R3 can be literals*/
-  DEF_INST( SUB,  "[ ]*(SUB)[ ]+(" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX "|" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX "|" REGISTER_REGEX ")[ ]*;.*", 3, OP_IO::OP1_WR | OP_IO::OP2_RD | OP_IO::OP3_RD),     /* SUB R1, R2, R3; R2 and R3 can be literals*/
-  DEF_INST( SHFL, "[ ]*(SHFL)[ ]+(" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX "|" REGISTER_REGEX ")[ ]*;.*", 2, OP_IO::OP1_RD | OP_IO::OP1_WR | OP_IO::OP2_RD),                            /* SHFL R1, R2; R2 can be a literal representing how many positions to shift*/
-  DEF_INST( SHFR, "[ ]*(SHFR)[ ]+(" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX "|" REGISTER_REGEX ")[ ]*;.*", 2, OP_IO::OP1_RD | OP_IO::OP1_WR | OP_IO::OP2_RD)};                            /* SHFR R1, R2; R2 can be a literal representing how many positions to shift*/
+  DEF_INST( ADD,  3, OP_IO::OP1_WR | OP_IO::OP2_RD | OP_IO::OP3_RD, OP_FMT::REG, OP_FMT::REG, OP_FMT::REG_IMM),     /* ADD R1, R2, R3; R3 can be a literal*/
+  DEF_INST( SUB,  3, OP_IO::OP1_WR | OP_IO::OP2_RD | OP_IO::OP3_RD, OP_FMT::REG, OP_FMT::REG, OP_FMT::REG_IMM),     /* SUB R1, R2, R3; R3 can be a literal*/
+  DEF_INST( SHFL, 2, OP_IO::OP1_RD | OP_IO::OP1_WR | OP_IO::OP2_RD, OP_FMT::REG, OP_FMT::REG_IMM),                            /* SHFL R1, R2; R2 can be a literal representing how many positions to shift*/
+  DEF_INST( SHFR, 2, OP_IO::OP1_RD | OP_IO::OP1_WR | OP_IO::OP2_RD, OP_FMT::REG, OP_FMT::REG_IMM),                             /* SHFR R1, R2; R2 can be a literal representing how many positions to shift*/
+  DEF_INST( MULT, 3, OP_IO::OP1_WR | OP_IO::OP2_RD | OP_IO::OP3_RD, OP_FMT::REG, OP_FMT::REG, OP_FMT::REG_IMM)};    /* MULT R1, R2, R3; R3 can be a literal. R1 keeps the lower part of the product*/
 
   //MEMORY INSTRUNCTIONS
   /** \brief All the memory related instructions
-   *
-   * All the different regular expressions used for Control flow instructions.  
-   * each has its own format. This regexp can be used to identify the instruction
-   * or to obtain the parameters
    */
   static inst_def_t const memInsts[] = {
-  DEF_INST( LDIMM, "[ ]*(LDIMM)[ ]+(" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX ")[ ]*;.*", 2, OP_IO::OP1_WR),                          /* LDADR R1, R2; R2 can be a literal or the address in a the register*/
-  DEF_INST( LDADR, "[ ]*(LDADR)[ ]+(" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX "|" REGISTER_REGEX ")[ ]*;.*", 2, OP_IO::OP1_WR | OP_IO::OP2_RD),                          /* LDADR R1, R2; R2 can be a literal or the address in a the register*/
-  DEF_INST( LDOFF, "[ ]*(LDOFF)[ ]+(" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX "|" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX "|" REGISTER_REGEX ")[ ]*;.*", 3, OP_IO::OP1_WR | OP_IO::OP2_RD | OP_IO::OP3_RD),  /* LDOFF R1, R2, R3; R1 is the base destination register, R2 is the base address, R3 is the offset. R2 and R3 can be literals */
-  DEF_INST( STADR, "[ ]*(STADR)[ ]+(" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX "|" REGISTER_REGEX ")[ ]*;.*", 2, OP_IO::OP1_WR | OP_IO::OP2_RD),                          /* LDADR R1, R2; R2 can be a literal or the address in a the register*/
-  DEF_INST( STOFF, "[ ]*(STOFF)[ ]+(" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX "|" REGISTER_REGEX ")[ ]*,[ ]*(" INMIDIATE_REGEX "|" REGISTER_REGEX ")[ ]*;.*", 3, OP_IO::OP1_WR | OP_IO::OP2_RD | OP_IO::OP3_RD)};  /* LDOFF R1, R2, R3; R1 is the base destination register, R2 is the base address, R3 is the offset. R2 and R3 can be literals */
+  DEF_INST( LDIMM, 2, OP_IO::OP1_WR, OP_FMT::REG, OP_FMT::IMM),                          /* LDADR R1, R2; R2 can be a literal or the address in a the register*/
+  DEF_INST( LDADR, 2, OP_IO::OP1_WR | OP_IO::OP2_RD, OP_FMT::REG, OP_FMT::REG_IMM),                          /* LDADR R1, R2; R2 can be a literal or the address in a the register*/
+  DEF_INST( LDOFF, 3, OP_IO::OP1_WR | OP_IO::OP2_RD | OP_IO::OP3_RD, OP_FMT::REG, OP_FMT::REG_IMM, OP_FMT::REG_IMM),  /* LDOFF R1, R2, R3; R1 is the base destination register, R2 is the base address, R3 is the offset. R2 and R3 can be literals */
+  DEF_INST( STADR, 2, OP_IO::OP1_RD | OP_IO::OP2_RD, OP_FMT::REG, OP_FMT::REG_IMM),                          /* LDADR R1, R2; R2 can be a literal or the address in a the register*/
+  DEF_INST( STOFF, 3, OP_IO::OP1_RD | OP_IO::OP2_RD | OP_IO::OP3_RD, OP_FMT::REG, OP_FMT::REG_IMM, OP_FMT::REG_IMM)};  /* LDOFF R1, R2, R3; R1 is the base destination register, R2 is the base address, R3 is the offset. R2 and R3 can be literals */
 
   /** \brief Definition of the instruction types 
    *
@@ -130,85 +152,48 @@ namespace scm {
 
   /** \brief Decoded register structure
    *  
-   *  Contains the register name a register size that is taken out of a encoded register
+   *  Contains the size class (see reg_file_module::getRegisterSizeClass) and the number of an encoded 
+   *  register, together with its size in bytes and its location in the register file. It does not keep
+   *  the register name, use reg_file_module::getRegisterSizeName() to print it. reg_id is the dense 
+   *  register ID (see reg_file_module::getRegisterId) used to index the tables of the ILP controller.
+   *  It depends on the geometry of the register file, so it is NO_REG_ID until the register is 
+   *  resolved in one (see decoded_instruction_t::decodeOperands)
    *
    */
   struct decoded_reg_t {
-    std::string reg_name;
-    std::string reg_size;
+    static constexpr uint32_t NO_REG_ID = 0xFFFFFFFF;
+    unsigned char * reg_ptr;
     uint32_t reg_size_bytes;
     uint32_t reg_number;
-    unsigned char * reg_ptr;
+    uint32_t reg_id;
+    uint8_t reg_size_class;
     
     decoded_reg_t():
-      reg_name(""),reg_size(""), reg_size_bytes(0), reg_number(0), reg_ptr(nullptr) { };
-
-    decoded_reg_t(std::string regName, std::string sizeStr, uint32_t sizeBytes, uint32_t regNum, unsigned char * ptr):
-      reg_name(regName), reg_size(sizeStr), reg_size_bytes(sizeBytes), reg_number(regNum), reg_ptr(ptr) { };
-
-    decoded_reg_t(const decoded_reg_t & other) {
-      reg_name = other.reg_name;
-      reg_size = other.reg_size;
-      reg_size_bytes = other.reg_size_bytes;
-      reg_number = other.reg_number;
-      reg_ptr = other.reg_ptr;
-    }
-
-    void operator=(decoded_reg_t const & other) {
-      reg_name = other.reg_name;
-      reg_size = other.reg_size;
-      reg_size_bytes = other.reg_size_bytes;
-      reg_number = other.reg_number;
-      reg_ptr = other.reg_ptr;
-    }
+      reg_ptr(nullptr), reg_size_bytes(0), reg_number(0), reg_id(0), reg_size_class(0) { };
+
+    decoded_reg_t(uint8_t sizeClass, uint32_t sizeBytes, uint32_t regNum, uint32_t regId, unsigned char * ptr):
+      reg_ptr(ptr), reg_size_bytes(sizeBytes), reg_number(regNum), reg_id(regId), reg_size_class(sizeClass) { };
   };
 
   /** \brief Decoded operand structure
    *  
    *  An operand can be either a register or an immediate value, it is enconded in a union and it gets used accordingly 
-   *  depending on the type.
+   *  depending on the type. It is trivially copyable, so decoded instructions can be copied as plain memory
    *   
    *
    */
   struct operand_t {
-    enum {UNKNOWN, REGISTER, IMMEDIATE_VAL} type;
+    enum : uint8_t {UNKNOWN, REGISTER, IMMEDIATE_VAL} type;
+    bool read;
+    bool write;
     union value_t {
-      uint64_t immediate;
+      int64_t immediate;
       decoded_reg_t reg;
       value_t (): reg(){}
-      ~value_t() {};
     };
     value_t value;
-    bool read;
-    bool write;
 
-    operand_t() {
-      type = UNKNOWN;
-    }
-
-    operand_t(operand_t const & other) {
-      type = other.type;
-      if (type == REGISTER)
-        value.reg = other.value.reg;
-      else if (type == IMMEDIATE_VAL)
-        value.immediate = other.value.immediate;
-    }
-
-    operand_t(operand_t && other) {
-      type = other.type;
-      if (type == REGISTER)
-        value.reg = other.value.reg;
-      else if (type == IMMEDIATE_VAL)
-        value.immediate = other.value.immediate;
-    }
-
-    void operator=(operand_t const & other) {
-      type = other.type;
-      if (type == REGISTER)
-        value.reg = other.value.reg;
-      else if (type == IMMEDIATE_VAL)
-        value.immediate = other.value.immediate;
-    }
+    operand_t() : type(UNKNOWN), read(false), write(false) { }
   };
 }
 
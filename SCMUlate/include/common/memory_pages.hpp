@@ -0,0 +1,39 @@
+#ifndef __MEMORY_PAGES__
+#define __MEMORY_PAGES__
+
+/** \brief Large memory of the machine
+ *
+ * The L2 memory and the register file are private anonymous mappings, so their pages
+ * are zero and they are not allocated until they are touched, by the thread that will
+ * use them (first touch). Huge pages are tried first:
+ *  - MAP_HUGETLB pages from the pool of the system (/proc/sys/vm/nr_hugepages). They
+ *    are reserved when the memory is mapped, so the mapping fails if there are not
+ *    enough of them, instead of a SIGBUS when they are touched.
+ *  - Otherwise normal pages aligned to HUGE_PAGE_SIZE with MAP_NORESERVE, and the kernel
+ *    is asked to use transparent huge pages for them (MADV_HUGEPAGE).
+ */
+
+#include "system_config.hpp"
+#include <cstdint>
+
+namespace scm {
+
+  class memory_pages {
+    public:
+      /** \brief map memory aligned to HUGE_PAGE_SIZE
+       *  \param size bytes, a multiple of HUGE_PAGE_SIZE
+       *  \param hugePages try huge pages first, otherwise normal pages
+       *  \param pages kind of pages that were mapped
+       *  \returns the memory, nullptr if it could not be mapped
+       */
+      static void * map(uint64_t size, bool hugePages, PAGE_KINDS & pages);
+      static void unmap(void * memory, uint64_t size);
+      /** \brief size of the pages of a mapping
+       */
+      static uint64_t pageSize(PAGE_KINDS pages);
+      static const char * getName(PAGE_KINDS pages);
+  };
+
+}
+
+#endif // __MEMORY_PAGES__
@@ -0,0 +1,47 @@
+#ifndef __NUMA_PLACEMENT__
+#define __NUMA_PLACEMENT__
+
+/** \brief NUMA placement of the memory of the machine
+ *
+ * The register file and the L2 memory are allocated by one thread, so the OS puts all
+ * their pages in the node of that thread (first touch). In a machine with several nodes
+ * the CUs of the other nodes access them remotely in every LDOFF and STOFF. These
+ * functions set the memory policy of a range of pages with mbind, so they are placed in
+ * the nodes of the CUs when they are first touched, and moved if they were touched before.
+ * The system calls are used directly, so libnuma is not needed.
+ */
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace scm {
+
+  class numa_placement {
+    public:
+      /** \brief node of each CPU, -1 if unknown
+       */
+      static const std::vector<int> & cpuNodes();
+      /** \brief node of a CPU, -1 if unknown
+       */
+      static int nodeOfCPU(int cpu);
+      /** \brief nodes with memory in the system
+       */
+      static std::vector<int> memoryNodes();
+
+      /** \brief interleave the pages of a range between nodes
+       *  \returns false if the policy could not be set
+       */
+      static bool interleave(void * addr, size_t len, const std::vector<int> & nodes);
+      /** \brief place the pages of a range in a node
+       *  \returns false if the policy could not be set
+       */
+      static bool bind(void * addr, size_t len, int node);
+      /** \brief node of the page of an address, -1 if it is not in memory yet or unknown
+       */
+      static int nodeOfAddress(const void * addr);
+  };
+
+}
+
+#endif // __NUMA_PLACEMENT__
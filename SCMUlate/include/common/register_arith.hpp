@@ -0,0 +1,276 @@
+#ifndef __REGISTER_ARITH__
+#define __REGISTER_ARITH__
+
+/** \brief Multi-precision arithmetic on the registers
+ *
+ * The registers are unsigned big-endian numbers, and their sizes are multiples of 8 bytes.
+ * The arithmetic is done in 64-bit limbs instead of bytes: limb 0 is the last 8 bytes of
+ * the register, it is loaded and byte swapped to a native uint64_t, and the carry goes
+ * from each limb to the next one (_addcarry_u64 and _subborrow_u64 in x86). An R64B is a
+ * single limb, so it is one native add or sub.
+ *
+ * A source that is smaller than the destination is extended with zeros. The immediate
+ * values are signed, adding a negative immediate subtracts its magnitude.
+ *
+ * The shifts move whole limbs and then the bits inside them, in place. MULT keeps the
+ * lower part of the product that fits in the destination. It is schoolbook for small
+ * operands, and Karatsuba when both operands have KARATSUBA_LIMBS limbs or more, so
+ * multiplying two 2048L registers is O(n^1.58) limb products instead of O(n^2).
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+// Below this number of limbs Karatsuba is slower than schoolbook
+#define KARATSUBA_LIMBS 32
+
+namespace scm {
+
+  class register_arith {
+    private:
+      typedef std::vector<uint64_t> limbs_t; /**< Little-endian limbs, limb 0 is the least significant */
+
+      static inline uint64_t loadLimb(const unsigned char * reg, uint32_t size, uint32_t limb) {
+        if ((limb + 1)*8 > size)
+          return 0;
+        uint64_t value;
+        std::memcpy(&value, reg + size - (limb + 1)*8, 8);
+        return __builtin_bswap64(value);
+      }
+      static inline void storeLimb(unsigned char * reg, uint32_t size, uint32_t limb, uint64_t value) {
+        value = __builtin_bswap64(value);
+        std::memcpy(reg + size - (limb + 1)*8, &value, 8);
+      }
+
+      static inline unsigned char addLimb(unsigned char carry, uint64_t a, uint64_t b, uint64_t * result) {
+#if defined(__x86_64__)
+        unsigned long long out;
+        carry = _addcarry_u64(carry, a, b, &out);
+        *result = out;
+        return carry;
+#else
+        uint64_t sum;
+        unsigned char overflow = __builtin_add_overflow(a, b, &sum);
+        overflow |= __builtin_add_overflow(sum, static_cast<uint64_t>(carry), result);
+        return overflow;
+#endif
+      }
+      static inline unsigned char subLimb(unsigned char borrow, uint64_t a, uint64_t b, uint64_t * result) {
+#if defined(__x86_64__)
+        unsigned long long out;
+        borrow = _subborrow_u64(borrow, a, b, &out);
+        *result = out;
+        return borrow;
+#else
+        uint64_t diff;
+        unsigned char underflow = __builtin_sub_overflow(a, b, &diff);
+        underflow |= __builtin_sub_overflow(diff, static_cast<uint64_t>(borrow), result);
+        return underflow;
+#endif
+      }
+
+      // dst = a + b or a - b, b is a register or a 64 bits value
+      template <bool SUB>
+      static inline unsigned char addSub(unsigned char * dst, uint32_t dstSize, const unsigned char * a, uint32_t aSize, const unsigned char * b, uint32_t bSize, uint64_t bValue) {
+        if (dstSize == 8 && aSize == 8 && (b == nullptr || bSize == 8)) {
+          // R64B fast path
+          uint64_t bLimb = b != nullptr ? loadLimb(b, 8, 0) : bValue;
+          uint64_t result;
+          unsigned char carry = SUB ? subLimb(0, loadLimb(a, 8, 0), bLimb, &result) : addLimb(0, loadLimb(a, 8, 0), bLimb, &result);
+          storeLimb(dst, 8, 0, result);
+          return carry;
+        }
+        unsigned char carry = 0;
+        for (uint32_t limb = 0; limb < dstSize/8; limb++) {
+          uint64_t bLimb = b != nullptr ? loadLimb(b, bSize, limb) : (limb == 0 ? bValue : 0);
+          uint64_t result;
+          carry = SUB ? subLimb(carry, loadLimb(a, aSize, limb), bLimb, &result) : addLimb(carry, loadLimb(a, aSize, limb), bLimb, &result);
+          storeLimb(dst, dstSize, limb, result);
+        }
+        return carry;
+      }
+
+      static inline limbs_t toLimbs(const unsigned char * reg, uint32_t size) {
+        limbs_t limbs(size/8);
+        for (uint32_t limb = 0; limb < size/8; limb++)
+          limbs[limb] = loadLimb(reg, size, limb);
+        return limbs;
+      }
+
+      // r[0, rn) += x[0, xn), the carry goes up to r[rn - 1]
+      static inline void addLimbs(uint64_t * r, size_t rn, const uint64_t * x, size_t xn) {
+        unsigned char carry = 0;
+        size_t i = 0;
+        for (; i < std::min(rn, xn); i++)
+          carry = addLimb(carry, r[i], x[i], &r[i]);
+        for (; carry && i < rn; i++)
+          carry = addLimb(carry, r[i], 0, &r[i]);
+      }
+      // r[0, rn) -= x[0, xn), x is not larger than r
+      static inline void subLimbs(uint64_t * r, size_t rn, const uint64_t * x, size_t xn) {
+        unsigned char borrow = 0;
+        size_t i = 0;
+        for (; i < std::min(rn, xn); i++)
+          borrow = subLimb(borrow, r[i], x[i], &r[i]);
+        for (; borrow && i < rn; i++)
+          borrow = subLimb(borrow, r[i], 0, &r[i]);
+      }
+
+      // r[0, rn) = lower rn limbs of a * b
+      static inline void mulSchoolbook(const uint64_t * a, size_t an, const uint64_t * b, size_t bn, uint64_t * r, size_t rn) {
+        std::fill(r, r + rn, 0);
+        for (size_t i = 0; i < std::min(an, rn); i++) {
+          uint64_t carry = 0;
+          size_t j = 0;
+          for (; j < bn && i + j < rn; j++) {
+            unsigned __int128 t = static_cast<unsigned __int128>(a[i])*b[j] + r[i + j] + carry;
+            r[i + j] = static_cast<uint64_t>(t);
+            carry = static_cast<uint64_t>(t >> 64);
+          }
+          if (i + j < rn)
+            r[i + j] = carry;
+        }
+      }
+
+      // r[0, 2n) = a * b, both of n limbs
+      static void mulKaratsuba(const uint64_t * a, const uint64_t * b, size_t n, uint64_t * r) {
+        if (n < KARATSUBA_LIMBS) {
+          mulSchoolbook(a, n, b, n, r, 2*n);
+          return;
+        }
+        // a = a1*B^h + a0, a*b = z2*B^2h + (z1 - z2 - z0)*B^h + z0 with z1 = (a0 + a1)*(b0 + b1)
+        size_t h = n/2, hh = n - h;
+        mulKaratsuba(a, b, h, r);
+        mulKaratsuba(a + h, b + h, hh, r + 2*h);
+        limbs_t sa(a + h, a + n), sb(b + h, b + n);
+        sa.push_back(0);
+        sb.push_back(0);
+        addLimbs(sa.data(), hh + 1, a, h);
+        addLimbs(sb.data(), hh + 1, b, h);
+        limbs_t z1(2*(hh + 1));
+        mulKaratsuba(sa.data(), sb.data(), hh + 1, z1.data());
+        subLimbs(z1.data(), z1.size(), r, 2*h);
+        subLimbs(z1.data(), z1.size(), r + 2*h, 2*hh);
+        addLimbs(r + h, 2*n - h, z1.data(), z1.size());
+      }
+
+      static inline void storeProduct(unsigned char * dst, uint32_t dstSize, limbs_t a, limbs_t b) {
+        size_t dn = dstSize/8;
+        // The limbs of the operands above the destination do not change its part of the product
+        a.resize(std::min(a.size(), dn));
+        b.resize(std::min(b.size(), dn));
+        limbs_t product;
+        if (std::min(a.size(), b.size()) < KARATSUBA_LIMBS || dn <= KARATSUBA_LIMBS) {
+          product.resize(dn);
+          mulSchoolbook(a.data(), a.size(), b.data(), b.size(), product.data(), dn);
+        } else {
+          size_t n = std::max(a.size(), b.size());
+          a.resize(n, 0);
+          b.resize(n, 0);
+          product.resize(2*n);
+          mulKaratsuba(a.data(), b.data(), n, product.data());
+        }
+        for (size_t limb = 0; limb < dn; limb++)
+          storeLimb(dst, dstSize, limb, limb < product.size() ? product[limb] : 0);
+      }
+
+    public:
+      /** \brief dst = a + b
+       *  \returns the carry out of the destination
+       */
+      static inline bool add(unsigned char * dst, uint32_t dstSize, const unsigned char * a, uint32_t aSize, const unsigned char * b, uint32_t bSize) {
+        return addSub<false>(dst, dstSize, a, aSize, b, bSize, 0);
+      }
+      /** \brief dst = a - b
+       *  \returns true if b is larger than a (borrow out of the destination)
+       */
+      static inline bool sub(unsigned char * dst, uint32_t dstSize, const unsigned char * a, uint32_t aSize, const unsigned char * b, uint32_t bSize) {
+        return addSub<true>(dst, dstSize, a, aSize, b, bSize, 0);
+      }
+      /** \brief dst = a + immediate, the immediate is signed
+       *  \returns the carry out of the destination if the immediate is positive, the borrow if it is negative
+       */
+      static inline bool addImmediate(unsigned char * dst, uint32_t dstSize, const unsigned char * a, uint32_t aSize, int64_t immediate) {
+        if (immediate < 0)
+          return addSub<true>(dst, dstSize, a, aSize, nullptr, 0, -static_cast<uint64_t>(immediate));
+        return addSub<false>(dst, dstSize, a, aSize, nullptr, 0, immediate);
+      }
+      /** \brief dst = a - immediate, the immediate is signed
+       *  \returns the borrow out of the destination if the immediate is positive, the carry if it is negative
+       */
+      static inline bool subImmediate(unsigned char * dst, uint32_t dstSize, const unsigned char * a, uint32_t aSize, int64_t immediate) {
+        if (immediate < 0)
+          return addSub<false>(dst, dstSize, a, aSize, nullptr, 0, -static_cast<uint64_t>(immediate));
+        return addSub<true>(dst, dstSize, a, aSize, nullptr, 0, immediate);
+      }
+
+      /** \brief value of a register, or UINT64_MAX if it does not fit in 64 bits
+       */
+      static inline uint64_t toUint64(const unsigned char * reg, uint32_t size) {
+        for (uint32_t limb = 1; limb < size/8; limb++)
+          if (loadLimb(reg, size, limb) != 0)
+            return UINT64_MAX;
+        return loadLimb(reg, size, 0);
+      }
+
+      /** \brief reg <<= bits, the bits that go out of the register are lost
+       */
+      static inline void shiftLeft(unsigned char * reg, uint32_t size, uint64_t bits) {
+        uint32_t n = size/8;
+        uint64_t words = bits/64, shift = bits%64;
+        for (uint32_t limb = n; limb-- > 0;) {
+          uint64_t value = 0;
+          if (limb >= words) {
+            value = loadLimb(reg, size, limb - words) << shift;
+            if (shift != 0 && limb > words)
+              value |= loadLimb(reg, size, limb - words - 1) >> (64 - shift);
+          }
+          storeLimb(reg, size, limb, value);
+        }
+      }
+      /** \brief reg >>= bits
+       */
+      static inline void shiftRight(unsigned char * reg, uint32_t size, uint64_t bits) {
+        uint32_t n = size/8;
+        uint64_t words = bits/64, shift = bits%64;
+        for (uint32_t limb = 0; limb < n; limb++) {
+          uint64_t value = 0;
+          if (words < n - limb) {
+            value = loadLimb(reg, size, limb + words) >> shift;
+            if (shift != 0 && words + 1 < n - limb)
+              value |= loadLimb(reg, size, limb + words + 1) << (64 - shift);
+          }
+          storeLimb(reg, size, limb, value);
+        }
+      }
+
+      /** \brief dst = a * b, truncated to the size of dst. dst can be a or b
+       */
+      static inline void mult(unsigned char * dst, uint32_t dstSize, const unsigned char * a, uint32_t aSize, const unsigned char * b, uint32_t bSize) {
+        if (dstSize == 8 && aSize == 8 && bSize == 8) {
+          // R64B fast path
+          storeLimb(dst, 8, 0, loadLimb(a, 8, 0)*loadLimb(b, 8, 0));
+          return;
+        }
+        storeProduct(dst, dstSize, toLimbs(a, aSize), toLimbs(b, bSize));
+      }
+      /** \brief dst = a * immediate, truncated to the size of dst
+       */
+      static inline void multImmediate(unsigned char * dst, uint32_t dstSize, const unsigned char * a, uint32_t aSize, uint64_t immediate) {
+        if (dstSize == 8 && aSize == 8) {
+          storeLimb(dst, 8, 0, loadLimb(a, 8, 0)*immediate);
+          return;
+        }
+        storeProduct(dst, dstSize, toLimbs(a, aSize), limbs_t(1, immediate));
+      }
+  };
+
+}
+
+#endif // __REGISTER_ARITH__
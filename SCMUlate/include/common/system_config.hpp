@@ -1,9 +1,35 @@
 #ifndef __SCMULATE_SYS_CONFIG__
 #define __SCMULATE_SYS_CONFIG__
+#include "register_config.hpp"
 #define RESERVATION_TABLE_SIZE 100
+// Number of instructions that can be assigned to a CU at the same time
+#define CU_QUEUE_DEPTH 2
+// Polls of an idle CU before it starts yielding the CPU, and before it blocks (see IDLE_POLICIES)
+#define CU_IDLE_SPIN_ITERATIONS 2000
+#define CU_IDLE_YIELD_ITERATIONS 200
+// Registers of this size class and larger are renamed (see REG_SIZE_CLASS in register_config.hpp)
+#define RENAMING_MIN_REG_SIZE_CLASS scm::REG_256L
+// Alignment of the arrays allocated in the L2 memory of the machine (see l2_memory.hpp)
+#define L2_MALLOC_ALIGNMENT 64
+// Size of the huge pages of the L2 memory and the register file (see memory_pages.hpp)
+#define HUGE_PAGE_SIZE (2ul*1024*1024)
 
 namespace scm {
     enum ILP_MODES {SEQUENTIAL, SUPERSCALAR};
+    // How the SU selects the CU of a memory or execute instruction (see sched_policy.hpp)
+    enum SCHED_POLICIES {ROUND_ROBIN, LEAST_LOADED, REG_AFFINITY};
+    // What an idle CU does: spin (with a pause), spin and then yield the CPU, or
+    // spin, yield and then block until the SU assigns it an instruction
+    enum IDLE_POLICIES {IDLE_SPIN, IDLE_YIELD, IDLE_BLOCK};
+    // How the threads of the SU and the CUs are created: an OpenMP parallel region in each
+    // run, or std::threads created with the machine that wait for the next run
+    enum THREAD_BACKENDS {OPENMP_BACKEND, STD_THREAD_BACKEND};
+    // Where the pages of the register file and the L2 memory are: the default policy of the OS,
+    // interleaved between the nodes of the CUs, or the L2 split in one block for each CU on its
+    // node (see numa_placement.hpp). Except with interleave, each CU first touches a part of the registers
+    enum NUMA_PLACEMENTS {NUMA_NONE, NUMA_INTERLEAVE, NUMA_BLOCKED};
+    // Pages of a mapping: from the huge page pool of the system, transparent huge pages, or normal pages
+    enum PAGE_KINDS {HUGETLB_PAGES, TRANSPARENT_HUGE_PAGES, SMALL_PAGES};
 }
 
 #endif // __SCMULATE_SYS_CONFIG__
\ No newline at end of file
@@ -1,35 +1,130 @@
+#ifndef __THREADS_CONFIGURATION__
+#define __THREADS_CONFIGURATION__
+
+#include <vector>
+#include <cstdint>
+#include <thread>
+#include "system_config.hpp"
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
 // MACROS MAGIC
-#define VALUE_TO_STRING(x) #x
-#define VALUE(x) VALUE_TO_STRING(x)
-#define CONCAT(a, b) a ## b
-#define CONCAT2(a, b) CONCAT(a, b)
 #define TWENTYTWO_ARGUMENT(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a29, a20, a21, a22, ...) a22
 #define COUNT_ARGUMENTS(...) TWENTYTWO_ARGUMENT(dummy, ##__VA_ARGS__,20, 19 ,18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
-#define CU_CASE_1(arg1) arg1
-#define CU_CASE_2(arg1, arg2) arg1: case arg2
-#define CU_CASE_3(arg1, arg2, arg3) arg1: case arg2: case arg3
-#define CU_CASE_4(arg1, arg2, arg3, arg4) arg1: case arg2: case arg3: case arg4
-#define CU_CASE_5(arg1, arg2, arg3, arg4, arg5) arg1: case arg2: case arg3: case arg4: case arg5
-#define CU_CASE_6(arg1, arg2, arg3, arg4, arg5, arg6) arg1: case arg2: case arg3: case arg4: case arg5: case arg6
-#define CU_CASE_7(arg1, arg2, arg3, arg4, arg5, arg6, arg7) arg1: case arg2: case arg3: case arg4: case arg5: case arg6: case arg7
-#define CU_CASE_8(arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8) arg1: case arg2: case arg3: case arg4: case arg5: case arg6: case arg7: case arg8
-#define CU_CASE_9(arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9) arg1: case arg2: case arg3: case arg4: case arg5: case arg6: case arg7: case arg8: case arg9
-#define CU_CASE_10(arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10) arg1: case arg2: case arg3: case arg4: case arg5: case arg6: case arg7: case arg8: case arg9: case arg10
-#define CU_CASE_11(arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10, arg11) arg1: case arg2: case arg3: case arg4: case arg5: case arg6: case arg7: case arg8: case arg9: case arg10: case arg11
-#define CU_CASE_12(arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10, arg11, arg12) arg1: case arg2: case arg3: case arg4: case arg5: case arg6: case arg7: case arg8: case arg9: case arg10: case arg11: case arg12
-#define CU_CASE_13(arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10, arg11, arg12, arg13) arg1: case arg2: case arg3: case arg4: case arg5: case arg6: case arg7: case arg8: case arg9: case arg10: case arg11: case arg12: case arg13
-#define CU_CASE_14(arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10, arg11, arg12, arg13, arg14) arg1: case arg2: case arg3: case arg4: case arg5: case arg6: case arg7: case arg8: case arg9: case arg10: case arg11: case arg12: case arg13: case arg14
-#define CU_CASE_15(arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10, arg11, arg12, arg13, arg14, arg15) arg1: case arg2: case arg3: case arg4: case arg5: case arg6: case arg7: case arg8: case arg9: case arg10: case arg11: case arg12: case arg13: case arg14: case arg15
-#define CU_CASE_16(arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10, arg11, arg12, arg13, arg14, arg15, arg16) arg1: case arg2: case arg3: case arg4: case arg5: case arg6: case arg7: case arg8: case arg9: case arg10: case arg11: case arg12: case arg13: case arg14: case arg15: case arg16
-#define CU_CASE_17(arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10, arg11, arg12, arg13, arg14, arg15, arg16, arg17) arg1: case arg2: case arg3: case arg4: case arg5: case arg6: case arg7: case arg8: case arg9: case arg10: case arg11: case arg12: case arg13: case arg14: case arg15: case arg16: case arg17
-#define CU_CASE_18(arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10, arg11, arg12, arg13, arg14, arg15, arg16, arg17, arg18) arg1: case arg2: case arg3: case arg4: case arg5: case arg6: case arg7: case arg8: case arg9: case arg10: case arg11: case arg12: case arg13: case arg14: case arg15: case arg16: case arg17: case arg18
-#define CU_CASE_19(arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10, arg11, arg12, arg13, arg14, arg15, arg16, arg17, arg18, arg19) arg1: case arg2: case arg3: case arg4: case arg5: case arg6: case arg7: case arg8: case arg9: case arg10: case arg11: case arg12: case arg13: case arg14: case arg15: case arg16: case arg17: case arg18: case arg19
-#define CU_CASE_20(arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10, arg11, arg12, arg13, arg14, arg15, arg16, arg17, arg18, arg19, arg20) arg1: case arg2: case arg3: case arg4: case arg5: case arg6: case arg7: case arg8: case arg9: case arg10: case arg11: case arg12: case arg13: case arg14: case arg15: case arg16: case arg17: case arg18: case arg19:  case arg20
-#define CU_THREADS_VAR(...) CONCAT2(CU_CASE_, COUNT_ARGUMENTS(__VA_ARGS__))(__VA_ARGS__)
-
 
 #define SU_THREAD 0
 #define CUS 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11
 #define COUNT_CUS(...) COUNT_ARGUMENTS(__VA_ARGS__)
 #define NUM_CUS COUNT_CUS(CUS)
-#define CU_THREADS CU_THREADS_VAR(CUS)
+
+namespace scm {
+
+  /** \brief Threads of a machine
+   *
+   *  The number of CUs and the CPU of each thread are given when the machine is created. 
+   *  Thread 0 is the SU (SU_THREAD) and thread i+1 is the CU i. When no CPUs are given, 
+   *  the threads are not pinned, so the machine can share the node with other jobs. With the 
+   *  list "auto" the threads are pinned to the CPUs this process can use, one hardware thread 
+   *  of each core first. If there are not enough CPUs the threads are not pinned.
+   *  It also has the idle policy of the CUs, IDLE_SPIN by default, the backend
+   *  that creates the threads, OPENMP_BACKEND by default, and the NUMA placement of
+   *  the memory of the machine, NUMA_NONE by default.
+   */
+  class threads_config {
+    private:
+      uint32_t num_cus;
+      std::vector<int> cpus; /**< CPU of each thread, empty if they are not pinned */
+      bool valid;
+      IDLE_POLICIES idle_policy;
+      uint32_t spin_iterations; /**< Polls before an idle CU yields the CPU */
+      uint32_t yield_iterations; /**< Polls yielding the CPU before an idle CU blocks */
+      THREAD_BACKENDS backend;
+      NUMA_PLACEMENTS placement;
+
+      /** \brief check the CPUs are distinct and this process can use them
+       */
+      bool checkCPUs();
+
+    public:
+      /** \brief create the configuration
+       *  \param numCUs number of CUs, NUM_CUS by default
+       *  \param cpuList CPU of the SU and of each CU, e.g. "0,2,4-12", or "auto" to use 
+       *  the first available ones. nullptr to leave the threads unpinned
+       */
+      threads_config(uint32_t numCUs = NUM_CUS, const char * cpuList = nullptr);
+      threads_config(uint32_t numCUs, std::vector<int> affinity);
+
+      /** \brief parse a list of CPUs, e.g. "0,2,4-12"
+       *  \returns false if the list is not valid
+       */
+      static bool parseCPUList(const char * cpuList, std::vector<int> & result);
+
+      /** \brief CPUs this process can use, the first hardware thread of every core first.
+       *  The CPUs of the same NUMA node are together, so consecutive CUs share a node
+       */
+      static std::vector<int> availableCPUs();
+
+      /** \brief parse the name of an idle policy: spin, yield or block
+       *  \returns false if the name is not valid
+       */
+      static bool parseIdlePolicy(const char * name, IDLE_POLICIES & result);
+
+      /** \brief select what the CUs do when they do not have instructions
+       */
+      inline void setIdlePolicy(IDLE_POLICIES policy, uint32_t spinIterations = CU_IDLE_SPIN_ITERATIONS, uint32_t yieldIterations = CU_IDLE_YIELD_ITERATIONS) {
+        idle_policy = policy;
+        spin_iterations = spinIterations;
+        yield_iterations = yieldIterations;
+      }
+      inline IDLE_POLICIES getIdlePolicy() const { return idle_policy; }
+      inline uint32_t getSpinIterations() const { return spin_iterations; }
+      inline uint32_t getYieldIterations() const { return yield_iterations; }
+
+      /** \brief parse the name of a threads backend: omp or threads
+       *  \returns false if the name is not valid
+       */
+      static bool parseBackend(const char * name, THREAD_BACKENDS & result);
+      inline void setBackend(THREAD_BACKENDS newBackend) { backend = newBackend; }
+      inline THREAD_BACKENDS getBackend() const { return backend; }
+
+      /** \brief parse the name of a NUMA placement: none, interleave or blocked
+       *  \returns false if the name is not valid
+       */
+      static bool parsePlacement(const char * name, NUMA_PLACEMENTS & result);
+      inline void setPlacement(NUMA_PLACEMENTS newPlacement) { placement = newPlacement; }
+      inline NUMA_PLACEMENTS getPlacement() const { return placement; }
+
+      inline uint32_t numCUs() const { return num_cus; }
+      inline uint32_t numThreads() const { return num_cus + 1; }
+      inline bool isPinned() const { return !cpus.empty(); }
+      inline bool isValid() const { return valid; }
+      /** \brief CPU of a thread, -1 if it is not pinned
+       */
+      inline int getCPU(uint32_t threadNum) const { return threadNum < cpus.size() ? cpus[threadNum] : -1; }
+      /** \brief NUMA node of a thread, -1 if it is not pinned
+       */
+      int getNode(uint32_t threadNum) const;
+      /** \brief NUMA nodes of the CUs, without repetitions
+       */
+      std::vector<int> cuNodes() const;
+
+      /** \brief pin the calling thread to the CPU of threadNum
+       *  \returns false if it could not be pinned
+       */
+      bool pinThread(uint32_t threadNum) const;
+  };
+
+  /** \brief tell the CPU this thread is spinning (pause in x86)
+   */
+  static inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+  }
+
+}
+
+#endif // __THREADS_CONFIGURATION__
@@ -3,15 +3,21 @@
 
 #include <omp.h>
 #include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 // SCM Related Includes
 #include "SCMUlate_tools.hpp"
 #include "system_config.hpp"
 #include "threads_configuration.hpp"
+#include "numa_placement.hpp"
 #include "register.hpp"
 #include "control_store.hpp"
 #include "executor.hpp"
 #include "instruction_mem.hpp"
+#include "l2_memory.hpp"
 #include "fetch_decode.hpp"
 #include "system_codelets.hpp"
 #include "timers_counters.hpp"
@@ -22,11 +28,23 @@ namespace scm {
   enum run_status_t {SCM_RUN_SUCCESS, SCM_RUN_FAILURE};
   typedef enum run_status_t run_status;
 
+  /** \brief bytes moved between the L2 memory and the registers by the CUs of a NUMA node
+   */
+  struct node_bandwidth_t {
+    int node; /**< -1 for the CUs that are not pinned */
+    uint32_t cus;
+    uint64_t bytes_read;
+    uint64_t bytes_written;
+    double seconds; /**< Time of the run */
+  };
+
   class scm_machine {
     private: 
       bool alive;
       bool init_correct;
       char* filename;
+      threads_config threads_cfg; /**< Number of CUs and CPU of each thread */
+      l2_memory_module * l2_memory_m; /**< L2 memory of the machine, nullptr if the host gives it */
       TIMERS_COUNTERS_GUARD(timers_counters time_cnt_m;)
       
       // Modules
@@ -36,9 +54,46 @@ namespace scm {
       fetch_decode_module fetch_decode_m;
       std::vector<cu_executor_module*> executors_m;
 
+      // STD_THREAD_BACKEND: the threads are created with the machine and wait for each run
+      std::vector<std::thread> workers;
+      std::mutex workers_lock;
+      std::condition_variable workers_cv;
+      double run_seconds; /**< Time of the last run */
+      uint64_t run_number; /**< Incremented to start a run in the workers */
+      uint32_t workers_done; /**< Workers that finished the current run */
+      bool workers_reset; /**< The current run of the workers zeroes the register file */
+      bool workers_exit;
+
+      /** \brief run the SU or the CU of a thread number
+       */
+      void runUnit(uint32_t threadNum);
+      /** \brief loop of a persistent thread of the STD_THREAD_BACKEND
+       */
+      void workerLoop(uint32_t threadNum);
+      /** \brief start the persistent threads and wait for them
+       *  \param reset zero the register file instead of running the program
+       */
+      void startWorkers(bool reset);
+      /** \brief zero the register file in parallel, each CU its part from the thread 
+       *  that runs it (the persistent threads or the OpenMP team)
+       */
+      void resetRegisters();
+      run_status runOpenMP();
+      run_status runThreads();
+      scm_machine(char * in_filename, l2_memory_t const external_memory, l2_memory_module * owned_memory, ILP_MODES ilp_mode, SCHED_POLICIES sched_policy, const threads_config & threads, const register_geometry & registers);
+
     public: 
       scm_machine() = delete;
-      scm_machine(char * in_filename, unsigned char * const external_memory, ILP_MODES ilp_mode = ILP_MODES::SEQUENTIAL); 
+      /** \brief create a machine
+       *  \param threads number of CUs and CPU of the SU and of each CU (see threads_configuration.hpp)
+       *  \param registers geometry of the register file, e.g. read from a machine description (see register_config.hpp)
+       */
+      scm_machine(char * in_filename, unsigned char * const external_memory, ILP_MODES ilp_mode = ILP_MODES::SEQUENTIAL, SCHED_POLICIES sched_policy = SCHED_POLICIES::ROUND_ROBIN, const threads_config & threads = threads_config(), const register_geometry & registers = register_geometry()); 
+      /** \brief create a machine that owns its L2 memory (see l2_memory.hpp)
+       *  \param l2Size bytes of L2 memory. Its pages are only allocated when they are touched
+       *  \param hugePages try huge pages first
+       */
+      scm_machine(char * in_filename, uint64_t l2Size, ILP_MODES ilp_mode = ILP_MODES::SEQUENTIAL, SCHED_POLICIES sched_policy = SCHED_POLICIES::ROUND_ROBIN, const threads_config & threads = threads_config(), bool hugePages = true, const register_geometry & registers = register_geometry()); 
 
       // getters
       inline reg_file_module * getRegFile() {return &reg_file_m; }
@@ -46,11 +101,47 @@ namespace scm {
       inline control_store_module * getControlStore() { return &control_store_m; }
       inline fetch_decode_module * getFetchDecode() { return &fetch_decode_m; }
       inline cu_executor_module * getExecutorCU (uint32_t execID) { return executors_m[execID]; }
+      inline const threads_config & getThreadsConfig() { return threads_cfg; }
+      /** \brief L2 memory owned by the machine, nullptr if the host gave it
+       */
+      inline l2_memory_module * getL2Memory() { return l2_memory_m; }
 
       TIMERS_COUNTERS_GUARD( 
         void inline setTimersOutput(std::string outputName) { this->time_cnt_m.setFilename(outputName); }
       )
 
+      /** \brief place the pages of the L2 memory in the NUMA nodes of the CUs, according 
+       *  to the placement of the threads configuration. Pages that are touched later are 
+       *  placed too, so it can be called before the memory is initialized
+       *  \returns false if the memory could not be placed
+       */
+      bool placeMemory(l2_memory_t memory, uint64_t size);
+
+      /** \brief bytes moved by the memory instructions of the last run, for each NUMA node of the CUs
+       */
+      std::vector<node_bandwidth_t> getBandwidthReport();
+      void printBandwidthReport();
+
+      /** \brief replace the program of the machine. The threads, the registers and the 
+       *  memory are kept, so a stream of programs does not pay the creation of the machine
+       *  \returns false if the program is not valid
+       */
+      bool load(char * in_filename);
+
+      /** \brief write a value in a 64B register, e.g. the address of an array allocated 
+       *  with l2Malloc. It is kept until the program writes it, or until reset()
+       */
+      void setRegister64B(uint32_t num, uint64_t value);
+
+      /** \brief set all the registers to zero, e.g. between unrelated programs. The CUs 
+       *  zero them in parallel
+       */
+      void reset();
+
+      /** \brief run the loaded program from its first instruction. It can be called 
+       *  again to run the same program
+       *  \returns SCM_RUN_FAILURE if the program is not valid or an error stopped the machine
+       */
       run_status run();
     
       ~scm_machine();
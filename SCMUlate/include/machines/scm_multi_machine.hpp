@@ -0,0 +1,143 @@
+#ifndef __MULTI_MACHINE_CONFIGURATION__
+#define __MULTI_MACHINE_CONFIGURATION__
+
+/** \brief SCM machine with several SUs
+ *
+ * This file contains a machine that runs a batch of independent SCM programs at the
+ * same time. The machine has several SU partitions. Each one has its own SU, instruction
+ * memory, PC, ILP controller and register file, and it owns a set of the CUs of the
+ * machine. An SU partition runs one program at a time, and takes the next program of
+ * the batch when it finishes. The goal is the throughput of the batch, not the latency
+ * of each program.
+ *
+ * When there are no more programs for an SU, its CUs are given to the partition that
+ * is running with the fewest CUs, so the last programs of the batch use the whole
+ * machine. A CU joins a running program through a new execution slot of its control
+ * store, and it stays in that partition for the following programs.
+ */
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "scm_machine.hpp"
+
+namespace scm {
+
+  /** \brief Program of a batch and the result of its run
+   */
+  struct scm_job_t {
+    char * filename;
+    l2_memory_t memory; /**< Memory of the program, the partitions do not share it */
+    run_status status;
+    int32_t su; /**< SU partition that ran the program, -1 if it did not run */
+    uint32_t max_cus; /**< CUs of the partition when the program finished */
+    double seconds; /**< From the load of the program until all its CUs stopped */
+
+    scm_job_t(char * file, l2_memory_t mem) :
+      filename(file), memory(mem), status(SCM_RUN_FAILURE), su(-1), max_cus(0), seconds(0) { }
+  };
+
+  /** \brief An SU with its own program and register file, and the CUs it owns
+   *
+   *  The modules are created with the first program of the SU, and the following
+   *  programs are loaded in them (see scm_machine::load). The executors are created
+   *  for each program, when a CU takes a slot of the control store.
+   */
+  class su_partition {
+    public:
+      bool alive;
+      scm_job_t * job;
+      uint32_t running_cus; /**< CUs running an executor of the current program */
+      reg_file_module reg_file_m;
+      inst_mem_module inst_mem_m;
+      control_store_module control_store_m;
+      fetch_decode_module fetch_decode_m;
+      std::vector<cu_executor_module*> executors_m; /**< Executor of each slot in use */
+
+      su_partition() = delete;
+      /** \brief create the modules of the SU and load its first program
+       *  \param maxCUs CUs of the machine, any of them can join the partition
+       */
+      su_partition(uint32_t suNumber, scm_job_t * firstJob, uint32_t maxCUs, ILP_MODES ilp_mode, SCHED_POLICIES sched_policy, const register_geometry & registers);
+
+      /** \brief load the next program with zero registers and no CUs
+       *  \returns false if the program is not valid
+       */
+      bool load(scm_job_t * newJob);
+
+      /** \brief add a CU to the running program
+       *  \returns the executor of the new slot, nullptr if there are no slots
+       */
+      cu_executor_module * addCU(uint32_t cuNumber, const threads_config & threads);
+
+      ~su_partition();
+  };
+
+  class scm_multi_machine {
+    private:
+      uint32_t num_sus;
+      ILP_MODES ilp_mode;
+      SCHED_POLICIES sched_policy;
+      threads_config threads_cfg; /**< Number of CUs and what they do when they are idle */
+      std::vector<uint32_t> partition_cus; /**< CUs of each SU at the beginning of the batch */
+      bool rebalance; /**< Give the CUs of an SU that has no more programs to the others */
+      std::vector<register_geometry> registers; /**< Geometry of the register file of each SU */
+      bool init_correct;
+      TIMERS_COUNTERS_GUARD(timers_counters time_cnt_m;)
+
+      // State of the batch, protected by batch_lock
+      std::mutex batch_lock;
+      std::condition_variable batch_changed;
+      std::vector<scm_job_t> * jobs;
+      uint32_t next_job;
+      std::vector<su_partition*> partitions; /**< nullptr until the SU takes its first program */
+      std::vector<bool> su_running; /**< The partition is running a program */
+      std::vector<bool> su_retired; /**< There are no more programs for the SU */
+      std::vector<uint32_t> cu_owner; /**< SU partition of each CU */
+
+      /** \brief take programs of the batch until there are no more
+       */
+      void suLoop(uint32_t su);
+      /** \brief run the executors of the programs of the SU that owns the CU
+       */
+      void cuLoop(uint32_t cu);
+      /** \brief running partition with the fewest CUs, -1 if none
+       */
+      int32_t smallestRunningPartition();
+
+    public:
+      scm_multi_machine() = delete;
+      /** \brief create a machine
+       *  \param threads number of CUs of the machine and idle policy of the CUs. The
+       *  threads are not pinned
+       *  \param partitionCUs CUs of each SU, they must add up to the CUs of the
+       *  machine. If it is empty the CUs are divided evenly
+       */
+      scm_multi_machine(uint32_t numSUs, ILP_MODES ilp_mode = ILP_MODES::SEQUENTIAL, SCHED_POLICIES sched_policy = SCHED_POLICIES::ROUND_ROBIN,
+                        const threads_config & threads = threads_config(), std::vector<uint32_t> partitionCUs = std::vector<uint32_t>());
+
+      inline uint32_t numSUs() { return num_sus; }
+      inline uint32_t getPartitionCUs(uint32_t su) { return partition_cus[su]; }
+      inline bool isValid() { return init_correct; }
+      /** \brief enable or disable moving the CUs to other partitions (enabled by default)
+       */
+      inline void setRebalancing(bool enable) { rebalance = enable; }
+      /** \brief geometry of the register files of all the SUs that are created by the next run
+       */
+      inline void setRegisterGeometry(const register_geometry & geometry) { registers.assign(num_sus, geometry); }
+      /** \brief geometry of the register file of one SU, used from the next run
+       *  \returns false if the SU does not exist
+       */
+      bool setRegisterGeometry(uint32_t su, const register_geometry & geometry);
+
+      /** \brief run all the programs, each one in the first SU partition that is free
+       *  \returns SCM_RUN_FAILURE if any of them could not be loaded or was stopped by an error
+       */
+      run_status run(std::vector<scm_job_t> & batch);
+
+      ~scm_multi_machine();
+  };
+}
+
+#endif //__MULTI_MACHINE_CONFIGURATION__
@@ -6,38 +6,182 @@
 #include "instructions.hpp"
 #include "codelet.hpp"
 #include <vector>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 
 
 
 namespace scm {
 
+  /** \brief Completion queue
+   *
+   *  Bounded multiple producer single consumer ring. The CUs push the instructions 
+   *  they finish and the SU drains them, so the SU only looks at what has completed 
+   *  instead of polling every execution slot. Each cell has a sequence number that 
+   *  tells if it is free for the producer of a given position, or full for the consumer
+   *  of that position. Producers reserve a position with a CAS on the tail and publish 
+   *  the cell with a release store of its sequence. The consumer is the only one that 
+   *  moves the head, so it does not need atomic operations on it.
+   */
+  class completion_queue {
+    private:
+      struct cell_t {
+        std::atomic<uint64_t> sequence;
+        decoded_instruction_t * inst;
+      };
+      std::vector<cell_t> cells;
+      uint64_t mask;
+      // Producers and consumer should not share a cache line
+      alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> tail;
+      alignas(CACHE_LINE_SIZE) uint64_t head;
+
+    public:
+      /** \brief create the queue with room for at least minCapacity instructions
+       */
+      completion_queue(uint32_t minCapacity);
+
+      /** \brief push a finished instruction. Called by the CUs
+       *  \returns false if the queue is full
+       */
+      inline bool push(decoded_instruction_t * inst) {
+        uint64_t pos = tail.load(std::memory_order_relaxed);
+        while (true) {
+          cell_t & cell = cells[pos & mask];
+          uint64_t seq = cell.sequence.load(std::memory_order_acquire);
+          int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+          if (diff == 0) {
+            if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+              break;
+          } else if (diff < 0) {
+            return false;
+          } else {
+            pos = tail.load(std::memory_order_relaxed);
+          }
+        }
+        cell_t & cell = cells[pos & mask];
+        cell.inst = inst;
+        cell.sequence.store(pos + 1, std::memory_order_release);
+        return true;
+      }
+
+      /** \brief pop the oldest finished instruction. Only called by the SU
+       *  \returns nullptr if there is nothing to pop
+       */
+      inline decoded_instruction_t * pop() {
+        cell_t & cell = cells[head & mask];
+        if (cell.sequence.load(std::memory_order_acquire) != head + 1)
+          return nullptr;
+        decoded_instruction_t * inst = cell.inst;
+        cell.sequence.store(head + mask + 1, std::memory_order_release);
+        head++;
+        return inst;
+      }
+
+      inline uint32_t capacity() { return mask + 1; }
+      /** \brief drop the instructions that were not popped. Only called by the SU
+       *  when no CU is running
+       */
+      inline void clear() {
+        while (pop() != nullptr);
+      }
+  };
+
   /* An execution slot connects the scheduling of an instruction to its 
    * corresponding executor. The executor will be reading the execution
    * slot waiting for something to be available, once there's something
    * it will remove start its execution, and when it is finished it will
-   * cleare it for the scheduler to assign more work. At this stage it's 
-   * assumed the result has been commited either to the memory unit or
-   * or the register directly. On the other hand the scheduler will have
-   * a list of all the execution slots and chose one according to some 
-   * scheduling policy. 
+   * clear it and push the instruction to the completion queue for the 
+   * scheduler to release its hazards. At this stage it's assumed the result 
+   * has been commited either to the memory unit or the register directly. 
+   * On the other hand the scheduler will have a list of all the execution 
+   * slots and chose one according to some scheduling policy. 
+   *
+   * The pending instructions of the slot are kept in a bounded Chase-Lev 
+   * deque, so the SU can assign the next instructions to a CU while it is 
+   * still executing. The SU is the owner of the deque, and it only pushes at
+   * the bottom. The CU of the slot takes the oldest instruction from the top,
+   * and the idle CUs steal from the top of the busy ones in the same way. 
+   * The instruction is removed with a CAS on the top, so only one CU gets it.
+   * The CU publishes it as executing in its own slot before the CAS, so the 
+   * instruction is counted in the occupancy of one of the two slots at any time
+   * and the SU never sees it as free space. The SU can still fill the queue of a
+   * CU that is stealing, so the occupancy of a slot can be depth + 1 for a moment. 
+   * The hazards of the instruction were marked when the SU assigned it, and 
+   * the CU that executes it pushes it to the completion queue, so it does not
+   * matter for the ILP controller which CU executes it.
+   *
+   * An idle CU can block in its slot until the SU assigns it an instruction (IDLE_BLOCK). 
+   * The CU sets sleeping before it checks the deque for the last time, and the SU checks 
+   * sleeping after it publishes a new bottom, with a full fence in between on both sides. 
+   * Either the CU sees the instruction, or the SU sees the CU is sleeping and wakes it up.
    */
-  typedef enum {EMPTY, BUSY, DONE} executorState;
-  class execution_slot {
+  class alignas(CACHE_LINE_SIZE) execution_slot {
     private:
-      volatile executorState state;
-      decoded_instruction_t* executionInstruction;
+      std::vector<std::atomic<decoded_instruction_t*>> instructions;
+      completion_queue * completed;
+      // Written by the SU
+      alignas(CACHE_LINE_SIZE) std::atomic<int64_t> bottom;
+      // Written by the CUs that take instructions
+      alignas(CACHE_LINE_SIZE) std::atomic<int64_t> top;
+      // Written by the CU of the slot
+      alignas(CACHE_LINE_SIZE) std::atomic<decoded_instruction_t*> executing;
+      // The CU of the slot blocks here when it is idle
+      std::atomic<bool> sleeping;
+      std::mutex sleep_lock;
+      std::condition_variable wake_up;
 
     public:
       // Constructor 
-      execution_slot(): state(EMPTY), executionInstruction(NULL) {}; 
+      execution_slot(completion_queue * completionQueue, uint32_t depth): instructions(depth), completed(completionQueue), bottom(0), top(0), executing(nullptr), sleeping(false) {}; 
 
-      void assign(decoded_instruction_t *);
-      void empty_slot();
+      /** \brief add an instruction to the deque. Called by the SU
+       *  \returns false if the slot already has depth instructions
+       */
+      bool assign(decoded_instruction_t *);
+      /** \brief take the oldest pending instruction. Called by the CU of the slot, or
+       *  by an idle CU to steal it. The instruction is executing in the slot of the CU 
+       *  before it is removed from this one
+       *  \param thief slot of the CU that takes it, it must not be executing anything
+       *  \returns nullptr if there is none, or if another CU took it first
+       */
+      decoded_instruction_t * steal(execution_slot * thief);
+      /** \brief the instruction being executed is done. Called by the CU of the slot
+       */
       void done_execution();
-      inline bool is_busy() { return this->state == BUSY; }
-      inline bool is_empty() { return this->state == EMPTY; }
-      inline bool is_done() { return this->state == DONE; }
-      inline decoded_instruction_t * getHead() { return this->executionInstruction; }
+      /** \brief block the CU of the slot until an instruction is assigned to it, 
+       *  or the machine is not alive anymore
+       */
+      void wait_for_work(volatile bool * alive);
+      /** \brief wake up the CU of the slot if it is blocked
+       */
+      void wake();
+      /** \brief drop the pending instructions, e.g. the ones left when an error stopped 
+       *  the machine. Only called by the SU when no CU is running
+       */
+      void reset();
+      /** \brief number of pending instructions
+       */
+      inline uint32_t pending() { 
+        int64_t size = bottom.load(std::memory_order_acquire) - top.load(std::memory_order_acquire); 
+        return size > 0 ? size : 0;
+      }
+      /** \brief number of instructions assigned and not done yet
+       */
+      inline uint32_t occupancy() { return pending() + (executing.load(std::memory_order_acquire) ? 1 : 0); }
+      inline uint32_t depth() { return instructions.size(); }
+      inline bool is_busy() { return executing.load(std::memory_order_acquire) != nullptr; }
+      inline bool is_empty() { return occupancy() == 0; }
+      inline bool is_full() { return occupancy() >= depth(); }
+      /** \brief entries the SU can still assign, 0 if the occupancy went over the depth
+       */
+      inline uint32_t freeEntries() { 
+        uint32_t used = occupancy();
+        return used < depth() ? depth() - used : 0;
+      }
+      /** \brief instruction being executed by the CU of the slot
+       */
+      inline decoded_instruction_t * getHead() { return executing.load(std::memory_order_relaxed); }
   };
 
 
@@ -46,18 +190,49 @@ namespace scm {
    * should contain the different execution slots and any additional logic 
    * that allows the connection between the modules that schedule the 
    * instructions and those that compute. Execution slots are created and
-   * deleted here
+   * deleted here. 
+   *
+   * Slots can be created for more executors than the ones in use. The SU 
+   * and the CUs only look at the first numExecutors() slots, and more are 
+   * used when a CU joins at runtime (e.g. a CU of a partition that finished,
+   * see scm_multi_machine.hpp). 
    */
   class control_store_module {
     private:
       std::vector <execution_slot*> execution_slots;
+      std::atomic<uint32_t> active_slots; /**< Slots with an executor */
+      completion_queue completed;
 
     public: 
      control_store_module() = delete;
-     control_store_module(const int numExecUnits);
+     /** \brief create the execution slots
+      *  \param queueDepth number of instructions that can be assigned to each executor
+      *  \param maxExecUnits executors that can be added later with setNumExecutors, 0 if none
+      */
+     control_store_module(const int numExecUnits, const uint32_t queueDepth = CU_QUEUE_DEPTH, const int maxExecUnits = 0);
 
      inline execution_slot* get_executor(const int exec) { return this->execution_slots[exec]; }
-     inline uint32_t numExecutors() { return execution_slots.size(); }
+     inline uint32_t numExecutors() { return active_slots.load(std::memory_order_acquire); }
+     inline uint32_t maxExecutors() { return execution_slots.size(); }
+     /** \brief change the number of slots in use. Slots are only added while the 
+      *  program runs, they can be removed when all of them are empty
+      *  \returns false if there are not enough slots
+      */
+     bool setNumExecutors(uint32_t numExecUnits);
+     inline uint32_t queueDepth() { return execution_slots.empty() ? 0 : execution_slots[0]->depth(); }
+     /** \brief instructions finished by the executors, drained by the SU
+      */
+     inline completion_queue * getCompletionQueue() { return &completed; }
+     /** \brief empty the slots and the completion queue before a new run. Only called by 
+      *  the SU when no CU is running
+      */
+     void reset();
+     /** \brief wake up all the blocked CUs, e.g. when the machine is done
+      */
+     inline void wakeAll() {
+       for (auto slot : execution_slots)
+         slot->wake();
+     }
 
      ~control_store_module();
 
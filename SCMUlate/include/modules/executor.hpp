@@ -5,9 +5,50 @@
 #include "control_store.hpp"
 #include "timers_counters.hpp"
 #include "memory_interface.hpp"
+#include "threads_configuration.hpp"
 
 namespace scm {
 
+  /** \brief What an idle CU does between two polls of the execution slots
+   *
+   *  The CU spins with a pause for spinIterations polls. Then it yields the CPU for 
+   *  yieldIterations polls, and then it blocks in its slot until the SU assigns it an 
+   *  instruction. IDLE_SPIN never yields and IDLE_YIELD never blocks. 
+   */
+  class cu_idle_backoff {
+    private:
+      IDLE_POLICIES policy;
+      uint32_t spin_iterations;
+      uint32_t yield_iterations;
+      uint32_t idle_polls; /**< Polls since the last instruction */
+
+    public:
+      cu_idle_backoff(const threads_config & threads) :
+        policy(threads.getIdlePolicy()),
+        spin_iterations(threads.getSpinIterations()),
+        yield_iterations(threads.getYieldIterations()),
+        idle_polls(0) { }
+
+      /** \brief the CU found an instruction
+       */
+      inline void reset() { idle_polls = 0; }
+
+      /** \brief the CU did not find an instruction
+       */
+      inline void idle(execution_slot * slot, volatile bool * alive) {
+        if (policy == IDLE_SPIN || idle_polls < spin_iterations) {
+          cpuRelax();
+          idle_polls++;
+        } else if (policy == IDLE_YIELD || idle_polls < spin_iterations + yield_iterations) {
+          std::this_thread::yield();
+          idle_polls++;
+        } else {
+          slot->wait_for_work(alive);
+          idle_polls = 0;
+        }
+      }
+  };
+
   /** brief: Executors 
    *
    *  The cu_executor performs the execution of instructions, usually in
@@ -17,8 +58,11 @@ namespace scm {
     private:
       int cu_executor_id;
       execution_slot * myExecutor;
+      control_store_module * ctrl_st_m; /**< To steal instructions from the other execution slots */
+      uint32_t slot_number;
       mem_interface_module *mem_interface_t;
       volatile bool* aliveSignal;
+      cu_idle_backoff idleBackoff;
       TIMERS_COUNTERS_GUARD(
         std::string cu_timer_name;
         timers_counters* timer_cnt_m;
@@ -27,7 +71,7 @@ namespace scm {
 
     public: 
       cu_executor_module() = delete;
-      cu_executor_module(int, control_store_module * const, unsigned int, bool *, l2_memory_t upperMem);
+      cu_executor_module(int, control_store_module * const, unsigned int, bool *, l2_memory_t upperMem, const threads_config & threads);
 
       TIMERS_COUNTERS_GUARD(
         inline void setTimerCnt(timers_counters * tmc) { 
@@ -38,6 +82,10 @@ namespace scm {
       )
 
       int behavior();
+      /** \brief take a pending instruction from the slot of another CU
+       *  \returns nullptr if there is nothing to steal
+       */
+      decoded_instruction_t * stealInstruction();
       int codeletExecutor();
 
       int get_executor_id(){ return this->cu_executor_id; }
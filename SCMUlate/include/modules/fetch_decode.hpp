@@ -17,7 +17,10 @@
 #include "instructions.hpp"
 #include "timers_counters.hpp"
 #include "ilp_controller.hpp"
+#include "register_rename.hpp"
+#include "sched_policy.hpp"
 #include <string>
+#include <vector>
 
 
 namespace scm {
@@ -38,6 +41,12 @@ namespace scm {
       int PC; /**< Program counter, this corresponds to the current instruction being executed */
       uint32_t su_number; /**< This corresponds to the current SU number */
       ilp_controller instructionLevelParallelism;
+      register_rename_module renameStage; /**< Renames the large registers of the fetched instructions */
+      std::vector<decoded_instruction_t *> reservationTable; /**< Fetched instructions that have not been scheduled yet, in program order */
+      uint32_t reservationTableSize; /**< Maximum number of instructions in the reservation table */
+      bool fetchStalled; /**< A control instruction or COMMIT is in the reservation table, PC is not known after it */
+      bool failed; /**< The machine was stopped by an error instead of a COMMIT */
+      cu_sched_policy * schedPolicy; /**< Selects the CU that receives each memory and execute instruction */
 
       TIMERS_COUNTERS_GUARD(
         std::string su_timer_name;
@@ -46,7 +55,7 @@ namespace scm {
 
     public: 
       fetch_decode_module() = delete;
-      fetch_decode_module(inst_mem_module * const inst_mem, control_store_module * const, bool * const aliveSig, ILP_MODES ilp_mode);
+      fetch_decode_module(inst_mem_module * const inst_mem, reg_file_module * const reg_file, control_store_module * const, bool * const aliveSig, ILP_MODES ilp_mode, SCHED_POLICIES sched_policy = SCHED_POLICIES::ROUND_ROBIN, uint32_t suNumber = 0);
 
       /** \brief logic to execute an instruction
        * 
@@ -62,12 +71,31 @@ namespace scm {
       inline void executeArithmeticInstructions(decoded_instruction_t * inst);
 
 
-      /** \brief logic to execute an arithmetic instruction
+      /** \brief logic to assign a memory or execute instruction
        *
-       *  We select a CU and we assign a new codelet to it. When it is done, we delete the codelet
+       *  The scheduling policy selects a CU and we assign the instruction to it
        */
       inline bool attemptAssignExecuteInstruction(decoded_instruction_t * inst);
 
+      /** \brief fetch and decode instructions into the reservation table
+       *
+       *  Fetching continues ahead of the instructions that are waiting to be scheduled until 
+       *  the reservation table is full, or until a control instruction or a COMMIT is found. The 
+       *  PC after them is not known until they are executed. Fetched instructions go through 
+       *  the rename stage before they are added to the table.
+       *  \returns true if a new instruction was added to the reservation table
+       */
+      inline bool fetchInstructions();
+
+      /** \brief schedule the ready instructions of the reservation table
+       *
+       *  Instructions are visited from the oldest to the youngest. Any instruction without a hazard
+       *  with the instructions in flight, nor with the older instructions that remain in the table, 
+       *  is scheduled. Control and arithmetic instructions are executed in the SU, memory 
+       *  and execute instructions are assigned to a free CU. 
+       */
+      inline void scheduleReservationTable();
+
       /** \brief get the SU number
        *
        *  We select a CU and we assign a new codelet to it. When it is done, we delete the codelet
@@ -77,9 +105,27 @@ namespace scm {
       /** Actual logic of this unit
        * 
        * Implements the actual behavior logic of the fetch decode unit
+       * \returns 0 if the program finished with a COMMIT, 1 if an error stopped the machine
        */
       int behavior();
 
+      /** \brief an error stopped the machine in the last run
+       */
+      inline bool hasFailed() const { return this->failed; }
+
+      /** \brief prepare the SU to run the program from the beginning
+       *
+       *  The program in the instruction memory may have changed, so the rename stage 
+       *  takes its physical registers again. The previous run must have finished
+       */
+      void reset();
+
+      /** \brief get the scheduling policy
+       */
+      inline cu_sched_policy * getSchedPolicy() { return this->schedPolicy; }
+
+      ~fetch_decode_module() { delete this->schedPolicy; }
+
       TIMERS_COUNTERS_GUARD(
         void setTimerCounter(timers_counters * newTC) { 
           this->time_cnt_m = newTC; 
@@ -11,10 +11,11 @@
 #include "SCMUlate_tools.hpp"
 #include "system_config.hpp"
 #include "instructions.hpp"
-#include <set>
+#include <vector>
 #include <string>
 #include <queue>
 #include <limits>
+#include <algorithm>
 
 /**
  * Potential hazards:
@@ -34,7 +35,7 @@
  * instruction, marking the register busy, since we do not allow yet to have a 
  * copy of the operand in the reservation table. This would be costly as we are 
  * relying on whole copies to the register which go all the way to DRAM. 
- * Instead a register renaming scheme would solve this issue
+ * Instead a register renaming scheme solves this issue for the large registers (see register_rename.hpp)
  * 
  * 
  * Write after write: You cannot write until the first write is done.
@@ -83,70 +84,337 @@ namespace scm {
       return (this->memoryAddress == other.memoryAddress && this->size == other.size);
     }
   };
-  struct register_reservation
-  {
-    std::string reg_name;
-    std::uint_fast16_t reg_direction;
-    register_reservation() : reg_name(""), reg_direction(OP_IO::NO_RD_WR) {}
-    register_reservation(const register_reservation &other) : reg_name(other.reg_name), reg_direction(other.reg_direction) {}
-    register_reservation(std::string name, std::uint_fast16_t mask) : reg_name(name), reg_direction(mask) {}
-    inline bool operator<(const register_reservation &other) const
-    {
-      return this->reg_name < other.reg_name;
-    }
+  /** \brief Register scoreboard
+   *
+   *  Keeps, for every register, the number of scheduled instructions that read it and
+   *  whether a scheduled instruction writes it. Registers are indexed by their dense ID 
+   *  (see reg_file_module::getRegisterId), so checking, marking and releasing a register
+   *  is O(1) and does not allocate. Several readers of the same register are allowed at
+   *  the same time, while a writer requires the register to be free.
+   */
+  class register_scoreboard {
+    private:
+      std::vector<uint64_t> writers;
+      std::vector<uint16_t> readers;
+      uint32_t num_reservations;
+    public:
+      register_scoreboard(uint32_t numRegisters) : 
+        writers((numRegisters + 63) / 64, 0), 
+        readers(numRegisters, 0), 
+        num_reservations(0) { }
+
+      inline bool isWritten(uint32_t id) { return (writers[id >> 6] >> (id & 63)) & 1; }
+      inline uint16_t numReaders(uint32_t id) { return readers[id]; }
+      /** \brief Number of reservations that have not been released yet
+       */
+      inline uint32_t numReservations() { return num_reservations; }
+
+      /** \brief Is there a hazard (RAW, WAR or WAW) if the register is accessed with io_dir
+       *  io_dir uses the OP1_RD and OP1_WR bits
+       */
+      inline bool hazardExist(uint32_t id, uint_fast16_t io_dir) {
+        return isWritten(id) || ((io_dir & OP_IO::OP1_WR) && readers[id] != 0);
+      }
+      inline void mark(uint32_t id, uint_fast16_t io_dir) {
+        if (io_dir & OP_IO::OP1_WR)
+          writers[id >> 6] |= (uint64_t(1) << (id & 63));
+        if (io_dir & OP_IO::OP1_RD)
+          readers[id]++;
+        num_reservations++;
+      }
+      inline void release(uint32_t id, uint_fast16_t io_dir) {
+        if (io_dir & OP_IO::OP1_WR)
+          writers[id >> 6] &= ~(uint64_t(1) << (id & 63));
+        if ((io_dir & OP_IO::OP1_RD) && readers[id] != 0)
+          readers[id]--;
+        if (num_reservations != 0)
+          num_reservations--;
+      }
+      /** \brief release all the registers
+       */
+      inline void clear() {
+        std::fill(writers.begin(), writers.end(), 0);
+        std::fill(readers.begin(), readers.end(), 0);
+        num_reservations = 0;
+      }
   };
 
+  /** \brief Interval tree of memory ranges
+   *
+   *  AVL tree ordered by the start of the ranges, where every node keeps the largest end
+   *  address of its subtree. Insert, remove and overlap queries are O(log n). The same 
+   *  range can be inserted multiple times (multiset), and each remove deletes one copy.
+   *  Ranges are half open [start, start + size), ranges of size 0 never overlap.
+   *
+   *  Nodes live in a vector and are recycled through a free list, so once the tree 
+   *  has grown to the number of ranges in flight it does not allocate anymore.
+   */
+  class memory_interval_tree {
+    private:
+      struct interval_node {
+        uint64_t low;
+        uint64_t high;
+        uint64_t max_high;
+        int32_t left;
+        int32_t right;
+        int32_t height;
+      };
+      std::vector<interval_node> nodes;
+      std::vector<int32_t> free_nodes;
+      int32_t root;
+      uint32_t count;
+
+      inline int32_t height(int32_t n) { return n < 0 ? 0 : nodes[n].height; }
+      inline uint64_t maxHigh(int32_t n) { return n < 0 ? 0 : nodes[n].max_high; }
+      inline bool isLess(uint64_t low, uint64_t high, int32_t n) { 
+        return low < nodes[n].low || (low == nodes[n].low && high < nodes[n].high);
+      }
+
+      inline int32_t newNode(uint64_t low, uint64_t high) {
+        int32_t n;
+        if (free_nodes.empty()) {
+          n = nodes.size();
+          nodes.push_back(interval_node());
+        } else {
+          n = free_nodes.back();
+          free_nodes.pop_back();
+        }
+        nodes[n] = {low, high, high, -1, -1, 1};
+        return n;
+      }
+
+      inline void update(int32_t n) {
+        interval_node & node = nodes[n];
+        node.height = 1 + std::max(height(node.left), height(node.right));
+        node.max_high = std::max(node.high, std::max(maxHigh(node.left), maxHigh(node.right)));
+      }
+
+      inline int32_t rotateRight(int32_t n) {
+        int32_t l = nodes[n].left;
+        nodes[n].left = nodes[l].right;
+        nodes[l].right = n;
+        update(n);
+        update(l);
+        return l;
+      }
+
+      inline int32_t rotateLeft(int32_t n) {
+        int32_t r = nodes[n].right;
+        nodes[n].right = nodes[r].left;
+        nodes[r].left = n;
+        update(n);
+        update(r);
+        return r;
+      }
+
+      inline int32_t balance(int32_t n) {
+        update(n);
+        int32_t factor = height(nodes[n].left) - height(nodes[n].right);
+        if (factor > 1) {
+          if (height(nodes[nodes[n].left].left) < height(nodes[nodes[n].left].right))
+            nodes[n].left = rotateLeft(nodes[n].left);
+          return rotateRight(n);
+        }
+        if (factor < -1) {
+          if (height(nodes[nodes[n].right].right) < height(nodes[nodes[n].right].left))
+            nodes[n].right = rotateRight(nodes[n].right);
+          return rotateLeft(n);
+        }
+        return n;
+      }
+
+      int32_t insert(int32_t n, uint64_t low, uint64_t high) {
+        if (n < 0)
+          return newNode(low, high);
+        if (isLess(low, high, n)) {
+          int32_t child = insert(nodes[n].left, low, high);
+          nodes[n].left = child;
+        } else {
+          int32_t child = insert(nodes[n].right, low, high);
+          nodes[n].right = child;
+        }
+        return balance(n);
+      }
+
+      // Detach the leftmost node of the subtree, it is returned in min
+      int32_t removeMin(int32_t n, int32_t & min) {
+        if (nodes[n].left < 0) {
+          min = n;
+          return nodes[n].right;
+        }
+        int32_t child = removeMin(nodes[n].left, min);
+        nodes[n].left = child;
+        return balance(n);
+      }
+
+      int32_t remove(int32_t n, uint64_t low, uint64_t high, bool & removed) {
+        if (n < 0)
+          return n;
+        if (nodes[n].low == low && nodes[n].high == high) {
+          removed = true;
+          free_nodes.push_back(n);
+          int32_t left = nodes[n].left, right = nodes[n].right;
+          if (left < 0) return right;
+          if (right < 0) return left;
+          int32_t min = -1;
+          right = removeMin(right, min);
+          nodes[min].left = left;
+          nodes[min].right = right;
+          return balance(min);
+        }
+        if (isLess(low, high, n)) {
+          int32_t child = remove(nodes[n].left, low, high, removed);
+          nodes[n].left = child;
+        } else {
+          int32_t child = remove(nodes[n].right, low, high, removed);
+          nodes[n].right = child;
+        }
+        return balance(n);
+      }
+
+    public:
+      memory_interval_tree() : root(-1), count(0) { }
+      inline uint32_t size() { return count; }
+      /** \brief remove all the ranges. The nodes keep their memory
+       */
+      inline void clear() {
+        nodes.clear();
+        free_nodes.clear();
+        root = -1;
+        count = 0;
+      }
+
+      inline void insert(uint64_t low, uint64_t high) {
+        root = insert(root, low, high);
+        count++;
+      }
+
+      /** \brief remove one copy of the range
+       *  \returns false if the range was not in the tree
+       */
+      inline bool remove(uint64_t low, uint64_t high) {
+        bool removed = false;
+        root = remove(root, low, high, removed);
+        if (removed)
+          count--;
+        return removed;
+      }
+
+      /** \brief does any range of the tree overlap [low, high)
+       */
+      inline bool overlaps(uint64_t low, uint64_t high) {
+        if (low >= high)
+          return false;
+        int32_t n = root;
+        while (n >= 0) {
+          interval_node & node = nodes[n];
+          if (node.low < high && low < node.high && node.low < node.high)
+            return true;
+          // If there is an overlap in the tree and the left subtree reaches low, it must be in the left subtree
+          if (node.left >= 0 && nodes[node.left].max_high > low)
+            n = node.left;
+          else
+            n = node.right;
+        }
+        return false;
+      }
+  };
+
+  /** \brief Memory hazards between the memory instructions in flight
+   *
+   *  Reads and writes are kept in separate interval trees. Reading a range conflicts
+   *  only with the writes in flight that overlap it (RAW and WAR), while writing a range
+   *  conflicts with any overlapping access (WAW, WAR and RAW). Overlapping reads can be
+   *  in flight at the same time.
+   */
   class memory_queue_controller {
     private:
-      // Ranges are exclusive on begining and end
-      std::set<memory_location> ranges;
+      memory_interval_tree reads;
+      memory_interval_tree writes;
+
+      static inline uint64_t lowerLimit(memory_location& loc) { return reinterpret_cast<uint64_t>(loc.memoryAddress); }
+      static inline uint64_t upperLimit(memory_location& loc) { return reinterpret_cast<uint64_t>(loc.memoryAddress) + loc.size; }
     public:
       memory_queue_controller() { };
-      uint32_t inline numberOfRanges () { return ranges.size(); }
-      void inline addRange(memory_location& curLocation) {
-        SCMULATE_INFOMSG(0, "Adding range [%lu. %lu]",(unsigned long)curLocation.memoryAddress, (unsigned long)curLocation.memoryAddress+curLocation.size );
-        this->ranges.insert(curLocation);
-      }
-      void inline removeRange(memory_location& curLocation) {
-        SCMULATE_INFOMSG(0, "Adding range [%lu. %lu]",(unsigned long)curLocation.memoryAddress, (unsigned long)curLocation.memoryAddress+curLocation.size );
-        this->ranges.erase(curLocation);
-      }
-      bool inline itOverlaps(memory_location& curLocation) {
-        // The start of the curLocation cannot be in between a beginning and end of the range
-        // The end of the curLocation cannot be between a beginning and end
-        auto itRange = ranges.begin();
-        bool res = false;
-        for (; itRange != ranges.end(); itRange++) {
-          if (itRange->memoryAddress < curLocation.memoryAddress && itRange->upperLimit() > curLocation.memoryAddress) {
-            res = true;
-            break;
-          }
-          if (itRange->memoryAddress < curLocation.upperLimit() && itRange->upperLimit() > curLocation.upperLimit()) {
-            res = true;
-            break;
-          }
-          if (itRange->memoryAddress > curLocation.upperLimit() && itRange->upperLimit() > curLocation.upperLimit())
-            break;
-        }
-        return res;
+      uint32_t inline numberOfRanges () { return reads.size() + writes.size(); }
+      void inline clear() {
+        reads.clear();
+        writes.clear();
+      }
+      void inline addRange(memory_location& curLocation, bool isWrite) {
+        SCMULATE_INFOMSG(5, "Adding range [%lu, %lu)", lowerLimit(curLocation), upperLimit(curLocation));
+        (isWrite ? writes : reads).insert(lowerLimit(curLocation), upperLimit(curLocation));
+      }
+      void inline removeRange(memory_location& curLocation, bool isWrite) {
+        SCMULATE_INFOMSG(5, "Removing range [%lu, %lu)", lowerLimit(curLocation), upperLimit(curLocation));
+        if (!(isWrite ? writes : reads).remove(lowerLimit(curLocation), upperLimit(curLocation)))
+          SCMULATE_ERROR(0, "Removing range [%lu, %lu) that was not added", lowerLimit(curLocation), upperLimit(curLocation));
+      }
+      bool inline itOverlaps(memory_location& curLocation, bool isWrite) {
+        uint64_t low = lowerLimit(curLocation), high = upperLimit(curLocation);
+        if (writes.overlaps(low, high))
+          return true;
+        return isWrite && reads.overlaps(low, high);
       }
   };
 
   class ilp_superscalar {
     private:
       memory_queue_controller memCtrl;
-      std::set<register_reservation> busyRegisters;
-      //std::queue<decoded_instruction_t> reservationTable;
-      std::set<memory_location> memoryLocations;
+      register_scoreboard busyRegisters;
+      // Older instructions of the reservation table that have not been scheduled yet
+      register_scoreboard pendingRegisters;
+      std::vector<decoded_instruction_t *> pendingInstructions;
+      uint32_t pendingMemReads;
+      uint32_t pendingMemWrites;
+
+      static inline bool accessesMemory(decoded_instruction_t * inst) {
+        return inst->getType() == instType::MEMORY_INST && inst->getOpcode() != OPC_LDIMM;
+      }
+      static inline bool writesMemory(decoded_instruction_t * inst) {
+        return inst->getOpcode() == OPC_STADR || inst->getOpcode() == OPC_STOFF;
+      }
+
+      /** \brief Is there a hazard with an older instruction that is still in the reservation table
+       *  Registers follow the same rules as the scheduled instructions. The address of a pending 
+       *  memory instruction may not be known yet, so a memory access does not bypass an older 
+       *  pending write, and a write does not bypass any older pending memory access.
+       */
+      bool inline pendingHazardExist(decoded_instruction_t * inst) {
+        if (pendingInstructions.empty())
+          return false;
+        if (inst->getType() == instType::COMMIT)
+          return true;
+        if (accessesMemory(inst) && (pendingMemWrites != 0 || (writesMemory(inst) && pendingMemReads != 0)))
+          return true;
+        if (inst->getOp1().type == operand_t::REGISTER && pendingRegisters.hazardExist(inst->getOp1().value.reg.reg_id, inst->getOpIO() & (OP_IO::OP1_RD | OP_IO::OP1_WR)))
+          return true;
+        if (inst->getOp2().type == operand_t::REGISTER && pendingRegisters.hazardExist(inst->getOp2().value.reg.reg_id, (inst->getOpIO() & (OP_IO::OP2_RD | OP_IO::OP2_WR))>>2))
+          return true;
+        if (inst->getOp3().type == operand_t::REGISTER && pendingRegisters.hazardExist(inst->getOp3().value.reg.reg_id, (inst->getOpIO() & (OP_IO::OP3_RD | OP_IO::OP3_WR))>>4))
+          return true;
+        return false;
+      }
+
     public:
-      ilp_superscalar() { }
+      /** \param numRegisters registers of the register file (see reg_file_module::numRegisters)
+       */
+      ilp_superscalar(uint32_t numRegisters) : 
+        busyRegisters(numRegisters), 
+        pendingRegisters(numRegisters), 
+        pendingMemReads(0), 
+        pendingMemWrites(0) { 
+        pendingInstructions.reserve(RESERVATION_TABLE_SIZE);
+      }
       /** \brief check if instruction can be scheduled 
       * Returns true if the instruction could be scheduled according to
       * the current detected hazards. If it is possible to schedule it, then
       * it will add the list of detected hazards to the tracking tables
       */
       bool inline checkMarkInstructionToSched(decoded_instruction_t * inst, bool markAsync = true) {
-        if (inst->getType() == instType::COMMIT && (busyRegisters.size() != 0 || memCtrl.numberOfRanges() != 0))
+        if (pendingHazardExist(inst))
+          return false;
+        if (inst->getType() == instType::COMMIT && (busyRegisters.numReservations() != 0 || memCtrl.numberOfRanges() != 0))
           return false;
         // In memory instructions we need to figure out if there is a hazard in the memory
         if (inst->getType() == instType::MEMORY_INST) {
@@ -154,15 +422,15 @@ namespace scm {
           int32_t size_dest = inst->getOp1().value.reg.reg_size_bytes;
           unsigned long base_addr = 0;
           unsigned long offset = 0;
-          if (hazardExist(inst->getOp1().value.reg.reg_name, inst->getOpIO() & (OP_IO::OP1_RD | OP_IO::OP1_WR))) {
+          if (hazardExist(inst->getOp1().value.reg, inst->getOpIO() & (OP_IO::OP1_RD | OP_IO::OP1_WR))) {
             return false;
-          } else if (inst->getInstruction() != "LDIMM") {
+          } else if (inst->getOpcode() != OPC_LDIMM) {
             // Check for the memory address
             if (inst->getOp2().type == operand_t::IMMEDIATE_VAL) {
               // Load address immediate value
               base_addr = inst->getOp2().value.immediate;
             } else if (inst->getOp2().type == operand_t::REGISTER) {
-              if (hazardExist(inst->getOp2().value.reg.reg_name, (inst->getOpIO() & (OP_IO::OP2_RD | OP_IO::OP2_WR))>>2))
+              if (hazardExist(inst->getOp2().value.reg, (inst->getOpIO() & (OP_IO::OP2_RD | OP_IO::OP2_WR))>>2))
                 return false;
               // Load address register value
               decoded_reg_t reg = inst->getOp2().value.reg;
@@ -180,12 +448,12 @@ namespace scm {
             }
 
             // Check for offset only on the instructions with such operand
-            if (inst->getInstruction() == "LDOFF" || inst->getInstruction() == "STOFF") {
+            if (inst->getOpcode() == OPC_LDOFF || inst->getOpcode() == OPC_STOFF) {
               if (inst->getOp3().type == operand_t::IMMEDIATE_VAL) {
                 // Load address immediate value
                 offset = inst->getOp3().value.immediate;
               } else if (inst->getOp3().type == operand_t::REGISTER) {
-                if (hazardExist(inst->getOp3().value.reg.reg_name, (inst->getOpIO() & (OP_IO::OP3_RD | OP_IO::OP3_WR))>>4))
+                if (hazardExist(inst->getOp3().value.reg, (inst->getOpIO() & (OP_IO::OP3_RD | OP_IO::OP3_WR))>>4))
                   return false;
                 // Load address register value
                 decoded_reg_t reg = inst->getOp3().value.reg;
@@ -203,21 +471,22 @@ namespace scm {
               }
             }
             memory_location newRange (reinterpret_cast<l2_memory_t> (base_addr + offset), size_dest);
-            if (memCtrl.itOverlaps( newRange ))
+            bool isWrite = writesMemory(inst);
+            if (memCtrl.itOverlaps( newRange, isWrite ))
               return false;
 
             if (markAsync){
               // The instruction is ready to schedule
-              memCtrl.addRange(newRange);
+              memCtrl.addRange(newRange, isWrite);
             }
           }
 
         } else {
-          if (inst->getOp1().type == operand_t::REGISTER && hazardExist(inst->getOp1().value.reg.reg_name, (inst->getOpIO() & (OP_IO::OP1_RD | OP_IO::OP1_WR))))
+          if (inst->getOp1().type == operand_t::REGISTER && hazardExist(inst->getOp1().value.reg, (inst->getOpIO() & (OP_IO::OP1_RD | OP_IO::OP1_WR))))
             return false;
-          if (inst->getOp2().type == operand_t::REGISTER && hazardExist(inst->getOp2().value.reg.reg_name, (inst->getOpIO() & (OP_IO::OP2_RD | OP_IO::OP2_WR))>>2)) 
+          if (inst->getOp2().type == operand_t::REGISTER && hazardExist(inst->getOp2().value.reg, (inst->getOpIO() & (OP_IO::OP2_RD | OP_IO::OP2_WR))>>2)) 
             return false;
-          if (inst->getOp3().type == operand_t::REGISTER && hazardExist(inst->getOp3().value.reg.reg_name, (inst->getOpIO() & (OP_IO::OP3_RD | OP_IO::OP3_WR))>>4)) 
+          if (inst->getOp3().type == operand_t::REGISTER && hazardExist(inst->getOp3().value.reg, (inst->getOpIO() & (OP_IO::OP3_RD | OP_IO::OP3_WR))>>4)) 
             return false;
         }
 
@@ -225,21 +494,18 @@ namespace scm {
           // Mark the registers
           if (inst->getOp1().type == operand_t::REGISTER) {
             uint_fast16_t io = inst->getOpIO() & (OP_IO::OP1_RD | OP_IO::OP1_WR);
-            SCMULATE_INFOMSG(5, "Mariking register %s as busy with IO %lX", inst->getOp1().value.reg.reg_name.c_str(), io);
-            register_reservation reserv(inst->getOp1().value.reg.reg_name, io);
-            busyRegisters.insert(reserv);
+            SCMULATE_INFOMSG(5, "Mariking register R%s_%u as busy with IO %lX", reg_file_module::getRegisterSizeName(inst->getOp1().value.reg.reg_size_class), inst->getOp1().value.reg.reg_number, io);
+            busyRegisters.mark(inst->getOp1().value.reg.reg_id, io);
           }
           if (inst->getOp2().type == operand_t::REGISTER) {
             uint_fast16_t io = (inst->getOpIO() & (OP_IO::OP2_RD | OP_IO::OP2_WR)) >> 2;
-            SCMULATE_INFOMSG(5, "Mariking register %s as busy with IO %lX", inst->getOp2().value.reg.reg_name.c_str(), io);
-            register_reservation reserv(inst->getOp2().value.reg.reg_name, io);
-            busyRegisters.insert(reserv);          
+            SCMULATE_INFOMSG(5, "Mariking register R%s_%u as busy with IO %lX", reg_file_module::getRegisterSizeName(inst->getOp2().value.reg.reg_size_class), inst->getOp2().value.reg.reg_number, io);
+            busyRegisters.mark(inst->getOp2().value.reg.reg_id, io);          
             }
           if (inst->getOp3().type == operand_t::REGISTER) {
             uint_fast16_t io = (inst->getOpIO() & (OP_IO::OP3_RD | OP_IO::OP3_WR)) >> 4;
-            SCMULATE_INFOMSG(5, "Mariking register %s as busy with IO %lX", inst->getOp3().value.reg.reg_name.c_str(), io);
-            register_reservation reserv(inst->getOp3().value.reg.reg_name, io);
-            busyRegisters.insert(reserv);          
+            SCMULATE_INFOMSG(5, "Mariking register R%s_%u as busy with IO %lX", reg_file_module::getRegisterSizeName(inst->getOp3().value.reg.reg_size_class), inst->getOp3().value.reg.reg_number, io);
+            busyRegisters.mark(inst->getOp3().value.reg.reg_id, io);          
             }
         }
         return true;
@@ -251,7 +517,7 @@ namespace scm {
           int32_t size_dest = inst->getOp1().value.reg.reg_size_bytes;
           unsigned long base_addr = 0;
           unsigned long offset = 0;
-          if (inst->getInstruction() != "LDIMM") {
+          if (inst->getOpcode() != OPC_LDIMM) {
             // Check for the memory address
             if (inst->getOp2().type == operand_t::IMMEDIATE_VAL) {
               // Load address immediate value
@@ -270,7 +536,7 @@ namespace scm {
             }
 
             // Check for offset only on the instructions with such operand
-            if (inst->getInstruction() == "LDOFF" || inst->getInstruction() == "STOFF") {
+            if (inst->getOpcode() == OPC_LDOFF || inst->getOpcode() == OPC_STOFF) {
               if (inst->getOp3().type == operand_t::IMMEDIATE_VAL) {
                 // Load address immediate value
                 offset = inst->getOp3().value.immediate;
@@ -288,38 +554,79 @@ namespace scm {
               }
             }
             memory_location newRange (reinterpret_cast<l2_memory_t> (base_addr + offset), size_dest);
-            memCtrl.removeRange( newRange );
+            memCtrl.removeRange( newRange, writesMemory(inst) );
           }
         }
 
         if (inst->getOp1().type == operand_t::REGISTER) {
           uint_fast16_t io = (inst->getOpIO() & (OP_IO::OP1_RD | OP_IO::OP1_WR));
-          SCMULATE_INFOMSG(5, "Unmariking register %s as busy with IO %lX", inst->getOp1().value.reg.reg_name.c_str(), io );
-          eraseReg(inst->getOp1().value.reg.reg_name, io);
+          SCMULATE_INFOMSG(5, "Unmariking register R%s_%u as busy with IO %lX", reg_file_module::getRegisterSizeName(inst->getOp1().value.reg.reg_size_class), inst->getOp1().value.reg.reg_number, io );
+          eraseReg(inst->getOp1().value.reg, io);
         }
         if (inst->getOp2().type == operand_t::REGISTER) {
           uint_fast16_t io = (inst->getOpIO() & (OP_IO::OP2_RD | OP_IO::OP2_WR)) >> 2;
-          SCMULATE_INFOMSG(5, "Unmariking register %s as busy with IO %lX",inst->getOp2().value.reg.reg_name.c_str(), io );
-          eraseReg(inst->getOp2().value.reg.reg_name, io);
+          SCMULATE_INFOMSG(5, "Unmariking register R%s_%u as busy with IO %lX", reg_file_module::getRegisterSizeName(inst->getOp2().value.reg.reg_size_class), inst->getOp2().value.reg.reg_number, io );
+          eraseReg(inst->getOp2().value.reg, io);
         }
         if (inst->getOp3().type == operand_t::REGISTER) {
           uint_fast16_t io = (inst->getOpIO() & (OP_IO::OP3_RD | OP_IO::OP3_WR)) >> 4;
-          SCMULATE_INFOMSG(5, "Unmariking register %s as busy with IO %lX",inst->getOp3().value.reg.reg_name.c_str(), io);
-          eraseReg(inst->getOp3().value.reg.reg_name, io);
+          SCMULATE_INFOMSG(5, "Unmariking register R%s_%u as busy with IO %lX", reg_file_module::getRegisterSizeName(inst->getOp3().value.reg.reg_size_class), inst->getOp3().value.reg.reg_number, io);
+          eraseReg(inst->getOp3().value.reg, io);
         }
-        SCMULATE_INFOMSG(5, "The number of busy regs is %lu", this->busyRegisters.size());
+        SCMULATE_INFOMSG(5, "The number of busy regs is %u", this->busyRegisters.numReservations());
       }
 
-      bool inline hazardExist(std::string& regName, uint_fast16_t io_dir) { 
-        auto foundReg = busyRegisters.find(register_reservation(regName, io_dir));
-        bool isFound = busyRegisters.find(register_reservation(regName, io_dir)) != busyRegisters.end();
-        SCMULATE_INFOMSG_IF(5, isFound, "Hazard detected");
-        if (!isFound) return false;
-        if ((foundReg->reg_direction & OP_IO::OP1_WR) | (io_dir & OP_IO::OP1_WR)) return true; // WAW or RAW or WAR
-        return false;
+      /** \brief the instruction stays in the reservation table
+       *  The instructions checked after it in the same pass of the reservation table are younger,
+       *  and they cannot bypass it if they depend on it. 
+       */
+      void inline instructionPending(decoded_instruction_t * inst) {
+        pendingInstructions.push_back(inst);
+        if (accessesMemory(inst))
+          (writesMemory(inst) ? pendingMemWrites : pendingMemReads)++;
+        if (inst->getOp1().type == operand_t::REGISTER)
+          pendingRegisters.mark(inst->getOp1().value.reg.reg_id, inst->getOpIO() & (OP_IO::OP1_RD | OP_IO::OP1_WR));
+        if (inst->getOp2().type == operand_t::REGISTER)
+          pendingRegisters.mark(inst->getOp2().value.reg.reg_id, (inst->getOpIO() & (OP_IO::OP2_RD | OP_IO::OP2_WR)) >> 2);
+        if (inst->getOp3().type == operand_t::REGISTER)
+          pendingRegisters.mark(inst->getOp3().value.reg.reg_id, (inst->getOpIO() & (OP_IO::OP3_RD | OP_IO::OP3_WR)) >> 4);
+      }
+
+      /** \brief the pass over the reservation table is over, forget the pending instructions
+       */
+      void inline reservationTableScanned() {
+        for (decoded_instruction_t * inst : pendingInstructions) {
+          if (inst->getOp1().type == operand_t::REGISTER)
+            pendingRegisters.release(inst->getOp1().value.reg.reg_id, inst->getOpIO() & (OP_IO::OP1_RD | OP_IO::OP1_WR));
+          if (inst->getOp2().type == operand_t::REGISTER)
+            pendingRegisters.release(inst->getOp2().value.reg.reg_id, (inst->getOpIO() & (OP_IO::OP2_RD | OP_IO::OP2_WR)) >> 2);
+          if (inst->getOp3().type == operand_t::REGISTER)
+            pendingRegisters.release(inst->getOp3().value.reg.reg_id, (inst->getOpIO() & (OP_IO::OP3_RD | OP_IO::OP3_WR)) >> 4);
+        }
+        pendingInstructions.clear();
+        pendingMemReads = 0;
+        pendingMemWrites = 0;
+      }
+
+      /** \brief forget the instructions of the previous run, including the ones that were
+       *  in flight when an error stopped the machine
+       */
+      void inline reset() {
+        memCtrl.clear();
+        busyRegisters.clear();
+        pendingRegisters.clear();
+        pendingInstructions.clear();
+        pendingMemReads = 0;
+        pendingMemWrites = 0;
       }
-      void inline eraseReg(std::string& regName, uint_fast16_t io_dir) { 
-       busyRegisters.erase(register_reservation(regName, io_dir));
+
+      bool inline hazardExist(decoded_reg_t& reg, uint_fast16_t io_dir) { 
+        bool hazard = busyRegisters.hazardExist(reg.reg_id, io_dir); // WAW or RAW or WAR
+        SCMULATE_INFOMSG_IF(5, hazard, "Hazard detected");
+        return hazard;
+      }
+      void inline eraseReg(decoded_reg_t& reg, uint_fast16_t io_dir) { 
+        busyRegisters.release(reg.reg_id, io_dir);
       }
   };
 
@@ -338,6 +645,11 @@ namespace scm {
       void inline instructionFinished() {
         sequential_sw = true;
       }
+      /** \brief the COMMIT of the previous run never finishes, so it is released here
+       */
+      void inline reset() {
+        sequential_sw = true;
+      }
   };
 
   class ilp_controller {
@@ -345,7 +657,7 @@ namespace scm {
       ilp_sequential seq_ctrl;
       ilp_superscalar supscl_ctrl;
     public:
-      ilp_controller (ILP_MODES ilp_mode) : SCMULATE_ILP_MODE(ilp_mode) {
+      ilp_controller (ILP_MODES ilp_mode, uint32_t numRegisters) : SCMULATE_ILP_MODE(ilp_mode), supscl_ctrl(numRegisters) {
         SCMULATE_INFOMSG_IF(3, SCMULATE_ILP_MODE == ILP_MODES::SEQUENTIAL, "Using %d ILP_MODES::SEQUENTIAL",SCMULATE_ILP_MODE );
         SCMULATE_INFOMSG_IF(3, SCMULATE_ILP_MODE == ILP_MODES::SUPERSCALAR, "Using %d ILP_MODES::SUPERSCALAR", SCMULATE_ILP_MODE);
        }
@@ -372,6 +684,28 @@ namespace scm {
           SCMULATE_ERROR(0, "What are you doing here?");
         }
       }
+      /** \brief Number of entries of the reservation table. The sequential mode keeps a single
+       *  instruction so they are scheduled in program order
+       */
+      uint32_t inline reservationTableSize() {
+        return (SCMULATE_ILP_MODE == ILP_MODES::SUPERSCALAR) ? RESERVATION_TABLE_SIZE : 1;
+      }
+      void inline instructionPending(decoded_instruction_t * inst) {
+        if (SCMULATE_ILP_MODE  == ILP_MODES::SUPERSCALAR)
+          supscl_ctrl.instructionPending(inst);
+      }
+      void inline reservationTableScanned() {
+        if (SCMULATE_ILP_MODE  == ILP_MODES::SUPERSCALAR)
+          supscl_ctrl.reservationTableScanned();
+      }
+      /** \brief prepare the hazard tracking for a new run. No instruction can be in flight
+       */
+      void inline reset() {
+        if (SCMULATE_ILP_MODE == ILP_MODES::SEQUENTIAL)
+          seq_ctrl.reset();
+        else
+          supscl_ctrl.reset();
+      }
   };
 
 } // namespace scm
@@ -4,7 +4,9 @@
 #include "SCMUlate_tools.hpp"
 #include "instructions.hpp"
 #include "register.hpp"
+#include "program_image.hpp"
 #include <vector>
+#include <deque>
 #include <map>
 #include <string>
 #include <fstream>
@@ -19,13 +21,24 @@ namespace scm {
    * and raise a warning. Additionally, it is possible to fetch any instruction
    * by passing the corresponding address
    *
+   * The memory is a flat array of fixed size decoded instructions. Their source
+   * text is kept in a separate debug side table, that is not touched when the 
+   * instructions are fetched and executed
+   *
    */
   class inst_mem_module {
     private: 
-      std::vector<decoded_instruction_t*> memory;
+      std::vector<decoded_instruction_t> memory;
+      // A deque never moves its elements, so the instructions can point to their text
+      std::deque<inst_text_t> debug_text;
       std::map<std::string, int> labels;
       reg_file_module * reg_file_m;
 
+      /* When the memory is only used to assemble a program into an image
+       * the codelets are not created, so they do not need to be linked
+       */
+      bool assemble_only;
+
       /* This flag checks if the file that is received is a valid flag
        * otherwise it should set it to stop running the machine
        */
@@ -38,18 +51,39 @@ namespace scm {
        */
       bool loader(char * filename);
 
+      /* This method loads a binary program image (see program_image.hpp).
+       * The file is mapped in memory and the instructions are rebuilt in a 
+       * single pass, resolving the registers and codelets by their IDs.
+       * If the image is invalid it will return false.
+       */
+      bool imageLoader(char * filename);
+
+      /* Second pass of the loaders. Once all the labels are known, the 
+       * operand of every JMPLBL is replaced by the absolute PC of its label,
+       * so the branch does not need to look up the label when it executes.
+       * If a label does not exist it will return false.
+       */
+      bool resolveLabels();
+
     public:
       inst_mem_module() = delete;
-      inst_mem_module(char * filename, reg_file_module * const reg_file_m);
+      inst_mem_module(char * filename, reg_file_module * const reg_file_m, bool assembleOnly = false);
+
+      /* This method replaces the program in the memory by the one in the file,
+       * which can be a text program or a binary image. An empty file name reads
+       * the program from stdin. Returns false if the program is not valid
+       */
+      bool load(char * filename);
   
       /* This method allows to fetch an instruction from the instruction 
        * memory by passing the address (PC)
        */
-      inline decoded_instruction_t* fetch(int address) { return memory[address]; };
+      inline decoded_instruction_t* fetch(int address) { return &memory[address]; };
 
       /** \brief translate label to memory
        *
-       *
+       *  Only used for debugging and tools, JMPLBL operands are resolved
+       *  when the program is loaded
        */
       inline int getMemoryLabel(std::string label) { 
         auto it = labels.find(label); 
@@ -61,6 +95,17 @@ namespace scm {
 
       bool isValid() { return this->is_valid; }
 
+      /* Returns true if the file starts with the magic number of a binary
+       * program image. Otherwise it is considered an SCM text program
+       */
+      static bool isImage(char * filename);
+
+      /* This method writes the loaded program as a binary program image
+       * that can be loaded later without parsing the text (assembler mode).
+       * Returns false if the file cannot be written
+       */
+      bool writeImage(char * filename);
+
       inline uint32_t getMemSize() { return this->memory.size(); }
 
       /* This method allows to dump the content of the instruction 
@@ -0,0 +1,67 @@
+#ifndef __L2_MEMORY__
+#define __L2_MEMORY__
+
+/** \brief L2 memory of the machine
+ *
+ * This file contains the L2 memory that a machine can own instead of using an array
+ * given by the host program. It is mapped with huge pages if possible, and its pages 
+ * are zero and they are not allocated until they are touched (see memory_pages.hpp).
+ *
+ * The host program places its arrays with l2Malloc instead of fixed offsets. The address
+ * that an SCM program uses for an array is its offset in the L2 memory (offsetOf).
+ */
+
+#include "SCMUlate_tools.hpp"
+#include "system_config.hpp"
+#include "memory_pages.hpp"
+#include <map>
+#include <cstdint>
+
+namespace scm {
+
+  class l2_memory_module {
+    private:
+      l2_memory_t memory;
+      uint64_t size;
+      PAGE_KINDS pages;
+      std::map<uint64_t, uint64_t> free_ranges; /**< Offset to size of the free ranges, they are never contiguous */
+      std::map<uint64_t, uint64_t> allocations; /**< Offset to size of the allocated arrays */
+
+    public:
+      l2_memory_module() = delete;
+      /** \brief map the memory
+       *  \param memSize bytes of memory, rounded up to HUGE_PAGE_SIZE
+       *  \param hugePages try huge pages first
+       */
+      l2_memory_module(uint64_t memSize, bool hugePages = true);
+
+      inline bool isValid() { return memory != nullptr; }
+      inline l2_memory_t getMemory() { return memory; }
+      inline uint64_t getSize() { return size; }
+      /** \brief kind of pages that were mapped
+       */
+      inline PAGE_KINDS getPages() { return pages; }
+
+      /** \brief allocate an array in the L2 memory (first fit)
+       *  \returns the address of the array, nullptr if there is no free range that is large enough
+       */
+      l2_memory_t l2Malloc(uint64_t bytes, uint64_t alignment = L2_MALLOC_ALIGNMENT);
+      /** \brief release an array allocated with l2Malloc
+       *  \returns false if it was not allocated
+       */
+      bool l2Free(l2_memory_t array);
+      /** \brief bytes that are not allocated
+       */
+      uint64_t freeBytes();
+
+      /** \brief address of an array for the SCM programs, i.e. its offset in the L2 memory
+       */
+      inline uint64_t offsetOf(l2_memory_t array) { return array - memory; }
+      inline l2_memory_t getAddress(uint64_t offset) { return memory + offset; }
+
+      ~l2_memory_module();
+  };
+
+}
+
+#endif // __L2_MEMORY__
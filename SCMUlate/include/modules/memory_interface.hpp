@@ -20,6 +20,8 @@ namespace scm {
     private:
       decoded_instruction_t* myInstructionSlot;
       l2_memory_t memorySpace;
+      uint64_t bytes_read; /**< Bytes loaded from the L2 memory to the registers */
+      uint64_t bytes_written; /**< Bytes stored from the registers to the L2 memory */
 
       // This should only be called by this unit
       inline void emptyInstSlot() {
@@ -41,6 +43,12 @@ namespace scm {
 
       int behavior();
 
+      /** \brief bytes moved by the memory instructions since the last resetCounters
+       */
+      inline uint64_t getBytesRead() { return bytes_read; }
+      inline uint64_t getBytesWritten() { return bytes_written; }
+      inline void resetCounters() { bytes_read = 0; bytes_written = 0; }
+
       /** \brief logic to execute a memory instruction
        *
        *  We execute memory operations according to the provided instruction
@@ -0,0 +1,77 @@
+#ifndef __PROGRAM_IMAGE__
+#define __PROGRAM_IMAGE__
+
+/** \brief Binary program image
+ *
+ * This file describes the layout of a precompiled SCM program. The image is created by the
+ * instruction memory (inst_mem_module::writeImage) after a program has been parsed, and it
+ * can be loaded back by the instruction memory without parsing any text. The loader maps the
+ * file in memory and rebuilds the instructions in a single linear pass, fixing up the 
+ * register pointers against the register file of the machine.
+ *
+ * Layout of the file:
+ *   image_header_t
+ *   image_inst_t     [num_insts]
+ *   image_label_t    [num_labels]
+ *   uint32_t         [num_codelets]  offset in the string table of each codelet name
+ *   char             [strings_size]  string table of '\0' terminated strings
+ *
+ * The image uses the byte order of the host that wrote it. This is checked through 
+ * the byte_order field of the header
+ */
+
+#include <cstdint>
+
+#define SCM_IMAGE_MAGIC 0x424d4353u /* "SCMB" */
+#define SCM_IMAGE_VERSION 1u
+#define SCM_IMAGE_BYTE_ORDER 0x01020304u
+
+namespace scm {
+
+  struct image_header_t {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t num_insts;
+    uint32_t num_labels;
+    uint32_t num_codelets;
+    uint32_t strings_size;
+    uint32_t reserved;
+  };
+
+  /** \brief Operand as stored in the image
+   *
+   *  type follows operand_t (UNKNOWN, REGISTER, IMMEDIATE_VAL). The JMPLBL operand is written
+   *  already resolved as the immediate PC of the label. An UNKNOWN operand with a value
+   *  different than 0 is a label that is still unresolved, value contains the string table
+   *  offset of the label
+   */
+  struct image_operand_t {
+    uint8_t type;
+    uint8_t reg_size_class;
+    uint16_t reserved;
+    uint32_t reg_number;
+    uint64_t value;
+  };
+
+  /** \brief Instruction as stored in the image
+   *
+   *  For CONTROL_INST, BASIC_ARITH_INST and MEMORY_INST, def_index is the position of the
+   *  instruction definition in its group (see instructions_def.hpp). For EXECUTE_INST 
+   *  def_index is the codelet ID, an index in the codelets table of the image
+   */
+  struct image_inst_t {
+    uint8_t type;
+    uint8_t reserved;
+    uint16_t op_in_out;
+    uint32_t def_index;
+    image_operand_t ops[3];
+  };
+
+  struct image_label_t {
+    uint32_t name;
+    uint32_t pc;
+  };
+}
+
+#endif
@@ -3,70 +3,87 @@
 
 #include "register_config.hpp"
 #include "SCMUlate_tools.hpp"
+#include "memory_pages.hpp"
 #include <string>
+#include <string_view>
 #include <iostream>
+#include <algorithm>
 
 namespace scm {
-  typedef union {
-    // the 1000 is because the register file size is in KB
-    unsigned char space[REG_FILE_SIZE_KB*1000];
-    registers_t registers;
-  } register_file_t;
-
   class reg_file_module {
     private: 
-      register_file_t *reg_file;
+      unsigned char * reg_file; /**< Mapped, so all the size classes are in the same huge pages (see memory_pages.hpp) */
+      register_geometry geometry;
+      PAGE_KINDS pages;
     
     public: 
-     reg_file_module();
+     /** \brief map the register file. Its pages are zero, they are only allocated when they are touched
+      *  \param registers size of the register file and number of registers of each size class
+      *  \param hugePages try huge pages first
+      */
+     reg_file_module(const register_geometry & registers = register_geometry(), bool hugePages = true);
+     /** \brief set all the registers to zero
+      */
+     void reset();
+     /** \brief set a part of the registers to zero. The parts are whole pages, so if each CU
+      *  zeroes its part the first touch puts the pages in its NUMA node
+      *  \param part part to zero, from 0 to parts-1
+      */
+     void reset(uint32_t part, uint32_t parts);
+     inline PAGE_KINDS getPages() { return pages; }
      void describeRegisterFile();
+     /** \brief memory of all the registers, e.g. to place it in NUMA nodes
+      */
+     inline unsigned char * getSpace() { return reg_file; }
+     inline size_t getSpaceSize() const { return std::max(geometry.getFileSize(), geometry.getUsedSize()); }
+     inline size_t getMappedSize() const { return (getSpaceSize() + HUGE_PAGE_SIZE - 1)/HUGE_PAGE_SIZE*HUGE_PAGE_SIZE; }
+     inline const register_geometry & getGeometry() const { return geometry; }
      bool checkRegisterConfig();
-     static inline uint32_t getRegisterSizeInBytes(std::string size) {
-       uint32_t result = 0;
-       if (size == "64B")
-         result = 8;
-       else if (size == "1L")
-         result = CACHE_LINE_SIZE;
-       else if (size == "8L")
-         result = CACHE_LINE_SIZE*8;
-       else if (size == "16L")
-         result = CACHE_LINE_SIZE*16;
-       else if (size == "256L")
-         result = CACHE_LINE_SIZE*256;
-       else if (size == "512L")
-         result = CACHE_LINE_SIZE*512;
-       else if (size == "1024L")
-         result = CACHE_LINE_SIZE*1024;
-       else if (size == "2048L")
-         result = CACHE_LINE_SIZE*2048;
-       else
-         SCMULATE_ERROR(0, "DECODED REGISTER DOES NOT EXIST!!!")
-       return result;
+     /** \brief Number of register size classes (64B, 1L, 8L, 16L, 256L, 512L, 1024L, 2048L)
+      */
+     static constexpr uint8_t NUM_REG_SIZE_CLASSES = REG_SIZE_CLASSES;
+
+     /** \brief Translate the size part of a register name into its size class (see register_geometry::parseSizeClass)
+      *  \returns the size class or NUM_REG_SIZE_CLASSES if the size does not exist
+      */
+     static inline REG_SIZE_CLASS getRegisterSizeClass(std::string_view size) {
+       return register_geometry::parseSizeClass(size);
+     }
+     /** \brief Total number of registers of all the size classes
+      */
+     inline uint32_t numRegisters() const { return geometry.numRegisters(); }
+
+     /** \brief Dense register ID, from 0 to numRegisters()-1 (see register_geometry::getRegisterId)
+      *  \returns the ID or numRegisters() if the register does not exist
+      */
+     inline uint32_t getRegisterId(uint8_t sizeClass, uint32_t num) const { return geometry.getRegisterId(sizeClass, num); }
+
+     static inline const char * getRegisterSizeName(uint8_t sizeClass) {
+       return register_geometry::getRegisterSizeName(sizeClass);
+     }
+     static inline uint32_t getRegisterSizeInBytes(uint8_t sizeClass) {
+       if (sizeClass < NUM_REG_SIZE_CLASSES)
+         return register_geometry::getRegisterSizeInBytes(sizeClass);
+       SCMULATE_ERROR(0, "DECODED REGISTER DOES NOT EXIST!!!")
+       return 0;
+     }
+     static inline uint32_t getRegisterSizeInBytes(std::string_view size) {
+       return getRegisterSizeInBytes(getRegisterSizeClass(size));
+     };
+     /** \brief address of a register
+      *  \returns NULL if the size class or the number do not exist, e.g. R2048L_99 with 40 R2048L registers
+      */
+     inline unsigned char * getRegisterByClass(uint8_t sizeClass, uint32_t num) {
+       if (num < geometry.numRegisters(sizeClass))
+         return reg_file + geometry.getOffset(sizeClass, num);
+       SCMULATE_ERROR(0, "DECODED REGISTER R%s_%u DOES NOT EXIST!!!", getRegisterSizeName(sizeClass), num)
+       return NULL;
      };
-     inline unsigned char * getRegisterByName(std::string size, int num) {
-       unsigned char * result = NULL;
-       if (size == "64B")
-         result = REG_64B(num).data;
-       else if (size == "1L")
-         result = REG_1L(num).data;
-       else if (size == "8L")
-         result = REG_8L(num).data;
-       else if (size == "16L")
-         result = REG_16L(num).data;
-       else if (size == "256L")
-         result = REG_256L(num).data;
-       else if (size == "512L")
-         result = REG_512L(num).data;
-       else if (size == "1024L")
-         result = REG_1024L(num).data;
-       else if (size == "2048L")
-         result = REG_2048L(num).data;
-       else
-         SCMULATE_ERROR(0, "DECODED REGISTER DOES NOT EXIST!!!")
-       return result;
+     inline unsigned char * getRegisterByName(std::string_view size, uint32_t num) {
+       return getRegisterByClass(getRegisterSizeClass(size), num);
      };
      void dumpRegisterFile();
-     void dumpRegister(std::string size, int num);
+     void dumpRegister(std::string_view size, uint32_t num);
      ~reg_file_module();
   };
 }
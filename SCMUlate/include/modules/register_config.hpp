@@ -1,12 +1,15 @@
 #ifndef __REGISTER_CONFIG__
 #define __REGISTER_CONFIG__
 
-// Size of L3 in KB
+#include <cstdint>
+#include <string_view>
+
+// Default size of L3 in KB
 #define REG_FILE_SIZE_KB 12288l
 // Cache line in bytes
 #define CACHE_LINE_SIZE 64l
 
-// Number of registers created
+// Default number of registers created. A machine description file can change them (see register_geometry)
 #define NUM_REG_64BITS 160l
 #define NUM_REG_1LINE 140l
 #define NUM_REG_8LINE 100l
@@ -16,76 +19,130 @@
 #define NUM_REG_1024LINE 60l
 #define NUM_REG_2048LINE 40l
 
-#define CALCULATE_REG_SIZE (NUM_REG_64BITS*8l + \
-    (NUM_REG_1LINE + \
-     NUM_REG_8LINE*8l + \
-     NUM_REG_16LINE*16l + \
-     NUM_REG_256LINE*256l + \
-     NUM_REG_512LINE*512l + \
-     NUM_REG_1024LINE*1024l + \
-     NUM_REG_2048LINE*2048l)*CACHE_LINE_SIZE)
-
 namespace scm {
 
-  typedef struct{
-      unsigned char data[8];
-  } _reg_64bits;
-  typedef struct{
-      unsigned char data[CACHE_LINE_SIZE];
-  } _reg_1line;
-  typedef struct{
-      unsigned char data[CACHE_LINE_SIZE*8];
-  } _reg_8line;
-  typedef struct{
-      unsigned char data[CACHE_LINE_SIZE*16];
-  } _reg_16line;
-  typedef struct{
-      unsigned char data[CACHE_LINE_SIZE*256];
-  } _reg_256line;
-  typedef struct{
-      unsigned char data[CACHE_LINE_SIZE*512];
-  } _reg_512line;
-  typedef struct{
-      unsigned char data[CACHE_LINE_SIZE*1024];
-  } _reg_1024line;
-  typedef struct{
-      unsigned char data[CACHE_LINE_SIZE*2048];
-  } _reg_2048line;
-  
-  typedef struct {
-  #if NUM_REG_64BITS != 0
-          _reg_64bits reg_64[NUM_REG_64BITS];
-  #endif
-  #if NUM_REG_1LINE != 0
-          _reg_1line reg_1l[NUM_REG_1LINE];
-  #endif
-  #if NUM_REG_8LINE != 0
-          _reg_8line reg_8l[NUM_REG_8LINE];
-  #endif
-  #if NUM_REG_16LINE != 0
-          _reg_16line reg_16l[NUM_REG_16LINE];
-  #endif
-  #if NUM_REG_256LINE != 0
-          _reg_256line reg_256l[NUM_REG_256LINE];
-  #endif
-  #if NUM_REG_512LINE != 0
-          _reg_512line reg_512l[NUM_REG_512LINE];
-  #endif
-  #if NUM_REG_1024LINE != 0
-          _reg_1024line reg_1024l[NUM_REG_1024LINE];
-  #endif
-  #if NUM_REG_2048LINE != 0
-          _reg_2048line reg_2048l[NUM_REG_2048LINE];
-  #endif
-      } registers_t;
+  /** \brief Register size classes. The name of a register is R<size>_<number>, e.g. R2048L_3.
+   *  REG_SIZE_CLASSES is the number of classes, and the class of the names that do not exist
+   */
+  enum REG_SIZE_CLASS : uint8_t {REG_64B, REG_1L, REG_8L, REG_16L, REG_256L, REG_512L, REG_1024L, REG_2048L, REG_SIZE_CLASSES};
+
+  /** \brief Geometry of the register file
+   *
+   *  The size of the register file and the number of registers of each size class. They
+   *  are the defaults above, or they are read at startup from a machine description file,
+   *  so the register file can fit the L3 of the host and the mix of registers can fit a
+   *  kernel without recompiling. The registers of a size class are contiguous, and the
+   *  classes follow each other in order. The byte offset (base) and the first dense ID of each
+   *  class are precomputed, and the size of the registers (stride) is a constant table, so 
+   *  finding a register is one multiply and one add.
+   *  The registers of one line or more are aligned to the cache line.
+   */
+  class register_geometry {
+    private:
+      uint64_t file_size; /**< Bytes of the register file */
+      uint32_t num_registers[REG_SIZE_CLASSES];
+      uint64_t class_offset[REG_SIZE_CLASSES + 1]; /**< Byte offset of the first register of each class, the last one is the used size */
+      uint32_t class_id[REG_SIZE_CLASSES + 1]; /**< Dense ID of the first register of each class, the last one is the number of registers */
+
+      inline void computeTables() {
+        class_offset[0] = 0;
+        class_id[0] = 0;
+        for (uint8_t c = 0; c < REG_SIZE_CLASSES; c++) {
+          uint64_t start = class_offset[c];
+          if (c > 0)
+            start = (start + CACHE_LINE_SIZE - 1)/CACHE_LINE_SIZE*CACHE_LINE_SIZE;
+          class_offset[c] = start;
+          class_offset[c + 1] = start + static_cast<uint64_t>(num_registers[c])*getRegisterSizeInBytes(c);
+          class_id[c + 1] = class_id[c] + num_registers[c];
+        }
+      }
+
+    public:
+      register_geometry() :
+        file_size(REG_FILE_SIZE_KB*1000),
+        num_registers{NUM_REG_64BITS, NUM_REG_1LINE, NUM_REG_8LINE, NUM_REG_16LINE, NUM_REG_256LINE, NUM_REG_512LINE, NUM_REG_1024LINE, NUM_REG_2048LINE} {
+        computeTables();
+      }
+
+      /** \brief read a machine description file. Each line is a key and a value, lines starting
+       *  with # are comments:
+       *    REG_FILE_SIZE_KB 12288
+       *    2048L 40
+       *  The keys are REG_FILE_SIZE_KB and the size names of the registers. The values that
+       *  are not in the file keep their current value
+       *  \returns false if the file cannot be read or it has an unknown key
+       */
+      bool readFile(const char * fileName);
+
+      inline void setFileSize(uint64_t bytes) { file_size = bytes; }
+      inline void setNumRegisters(uint8_t sizeClass, uint32_t count) {
+        if (sizeClass < REG_SIZE_CLASSES) {
+          num_registers[sizeClass] = count;
+          computeTables();
+        }
+      }
+
+      inline uint64_t getFileSize() const { return file_size; }
+      /** \brief bytes used by the registers
+       */
+      inline uint64_t getUsedSize() const { return class_offset[REG_SIZE_CLASSES]; }
+      inline uint32_t numRegisters() const { return class_id[REG_SIZE_CLASSES]; }
+      inline uint32_t numRegisters(uint8_t sizeClass) const { return sizeClass < REG_SIZE_CLASSES ? num_registers[sizeClass] : 0; }
+
+      /** \brief Dense register ID, from 0 to numRegisters()-1. Registers of the same size class are contiguous
+       *  \returns the ID or numRegisters() if the register does not exist
+       */
+      inline uint32_t getRegisterId(uint8_t sizeClass, uint32_t num) const {
+        if (sizeClass >= REG_SIZE_CLASSES || num >= num_registers[sizeClass])
+          return numRegisters();
+        return class_id[sizeClass] + num;
+      }
+      /** \brief byte offset of a register in the register file. It does not check the register exists
+       */
+      inline uint64_t getOffset(uint8_t sizeClass, uint32_t num) const {
+        return class_offset[sizeClass] + static_cast<uint64_t>(num)*SIZE_BYTES[sizeClass];
+      }
+
+      /** \brief Name and size in bytes (stride) of each class
+       */
+      static constexpr const char * SIZE_NAMES[REG_SIZE_CLASSES] = {"64B", "1L", "8L", "16L", "256L", "512L", "1024L", "2048L"};
+      static constexpr uint32_t SIZE_BYTES[REG_SIZE_CLASSES] = {8, CACHE_LINE_SIZE, CACHE_LINE_SIZE*8, CACHE_LINE_SIZE*16, CACHE_LINE_SIZE*256, CACHE_LINE_SIZE*512, CACHE_LINE_SIZE*1024, CACHE_LINE_SIZE*2048};
+
+      static inline const char * getRegisterSizeName(uint8_t sizeClass) {
+        return sizeClass < REG_SIZE_CLASSES ? SIZE_NAMES[sizeClass] : "";
+      }
+      static constexpr uint32_t getRegisterSizeInBytes(uint8_t sizeClass) {
+        return sizeClass < REG_SIZE_CLASSES ? SIZE_BYTES[sizeClass] : 0;
+      }
+      /** \brief size class of the size part of a register name, e.g. 2048L. The number is parsed
+       *  once instead of comparing the name with all the classes
+       *  \returns the size class or REG_SIZE_CLASSES if the size does not exist
+       */
+      static constexpr REG_SIZE_CLASS parseSizeClass(std::string_view size) {
+        if (size.size() < 2 || size.size() > 5)
+          return REG_SIZE_CLASSES;
+        uint32_t lines = 0;
+        for (size_t i = 0; i + 1 < size.size(); i++) {
+          if (size[i] < '0' || size[i] > '9')
+            return REG_SIZE_CLASSES;
+          lines = lines*10 + (size[i] - '0');
+        }
+        if (size.back() == 'B')
+          return lines == 64 && size[0] != '0' ? REG_64B : REG_SIZE_CLASSES;
+        if (size.back() != 'L' || size[0] == '0')
+          return REG_SIZE_CLASSES;
+        switch (lines) {
+          case 1: return REG_1L;
+          case 8: return REG_8L;
+          case 16: return REG_16L;
+          case 256: return REG_256L;
+          case 512: return REG_512L;
+          case 1024: return REG_1024L;
+          case 2048: return REG_2048L;
+          default: return REG_SIZE_CLASSES;
+        }
+      }
+  };
 }
-#define REG_64B(num) (reg_file->registers.reg_64[num])
-#define REG_1L(num) (reg_file->registers.reg_1l[num])
-#define REG_8L(num) (reg_file->registers.reg_8l[num])
-#define REG_16L(num) (reg_file->registers.reg_16l[num])
-#define REG_256L(num) (reg_file->registers.reg_256l[num])
-#define REG_512L(num) (reg_file->registers.reg_512l[num])
-#define REG_1024L(num) (reg_file->registers.reg_1024l[num])
-#define REG_2048L(num) (reg_file->registers.reg_2048l[num])
 
 #endif
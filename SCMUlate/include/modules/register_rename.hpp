@@ -0,0 +1,182 @@
+#ifndef __REGISTER_RENAME__
+#define __REGISTER_RENAME__
+
+/** \brief Register renaming
+ *
+ * This file contains the rename stage of the SU. Large registers are expensive to
+ * copy, so the original Tomasulo's approach of copying the operands into the reservation
+ * table is not an option (see ilp_controller.hpp). Instead, when an instruction only writes
+ * a register, it gets a new physical register, and the following instructions that read the
+ * architectural register are redirected to it. Loop iterations that reuse the same registers
+ * (e.g. R2048L_1 in matMul128x1280.scm) do not have WAR or WAW hazards anymore.
+ *
+ * The physical registers are the registers of the register file that the program does not
+ * use. Registers are renamed when the instructions are fetched, that is, in program order.
+ * The instructions that are fetched are copies of the instructions in the instruction memory,
+ * with the physical registers in their operands. A physical register is released when the
+ * last instruction that uses it commits and it is not mapped anymore. When the program
+ * commits, the content of the physical registers is copied back into the architectural ones.
+ */
+
+#include "SCMUlate_tools.hpp"
+#include "system_config.hpp"
+#include "instructions.hpp"
+#include "instruction_mem.hpp"
+#include "register.hpp"
+#include "codelet.hpp"
+#include <vector>
+#include <algorithm>
+
+namespace scm {
+
+  class register_rename_module {
+    private:
+      /** \brief copy of a fetched instruction
+       *  The instruction must be the first member, so the instruction pointer given to the
+       *  SU and the CUs can be converted back into the entry
+       */
+      struct renamed_instruction_t {
+        decoded_instruction_t inst;
+        unsigned char * args[3];
+        bool owns_codelet;
+      };
+
+      reg_file_module * reg_file_m;
+      bool enabled;
+      std::vector<uint32_t> mapping; /**< Architectural register ID to physical register ID */
+      std::vector<uint16_t> references; /**< Mapping and instructions that use each physical register */
+      std::vector<bool> in_pool; /**< The register is not used by the program */
+      std::vector<uint32_t> free_registers[reg_file_module::NUM_REG_SIZE_CLASSES];
+      std::vector<renamed_instruction_t> instances;
+      std::vector<uint32_t> free_instances;
+      uint64_t num_renamed;
+
+      static inline bool isRenamed(operand_t & op) {
+        return op.type == operand_t::REGISTER && op.value.reg.reg_size_class >= RENAMING_MIN_REG_SIZE_CLASS;
+      }
+
+      inline void releaseReference(uint32_t id, uint8_t sizeClass) {
+        if (--references[id] == 0 && in_pool[id])
+          free_registers[sizeClass].push_back(id);
+      }
+
+      inline void setPhysical(decoded_reg_t & reg, uint32_t id) {
+        reg.reg_id = id;
+        reg.reg_number = id - reg_file_m->getRegisterId(reg.reg_size_class, 0);
+        reg.reg_ptr = reg_file_m->getRegisterByClass(reg.reg_size_class, reg.reg_number);
+      }
+
+      /** \brief rename one operand. The operands that only write get a new physical register
+       *  if there is one available, otherwise they use the current mapping
+       */
+      inline void renameOperand(operand_t & op, uint_fast16_t io_dir, bool writes) {
+        if (!isRenamed(op) || writes != ((io_dir & OP_IO::OP1_WR) && !(io_dir & OP_IO::OP1_RD)))
+          return;
+        decoded_reg_t & reg = op.value.reg;
+        uint32_t arch = reg.reg_id;
+        std::vector<uint32_t> & pool = free_registers[reg.reg_size_class];
+        if (writes && !pool.empty()) {
+          uint32_t phys = pool.back();
+          pool.pop_back();
+          uint32_t old = mapping[arch];
+          mapping[arch] = phys;
+          references[phys] = 2;
+          releaseReference(old, reg.reg_size_class);
+          num_renamed++;
+        } else {
+          references[mapping[arch]]++;
+        }
+        setPhysical(reg, mapping[arch]);
+      }
+
+    public:
+      register_rename_module() = delete;
+      /** \brief create the rename stage of a program
+       *  \param maxInstructions number of instructions that can be fetched and not committed at the same time
+       *  \param enable when false instructions are not copied nor renamed
+       */
+      register_rename_module(inst_mem_module * const inst_mem, reg_file_module * const reg_file, uint32_t maxInstructions, bool enable);
+
+      /** \brief reset the mapping and take the registers the program in inst_mem does
+       *  not use as physical registers. All the instructions must have committed
+       */
+      void load(inst_mem_module * const inst_mem);
+
+      /** \brief copy and rename the registers of a fetched instruction
+       *  \returns the renamed instruction, or nullptr if there are too many instructions that
+       *  have not committed yet. When renaming is disabled it returns the same instruction
+       */
+      inline decoded_instruction_t * rename(decoded_instruction_t * inst) {
+        if (!enabled)
+          return inst;
+        if (free_instances.empty())
+          return nullptr;
+        renamed_instruction_t & entry = instances[free_instances.back()];
+        free_instances.pop_back();
+        entry.inst = *inst;
+        entry.owns_codelet = false;
+        decoded_instruction_t & copy = entry.inst;
+        uint_fast16_t io = copy.getOpIO();
+        operand_t * ops[3] = {&copy.getOp1(), &copy.getOp2(), &copy.getOp3()};
+        // Sources first, an instruction may read the previous value of the register it writes
+        for (int i = 0; i < 3; i++)
+          renameOperand(*ops[i], io >> (i*2), false);
+        for (int i = 0; i < 3; i++)
+          renameOperand(*ops[i], io >> (i*2), true);
+
+        // The codelet parameters point to the architectural registers
+        if (copy.getType() == EXECUTE_INST && copy.getExecCodelet()) {
+          unsigned char ** params = reinterpret_cast<unsigned char **>(copy.getExecCodelet()->getParams());
+          bool changed = false;
+          for (int i = 0; i < 3; i++) {
+            entry.args[i] = isRenamed(*ops[i]) ? ops[i]->value.reg.reg_ptr : params[i];
+            changed |= entry.args[i] != params[i];
+          }
+          if (changed) {
+            copy.setExecCodelet(copy.getExecCodelet()->clone(entry.args));
+            entry.owns_codelet = true;
+          }
+        }
+        return &copy;
+      }
+
+      /** \brief the instruction committed, release its physical registers
+       */
+      inline void retire(decoded_instruction_t * inst) {
+        if (!enabled)
+          return;
+        renamed_instruction_t * entry = reinterpret_cast<renamed_instruction_t *>(inst);
+        if (isRenamed(inst->getOp1()))
+          releaseReference(inst->getOp1().value.reg.reg_id, inst->getOp1().value.reg.reg_size_class);
+        if (isRenamed(inst->getOp2()))
+          releaseReference(inst->getOp2().value.reg.reg_id, inst->getOp2().value.reg.reg_size_class);
+        if (isRenamed(inst->getOp3()))
+          releaseReference(inst->getOp3().value.reg.reg_id, inst->getOp3().value.reg.reg_size_class);
+        if (entry->owns_codelet) {
+          delete inst->getExecCodelet();
+          inst->setExecCodelet(nullptr);
+          entry->owns_codelet = false;
+        }
+        free_instances.push_back(entry - instances.data());
+      }
+
+      /** \brief copy the value of the renamed registers back into the architectural
+       *  registers and reset the mapping. All the instructions must have committed
+       */
+      void commit();
+
+      /** \brief physical register mapped to an architectural register
+       */
+      inline uint32_t getMapping(uint32_t archId) { return mapping[archId]; }
+      /** \brief number of free physical registers of a size class
+       */
+      inline uint32_t numFreeRegisters(uint8_t sizeClass) { return free_registers[sizeClass].size(); }
+      /** \brief number of writes that got a new physical register
+       */
+      inline uint64_t numRenamed() { return num_renamed; }
+
+      ~register_rename_module();
+  };
+
+} // namespace scm
+#endif
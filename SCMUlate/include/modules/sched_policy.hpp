@@ -0,0 +1,113 @@
+#ifndef __SCHED_POLICY__
+#define __SCHED_POLICY__
+
+/** \brief CU scheduling policies
+ *
+ * This file contains the policies that the SU uses to select the CU that receives a
+ * memory or execute instruction. The policy is selected when the machine is created
+ * (see SCHED_POLICIES in system_config.hpp). A new policy only needs to inherit from
+ * cu_sched_policy and to be added to cu_sched_policy::create().
+ *
+ * The policies only select a CU that has room in its queue, the SU assigns the instruction
+ * and notifies the policy with instructionAssigned().
+ */
+
+#include "SCMUlate_tools.hpp"
+#include "system_config.hpp"
+#include "instructions.hpp"
+#include "control_store.hpp"
+#include "register.hpp"
+#include <vector>
+#include <algorithm>
+
+namespace scm {
+
+  class cu_sched_policy {
+    protected:
+      control_store_module * ctrl_st_m; /**< CUs that can receive the instructions */
+      uint32_t nextExecutor; /**< Where the search for a CU starts, so ties are spread among the CUs */
+
+      /** \brief CU with the least instructions assigned or executing
+       *  \returns the CU or -1 if all the CUs are full
+       */
+      int32_t leastLoaded();
+
+    public:
+      cu_sched_policy() = delete;
+      cu_sched_policy(control_store_module * const control_store) : ctrl_st_m(control_store), nextExecutor(0) { }
+
+      /** \brief create the policy selected for the machine
+       *  \param numRegisters registers of the register file, for the policies that track them
+       */
+      static cu_sched_policy * create(SCHED_POLICIES policy, control_store_module * const control_store, uint32_t numRegisters);
+
+      /** \brief name of the policy, for the messages and the benchmarks
+       */
+      virtual const char * getName() = 0;
+
+      /** \brief select the CU that should receive the instruction
+       *  \returns a CU with room in its queue or -1 if all the CUs are full
+       */
+      virtual int32_t selectExecutor(decoded_instruction_t * inst) = 0;
+
+      /** \brief the instruction was assigned to the CU returned by selectExecutor
+       */
+      virtual void instructionAssigned(decoded_instruction_t * inst, uint32_t executor) { (void) inst; (void) executor; }
+
+      /** \brief forget the previous program, called before a program runs. The CUs 
+       *  of the machine may have changed since (see scm_multi_machine)
+       */
+      virtual void reset() { nextExecutor = 0; }
+
+      virtual ~cu_sched_policy() { }
+  };
+
+  /** \brief Round robin among the CUs. Idle CUs are preferred, otherwise the instruction
+   *  waits in the queue of a busy CU
+   */
+  class cu_sched_round_robin : public cu_sched_policy {
+    public:
+      cu_sched_round_robin(control_store_module * const control_store) : cu_sched_policy(control_store) { }
+      const char * getName() { return "ROUND_ROBIN"; }
+      int32_t selectExecutor(decoded_instruction_t * inst);
+  };
+
+  /** \brief The CU with the shortest queue
+   */
+  class cu_sched_least_loaded : public cu_sched_policy {
+    public:
+      cu_sched_least_loaded(control_store_module * const control_store) : cu_sched_policy(control_store) { }
+      const char * getName() { return "LEAST_LOADED"; }
+      int32_t selectExecutor(decoded_instruction_t * inst) { (void) inst; return leastLoaded(); }
+  };
+
+  /** \brief The CU that last wrote the input registers of the instruction.
+   *
+   *  The private caches of that CU are likely to still hold the registers (e.g. a 128KB
+   *  R2048L tile loaded by LoadSqTile_2048L and multiplied by MatMult_2048L). When the
+   *  input registers were written by different CUs, the CU that wrote the most bytes is
+   *  selected. If there is no such CU, or its queue is full, the least loaded CU is used.
+   *  The writer of a register is recorded when the instruction is assigned. A CU may steal
+   *  it afterwards, but only when the owner is busy.
+   */
+  class cu_sched_reg_affinity : public cu_sched_policy {
+    private:
+      std::vector<int32_t> lastWriter; /**< Register ID to the CU that last wrote it, -1 if none */
+      std::vector<uint64_t> score; /**< Bytes of the input registers of the current instruction written by each CU */
+
+    public:
+      cu_sched_reg_affinity(control_store_module * const control_store, uint32_t numRegisters) :
+        cu_sched_policy(control_store),
+        lastWriter(numRegisters, -1),
+        score(control_store->maxExecutors(), 0) { }
+      const char * getName() { return "REG_AFFINITY"; }
+      int32_t selectExecutor(decoded_instruction_t * inst);
+      void instructionAssigned(decoded_instruction_t * inst, uint32_t executor);
+      void reset();
+      /** \brief CU that last wrote a register, -1 if none
+       */
+      inline int32_t getLastWriter(uint32_t regId) { return lastWriter[regId]; }
+  };
+
+} // namespace scm
+#endif
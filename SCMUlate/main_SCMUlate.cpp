@@ -7,6 +7,14 @@
 static struct {
   bool fileInput = false;
   char * fileName;
+  bool imageOutput = false;
+  char * imageName;
+  uint32_t numCUs = NUM_CUS;
+  char * cpuList = nullptr;
+  scm::IDLE_POLICIES idlePolicy = scm::IDLE_SPIN;
+  scm::THREAD_BACKENDS backend = scm::OPENMP_BACKEND;
+  scm::NUMA_PLACEMENTS placement = scm::NUMA_NONE;
+  char * machineFile = nullptr;
 } program_options;
 
  // 4 GB
@@ -19,25 +27,46 @@ int SCMUlate();
 
 int main (int argc, char * argv[]) {
   parseProgramOptions(argc, argv);
-  unsigned char * memory = new unsigned char[SIZEOFMEM];
+  // Machine description with the geometry of the register file
+  scm::register_geometry registers;
+  if (program_options.machineFile && !registers.readFile(program_options.machineFile))
+    return 1;
 
-  // SCM MACHINE
+  // ASSEMBLER MODE: Parse the program and write its binary image
+  if (program_options.imageOutput) {
+    if (!program_options.fileInput) {
+      SCMULATE_ERROR(0, "Assembler mode needs a program file. Use -i <filename> -o <image>");
+      return 1;
+    }
+    scm::reg_file_module reg_file_m(registers);
+    scm::inst_mem_module inst_mem_m(program_options.fileName, &reg_file_m, true);
+    if (!inst_mem_m.isValid() || !inst_mem_m.writeImage(program_options.imageName))
+      return 1;
+    return 0;
+  }
+
+  // SCM MACHINE, it owns its L2 memory
+  scm::threads_config threads(program_options.numCUs, program_options.cpuList);
+  threads.setIdlePolicy(program_options.idlePolicy);
+  threads.setBackend(program_options.backend);
+  threads.setPlacement(program_options.placement);
   scm::scm_machine * myMachine;
   if (program_options.fileInput) {
     SCMULATE_INFOMSG(0, "Reading program file %s", program_options.fileName);
-    myMachine = new scm::scm_machine(program_options.fileName, memory);
+    myMachine = new scm::scm_machine(program_options.fileName, SIZEOFMEM, scm::SEQUENTIAL, scm::ROUND_ROBIN, threads, true, registers);
   } else {
     SCMULATE_INFOMSG(0, "Reading from stdin");
     char emptyStr[10] = "";
-    myMachine = new scm::scm_machine(emptyStr, memory);
+    myMachine = new scm::scm_machine(emptyStr, SIZEOFMEM, scm::SEQUENTIAL, scm::ROUND_ROBIN, threads, true, registers);
   }
 
   myMachine->run();
+  if (program_options.placement != scm::NUMA_NONE)
+    myMachine->printBandwidthReport();
   TIMERS_COUNTERS_GUARD(
     myMachine->setTimersOutput("trace.json");
   );
   delete myMachine;
-  delete[] memory;
   return 0;
 }
 
@@ -47,6 +76,24 @@ void parseProgramOptions(int argc, char* argv[]) {
     if (strcmp(argv[i], "-i") == 0) {
       program_options.fileInput = true;
       program_options.fileName = argv[++i];
+    } else if (strcmp(argv[i], "-o") == 0) {
+      program_options.imageOutput = true;
+      program_options.imageName = argv[++i];
+    } else if (strcmp(argv[i], "-c") == 0) {
+      program_options.numCUs = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "-a") == 0) {
+      program_options.cpuList = argv[++i];
+    } else if (strcmp(argv[i], "-w") == 0) {
+      if (!scm::threads_config::parseIdlePolicy(argv[++i], program_options.idlePolicy))
+        std::cout << "Unknown idle policy " << argv[i] << ", use spin, yield or block" << std::endl;
+    } else if (strcmp(argv[i], "-b") == 0) {
+      if (!scm::threads_config::parseBackend(argv[++i], program_options.backend))
+        std::cout << "Unknown threads backend " << argv[i] << ", use omp or threads" << std::endl;
+    } else if (strcmp(argv[i], "-m") == 0) {
+      if (!scm::threads_config::parsePlacement(argv[++i], program_options.placement))
+        std::cout << "Unknown NUMA placement " << argv[i] << ", use none, interleave or blocked" << std::endl;
+    } else if (strcmp(argv[i], "-r") == 0) {
+      program_options.machineFile = argv[++i];
     }
   }
 }
@@ -12,22 +12,25 @@ l2_memory_t
    return this->getExecutor()->get_mem_interface()->getAddress(addr);
 }
 
-codelet* 
-  codeletFactory::createCodelet(std::string name, void * usedParams) {
-    codelet * result;
+creatorFnc
+  codeletFactory::getCreator(std::string name) {
     // Look for the codelet in the map
-    auto found = registeredCodelets->find(name);
-    if ( found == registeredCodelets->end()) {
+    if (registeredCodelets == nullptr || registeredCodelets->find(name) == registeredCodelets->end()) {
       // If not found, we display error, and then return null.
       SCMULATE_ERROR(0, "Trying to create a codelet that has not been implemented");
       return nullptr;
-    } else {
-      // If found we call the creator function and then 
-      SCMULATE_INFOMSG(5, "Creating Codelet %s", name.c_str());
-      creatorFnc creator = found->second;
-      result = creator(usedParams); // It is a function pointer
-      return result;
     }
+    return registeredCodelets->find(name)->second;
+}
+
+codelet* 
+  codeletFactory::createCodelet(std::string name, void * usedParams) {
+    creatorFnc creator = getCreator(name);
+    if (creator == nullptr)
+      return nullptr;
+    // If found we call the creator function and then 
+    SCMULATE_INFOMSG(5, "Creating Codelet %s", name.c_str());
+    return creator(usedParams); // It is a function pointer
 };
 
 void 
@@ -0,0 +1,55 @@
+#include "SCMUlate_tools.hpp"
+#include "memory_pages.hpp"
+#include <sys/mman.h>
+#include <unistd.h>
+#include <errno.h>
+
+void *
+scm::memory_pages::map(uint64_t size, bool hugePages, PAGE_KINDS & pages) {
+  pages = SMALL_PAGES;
+  void * mapped = MAP_FAILED;
+  if (hugePages) {
+    // Without MAP_NORESERVE, so it fails here if the pool does not have enough pages
+    mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (mapped != MAP_FAILED) {
+      pages = HUGETLB_PAGES;
+      return mapped;
+    }
+    SCMULATE_INFOMSG(1, "There are no huge pages for %lu bytes (errno %d), using transparent huge pages", size, errno);
+  }
+  // One more huge page to align the start
+  void * unaligned = mmap(nullptr, size + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (unaligned == MAP_FAILED) {
+    SCMULATE_ERROR(0, "Could not map %lu bytes (errno %d)", size, errno);
+    return nullptr;
+  }
+  uintptr_t start = reinterpret_cast<uintptr_t>(unaligned);
+  uintptr_t aligned = (start + HUGE_PAGE_SIZE - 1)/HUGE_PAGE_SIZE*HUGE_PAGE_SIZE;
+  if (aligned != start)
+    munmap(unaligned, aligned - start);
+  munmap(reinterpret_cast<void *>(aligned + size), start + HUGE_PAGE_SIZE - aligned);
+  mapped = reinterpret_cast<void *>(aligned);
+  if (hugePages && madvise(mapped, size, MADV_HUGEPAGE) == 0)
+    pages = TRANSPARENT_HUGE_PAGES;
+  return mapped;
+}
+
+void
+scm::memory_pages::unmap(void * memory, uint64_t size) {
+  if (memory != nullptr)
+    munmap(memory, size);
+}
+
+uint64_t
+scm::memory_pages::pageSize(PAGE_KINDS pages) {
+  return pages == SMALL_PAGES ? sysconf(_SC_PAGESIZE) : HUGE_PAGE_SIZE;
+}
+
+const char *
+scm::memory_pages::getName(PAGE_KINDS pages) {
+  switch (pages) {
+    case HUGETLB_PAGES: return "huge pages";
+    case TRANSPARENT_HUGE_PAGES: return "transparent huge pages";
+    default: return "small pages";
+  }
+}
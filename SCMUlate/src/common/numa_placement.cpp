@@ -0,0 +1,103 @@
+#include "SCMUlate_tools.hpp"
+#include "numa_placement.hpp"
+#include "threads_configuration.hpp"
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sched.h>
+#include <fstream>
+#include <string>
+#include <algorithm>
+
+// Range of whole pages that contains [addr, addr + len)
+static void pageRange(void * addr, size_t len, void ** start, size_t * pagesLen) {
+  uintptr_t pageSize = sysconf(_SC_PAGESIZE);
+  uintptr_t first = reinterpret_cast<uintptr_t>(addr) & ~(pageSize - 1);
+  *start = reinterpret_cast<void *>(first);
+  *pagesLen = reinterpret_cast<uintptr_t>(addr) + len - first;
+}
+
+static bool setPolicy(void * addr, size_t len, int mode, const std::vector<int> & nodes) {
+  if (len == 0 || nodes.empty())
+    return true;
+  const size_t bitsPerWord = sizeof(unsigned long)*8;
+  int maxNode = 0;
+  for (int node : nodes)
+    maxNode = std::max(maxNode, node);
+  std::vector<unsigned long> mask(maxNode/bitsPerWord + 1, 0);
+  for (int node : nodes)
+    mask[node/bitsPerWord] |= 1ul << (node%bitsPerWord);
+  void * start;
+  size_t pagesLen;
+  pageRange(addr, len, &start, &pagesLen);
+  // The pages that were touched already are moved to the new nodes
+  if (syscall(SYS_mbind, start, pagesLen, mode, mask.data(), mask.size()*bitsPerWord + 1, MPOL_MF_MOVE) != 0) {
+    SCMULATE_WARNING(0, "mbind failed with errno %d, the memory is not placed", errno);
+    return false;
+  }
+  return true;
+}
+
+// Nodes of a list in /sys/devices/system/node, e.g. "0-1"
+static std::vector<int> readNodeList(const char * fileName) {
+  std::vector<int> nodes;
+  std::ifstream listFile(fileName);
+  std::string list;
+  if (!(listFile >> list) || !scm::threads_config::parseCPUList(list.c_str(), nodes))
+    nodes.clear();
+  return nodes;
+}
+
+const std::vector<int> &
+scm::numa_placement::cpuNodes() {
+  static const std::vector<int> nodeOf = [] {
+    std::vector<int> result(CPU_SETSIZE, -1);
+    for (int node : readNodeList("/sys/devices/system/node/online")) {
+      std::vector<int> cpus = readNodeList(("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist").c_str());
+      for (int cpu : cpus)
+        if (cpu < CPU_SETSIZE)
+          result[cpu] = node;
+    }
+    return result;
+  }();
+  return nodeOf;
+}
+
+int
+scm::numa_placement::nodeOfCPU(int cpu) {
+  if (cpu < 0 || cpu >= CPU_SETSIZE)
+    return -1;
+  return cpuNodes()[cpu];
+}
+
+std::vector<int>
+scm::numa_placement::memoryNodes() {
+  std::vector<int> nodes = readNodeList("/sys/devices/system/node/has_memory");
+  if (nodes.empty())
+    nodes = readNodeList("/sys/devices/system/node/online");
+  return nodes;
+}
+
+bool
+scm::numa_placement::interleave(void * addr, size_t len, const std::vector<int> & nodes) {
+  return setPolicy(addr, len, MPOL_INTERLEAVE, nodes);
+}
+
+bool
+scm::numa_placement::bind(void * addr, size_t len, int node) {
+  // Preferred instead of bind, the pages go to another node if this one is full
+  return setPolicy(addr, len, MPOL_PREFERRED, std::vector<int>(1, node));
+}
+
+int
+scm::numa_placement::nodeOfAddress(const void * addr) {
+  void * page;
+  size_t pagesLen;
+  pageRange(const_cast<void *>(addr), 1, &page, &pagesLen);
+  // move_pages without target nodes only reports the node of each page
+  int status = -1;
+  if (syscall(SYS_move_pages, 0, 1ul, &page, nullptr, &status, 0) != 0 || status < 0)
+    return -1;
+  return status;
+}
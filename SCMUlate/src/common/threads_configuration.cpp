@@ -0,0 +1,198 @@
+#include "SCMUlate_tools.hpp"
+#include "threads_configuration.hpp"
+#include "numa_placement.hpp"
+#include <pthread.h>
+#include <sched.h>
+#include <fstream>
+#include <string>
+#include <set>
+#include <utility>
+#include <algorithm>
+
+scm::threads_config::threads_config(uint32_t numCUs, const char * cpuList) : 
+  num_cus(numCUs), 
+  valid(true), 
+  idle_policy(IDLE_SPIN), 
+  spin_iterations(CU_IDLE_SPIN_ITERATIONS), 
+  yield_iterations(CU_IDLE_YIELD_ITERATIONS),
+  backend(OPENMP_BACKEND),
+  placement(NUMA_NONE) {
+  if (cpuList == nullptr) {
+    SCMULATE_INFOMSG(3, "No CPU list, threads are not pinned");
+  } else if (strcmp(cpuList, "auto") == 0) {
+    std::vector<int> available = availableCPUs();
+    if (available.size() >= this->numThreads()) {
+      this->cpus.assign(available.begin(), available.begin() + this->numThreads());
+    } else {
+      SCMULATE_INFOMSG(1, "There are %lu CPUs for %u threads, threads are not pinned", available.size(), this->numThreads());
+    }
+  } else if (!parseCPUList(cpuList, this->cpus)) {
+    SCMULATE_ERROR(0, "Incorrect CPU list %s", cpuList);
+    this->valid = false;
+  }
+  this->valid = this->valid && checkCPUs();
+}
+
+scm::threads_config::threads_config(uint32_t numCUs, std::vector<int> affinity) : 
+  num_cus(numCUs), 
+  cpus(affinity), 
+  valid(true),
+  idle_policy(IDLE_SPIN), 
+  spin_iterations(CU_IDLE_SPIN_ITERATIONS), 
+  yield_iterations(CU_IDLE_YIELD_ITERATIONS),
+  backend(OPENMP_BACKEND),
+  placement(NUMA_NONE) {
+  this->valid = checkCPUs();
+}
+
+bool
+scm::threads_config::checkCPUs() {
+  if (this->num_cus == 0) {
+    SCMULATE_ERROR(0, "The machine needs at least one CU");
+    return false;
+  }
+  if (this->cpus.empty())
+    return true;
+  if (this->cpus.size() != this->numThreads()) {
+    SCMULATE_ERROR(0, "There are %lu CPUs in the affinity map for %u threads (SU and %u CUs)", this->cpus.size(), this->numThreads(), this->num_cus);
+    return false;
+  }
+  std::vector<int> available = availableCPUs();
+  std::set<int> allowed(available.begin(), available.end());
+  std::set<int> used;
+  for (int cpu : this->cpus) {
+    if (allowed.count(cpu) == 0) {
+      SCMULATE_ERROR(0, "CPU %d cannot be used by this process", cpu);
+      return false;
+    }
+    if (!used.insert(cpu).second) {
+      SCMULATE_ERROR(0, "CPU %d is used by two threads", cpu);
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+scm::threads_config::parseCPUList(const char * cpuList, std::vector<int> & result) {
+  result.clear();
+  const char * cur = cpuList;
+  while (*cur != '\0') {
+    char * end;
+    long first = strtol(cur, &end, 10);
+    if (end == cur || first < 0)
+      return false;
+    long last = first;
+    if (*end == '-') {
+      cur = end + 1;
+      last = strtol(cur, &end, 10);
+      if (end == cur || last < first)
+        return false;
+    }
+    for (long cpu = first; cpu <= last; cpu++)
+      result.push_back(cpu);
+    if (*end == ',')
+      end++;
+    else if (*end != '\0')
+      return false;
+    cur = end;
+  }
+  return !result.empty();
+}
+
+bool
+scm::threads_config::parseIdlePolicy(const char * name, IDLE_POLICIES & result) {
+  if (strcmp(name, "spin") == 0)
+    result = IDLE_SPIN;
+  else if (strcmp(name, "yield") == 0)
+    result = IDLE_YIELD;
+  else if (strcmp(name, "block") == 0)
+    result = IDLE_BLOCK;
+  else
+    return false;
+  return true;
+}
+
+bool
+scm::threads_config::parseBackend(const char * name, THREAD_BACKENDS & result) {
+  if (strcmp(name, "omp") == 0)
+    result = OPENMP_BACKEND;
+  else if (strcmp(name, "threads") == 0)
+    result = STD_THREAD_BACKEND;
+  else
+    return false;
+  return true;
+}
+
+bool
+scm::threads_config::parsePlacement(const char * name, NUMA_PLACEMENTS & result) {
+  if (strcmp(name, "none") == 0)
+    result = NUMA_NONE;
+  else if (strcmp(name, "interleave") == 0)
+    result = NUMA_INTERLEAVE;
+  else if (strcmp(name, "blocked") == 0)
+    result = NUMA_BLOCKED;
+  else
+    return false;
+  return true;
+}
+
+int
+scm::threads_config::getNode(uint32_t threadNum) const {
+  return numa_placement::nodeOfCPU(this->getCPU(threadNum));
+}
+
+std::vector<int>
+scm::threads_config::cuNodes() const {
+  std::set<int> nodes;
+  for (uint32_t cu = 0; cu < this->num_cus; cu++)
+    if (this->getNode(cu + 1) != -1)
+      nodes.insert(this->getNode(cu + 1));
+  return std::vector<int>(nodes.begin(), nodes.end());
+}
+
+std::vector<int>
+scm::threads_config::availableCPUs() {
+  std::vector<int> firstThreads, siblings;
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  if (sched_getaffinity(0, sizeof(mask), &mask) != 0)
+    return firstThreads;
+  // Hardware threads of the same core have the same package and core ID
+  std::set<std::pair<int, int>> cores;
+  for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+    if (!CPU_ISSET(cpu, &mask))
+      continue;
+    std::string topology = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+    std::ifstream coreFile(topology + "core_id"), packageFile(topology + "physical_package_id");
+    int core = cpu, package = 0;
+    coreFile >> core;
+    packageFile >> package;
+    if (cores.insert(std::make_pair(package, core)).second)
+      firstThreads.push_back(cpu);
+    else
+      siblings.push_back(cpu);
+  }
+  // CPUs of the same node together, so the CUs of a node are consecutive
+  auto byNode = [](int a, int b) { return numa_placement::nodeOfCPU(a) < numa_placement::nodeOfCPU(b); };
+  std::stable_sort(firstThreads.begin(), firstThreads.end(), byNode);
+  std::stable_sort(siblings.begin(), siblings.end(), byNode);
+  firstThreads.insert(firstThreads.end(), siblings.begin(), siblings.end());
+  return firstThreads;
+}
+
+bool
+scm::threads_config::pinThread(uint32_t threadNum) const {
+  int cpu = this->getCPU(threadNum);
+  if (cpu == -1)
+    return true;
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  CPU_SET(cpu, &mask);
+  if (pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask) != 0) {
+    SCMULATE_ERROR(0, "Could not pin thread %u to CPU %d", threadNum, cpu);
+    return false;
+  }
+  SCMULATE_INFOMSG(3, "Thread %u pinned to CPU %d", threadNum, cpu);
+  return true;
+}
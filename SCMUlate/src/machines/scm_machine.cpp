@@ -1,16 +1,36 @@
 #include "scm_machine.hpp"
+#include <chrono>
 
-scm::scm_machine::scm_machine(char * in_filename, l2_memory_t const memory, ILP_MODES ilp_mode):
+scm::scm_machine::scm_machine(char * in_filename, l2_memory_t const external_memory, ILP_MODES ilp_mode, SCHED_POLICIES sched_policy, const threads_config & threads, const register_geometry & registers):
+  scm_machine(in_filename, external_memory, nullptr, ilp_mode, sched_policy, threads, registers) { }
+
+scm::scm_machine::scm_machine(char * in_filename, uint64_t l2Size, ILP_MODES ilp_mode, SCHED_POLICIES sched_policy, const threads_config & threads, bool hugePages, const register_geometry & registers):
+  scm_machine(in_filename, nullptr, new l2_memory_module(l2Size, hugePages), ilp_mode, sched_policy, threads, registers) { }
+
+scm::scm_machine::scm_machine(char * in_filename, l2_memory_t const external_memory, l2_memory_module * owned_memory, ILP_MODES ilp_mode, SCHED_POLICIES sched_policy, const threads_config & threads, const register_geometry & registers):
   alive(false), 
   init_correct(true), 
   filename(in_filename),
-  reg_file_m(),
+  threads_cfg(threads),
+  l2_memory_m(owned_memory),
+  reg_file_m(registers),
   inst_mem_m(filename, &reg_file_m), 
-  control_store_m(NUM_CUS),
-  fetch_decode_m(&inst_mem_m, &control_store_m, &alive, ilp_mode) {
+  control_store_m(threads.numCUs()),
+  fetch_decode_m(&inst_mem_m, &reg_file_m, &control_store_m, &alive, ilp_mode, sched_policy),
+  run_seconds(0),
+  run_number(0),
+  workers_done(0),
+  workers_reset(false),
+  workers_exit(false) {
     SCMULATE_INFOMSG(0, "Initializing SCM machine")
     // Configuration parameters
   
+    if (!threads_cfg.isValid()) {
+      SCMULATE_ERROR(0, "Error in the threads configuration");
+      init_correct = false;
+      return;
+    }
+
     // We check the register configuration is valid
     if(!reg_file_m.checkRegisterConfig()) {
       SCMULATE_ERROR(0, "Error when checking the register");
@@ -18,83 +38,273 @@ scm::scm_machine::scm_machine(char * in_filename, l2_memory_t const memory, ILP_
       return;
     }
     
-    if(!inst_mem_m.isValid()) {
-      SCMULATE_ERROR(0, "Error when loading file");
-      init_correct = false;
-      return;
+    // The registers are used by all the CUs. Otherwise the first touch puts the part of each CU in its node
+    if (threads_cfg.getPlacement() == NUMA_INTERLEAVE && !numa_placement::interleave(reg_file_m.getSpace(), reg_file_m.getSpaceSize(), threads_cfg.cuNodes()))
+      SCMULATE_WARNING(0, "The register file is not placed in the nodes of the CUs");
+
+    l2_memory_t memory = external_memory;
+    if (l2_memory_m != nullptr) {
+      if (!l2_memory_m->isValid()) {
+        SCMULATE_ERROR(0, "Error when mapping the L2 memory");
+        init_correct = false;
+        return;
+      }
+      // Nothing was touched yet, the pages are created in their nodes
+      memory = l2_memory_m->getMemory();
+      placeMemory(memory, l2_memory_m->getSize());
     }
 
+    // Another program can be loaded later, the machine is still created
+    SCMULATE_ERROR_IF(0, !inst_mem_m.isValid(), "Error when loading file");
+
     TIMERS_COUNTERS_GUARD(
       this->fetch_decode_m.setTimerCounter(&this->time_cnt_m);
       this->time_cnt_m.addTimer("SCM_MACHINE",scm::SYS_TIMER);
     )
 
-    // Creating execution Units
-    int exec_units_threads[] = {CUS};
-    int * cur_exec = exec_units_threads;
-    for (int i = 0; i < NUM_CUS; i++, cur_exec++) {
-      SCMULATE_INFOMSG(4, "Creating executor (CUMEM) %d out of %d for thread %d", i, NUM_CUS, *cur_exec);
-      cu_executor_module* newExec = new cu_executor_module(*cur_exec, &control_store_m, i, &alive, memory);
+    // Creating execution Units, CU i runs in thread i+1
+    for (uint32_t i = 0; i < threads_cfg.numCUs(); i++) {
+      SCMULATE_INFOMSG(4, "Creating executor (CUMEM) %d out of %d for thread %d on CPU %d", i, threads_cfg.numCUs(), i + 1, threads_cfg.getCPU(i + 1));
+      cu_executor_module* newExec = new cu_executor_module(i + 1, &control_store_m, i, &alive, memory, threads_cfg);
       TIMERS_COUNTERS_GUARD(
         newExec->setTimerCnt(&this->time_cnt_m);
       )
       executors_m.push_back(newExec);
     }
+
+    // Persistent threads, they are pinned once and wait for the first run
+    if (threads_cfg.getBackend() == STD_THREAD_BACKEND) {
+      for (uint32_t i = 0; i < threads_cfg.numThreads(); i++)
+        workers.emplace_back(&scm_machine::workerLoop, this, i);
+    }
+
+    // First touch of the registers, from the threads of the CUs
+    resetRegisters();
       
     init_correct = true;
 }
 
+void
+scm::scm_machine::runUnit(uint32_t threadNum) {
+  if (threadNum == SU_THREAD)
+    fetch_decode_m.behavior();
+  else
+    executors_m[threadNum - 1]->behavior();
+}
+
+void
+scm::scm_machine::workerLoop(uint32_t threadNum) {
+  if (!threads_cfg.pinThread(threadNum))
+    SCMULATE_WARNING(0, "Thread %u is not pinned", threadNum);
+  uint64_t lastRun = 0;
+  while (true) {
+    bool reset;
+    {
+      std::unique_lock<std::mutex> lock(workers_lock);
+      workers_cv.wait(lock, [&] { return workers_exit || run_number != lastRun; });
+      if (workers_exit)
+        return;
+      lastRun = run_number;
+      reset = workers_reset;
+    }
+    if (!reset)
+      runUnit(threadNum);
+    else if (threadNum != SU_THREAD)
+      reg_file_m.reset(threadNum - 1, threads_cfg.numCUs());
+    std::lock_guard<std::mutex> lock(workers_lock);
+    if (++workers_done == threads_cfg.numThreads())
+      workers_cv.notify_all();
+  }
+}
+
+bool
+scm::scm_machine::load(char * in_filename) {
+  SCMULATE_INFOMSG(1, "Loading program %s", in_filename);
+  this->filename = in_filename;
+  if (!inst_mem_m.load(this->filename)) {
+    SCMULATE_ERROR(0, "Error when loading file");
+    return false;
+  }
+  return true;
+}
+
+bool
+scm::scm_machine::placeMemory(l2_memory_t memory, uint64_t size) {
+  if (threads_cfg.getPlacement() == NUMA_INTERLEAVE)
+    return numa_placement::interleave(memory, size, threads_cfg.cuNodes());
+  if (threads_cfg.getPlacement() != NUMA_BLOCKED)
+    return true;
+  // One block for each CU in its node, consecutive blocks of the same node are placed together.
+  // mbind needs whole pages, so the blocks start at a page of the mapping (huge pages if the machine owns it)
+  uint64_t pageSize = memory_pages::pageSize((l2_memory_m != nullptr && memory == l2_memory_m->getMemory()) ? l2_memory_m->getPages() : SMALL_PAGES);
+  uint64_t blockSize = size/threads_cfg.numCUs();
+  auto blockStart = [&](uint32_t cu) { return (cu == threads_cfg.numCUs()) ? size : cu*blockSize/pageSize*pageSize; };
+  bool placed = true;
+  uint32_t first = 0;
+  for (uint32_t cu = 1; cu <= threads_cfg.numCUs(); cu++) {
+    if (cu < threads_cfg.numCUs() && threads_cfg.getNode(cu + 1) == threads_cfg.getNode(first + 1))
+      continue;
+    uint64_t start = blockStart(first), end = blockStart(cu);
+    int node = threads_cfg.getNode(first + 1);
+    if (node != -1 && end > start) {
+      SCMULATE_INFOMSG(2, "L2 memory [%lu, %lu) in node %d", start, end, node);
+      placed = numa_placement::bind(memory + start, end - start, node) && placed;
+    }
+    first = cu;
+  }
+  return placed;
+}
+
+std::vector<scm::node_bandwidth_t>
+scm::scm_machine::getBandwidthReport() {
+  std::vector<node_bandwidth_t> report;
+  for (uint32_t cu = 0; cu < threads_cfg.numCUs(); cu++) {
+    int node = threads_cfg.getNode(cu + 1);
+    auto it = report.begin();
+    while (it != report.end() && it->node != node)
+      ++it;
+    if (it == report.end())
+      it = report.insert(report.end(), node_bandwidth_t{node, 0, 0, 0, run_seconds});
+    it->cus++;
+    it->bytes_read += executors_m[cu]->get_mem_interface()->getBytesRead();
+    it->bytes_written += executors_m[cu]->get_mem_interface()->getBytesWritten();
+  }
+  return report;
+}
+
+void
+scm::scm_machine::printBandwidthReport() {
+  printf("%-6s %4s %14s %14s %12s\n", "node", "CUs", "read (MB)", "written (MB)", "GB/s");
+  for (auto & node : getBandwidthReport()) {
+    double gbs = node.seconds > 0 ? (node.bytes_read + node.bytes_written)/node.seconds/1e9 : 0;
+    if (node.node == -1)
+      printf("%-6s", "none");
+    else
+      printf("%-6d", node.node);
+    printf(" %4u %14.2f %14.2f %12.3f\n", node.cus, node.bytes_read/1e6, node.bytes_written/1e6, gbs);
+  }
+}
+
+void
+scm::scm_machine::setRegister64B(uint32_t num, uint64_t value) {
+  // Registers are big endian
+  unsigned char * reg = reg_file_m.getRegisterByClass(REG_64B, num);
+  if (reg == nullptr)
+    return;
+  for (int i = 7; i >= 0; i--, value >>= 8)
+    reg[i] = value & 0xFF;
+}
+
+void
+scm::scm_machine::reset() {
+  resetRegisters();
+}
+
+void
+scm::scm_machine::resetRegisters() {
+  if (threads_cfg.getBackend() == STD_THREAD_BACKEND) {
+    startWorkers(true);
+    return;
+  }
+  // Same team as runOpenMP, so each part is zeroed by the thread that runs its CU
+#pragma omp parallel num_threads(threads_cfg.numThreads())
+  {
+    uint32_t threadNum = omp_get_thread_num();
+    if (static_cast<uint32_t>(omp_get_num_threads()) != threads_cfg.numThreads()) {
+      #pragma omp master
+      reg_file_m.reset();
+    } else {
+      threads_cfg.pinThread(threadNum);
+      if (threadNum != SU_THREAD)
+        reg_file_m.reset(threadNum - 1, threads_cfg.numCUs());
+    }
+  }
+}
+
 scm::run_status
 scm::scm_machine::run() {
-  if (!this->init_correct) return SCM_RUN_FAILURE;
+  if (!this->init_correct || !inst_mem_m.isValid()) return SCM_RUN_FAILURE;
+  fetch_decode_m.reset();
+  for (auto executor : executors_m)
+    executor->get_mem_interface()->resetCounters();
+  std::chrono::time_point<std::chrono::high_resolution_clock> initTimer = std::chrono::high_resolution_clock::now();
   TIMERS_COUNTERS_GUARD(
     this->time_cnt_m.resetTimer();
     this->time_cnt_m.addEvent("SCM_MACHINE",SYS_START);
   );
   this->alive = true;
+  run_status status = (threads_cfg.getBackend() == STD_THREAD_BACKEND) ? runThreads() : runOpenMP();
+  if (fetch_decode_m.hasFailed())
+    status = SCM_RUN_FAILURE;
+  std::chrono::duration<double> diff = std::chrono::high_resolution_clock::now() - initTimer;
+  this->run_seconds = diff.count();
+
+  TIMERS_COUNTERS_GUARD(
+    this->time_cnt_m.addEvent("SCM_MACHINE",SYS_END);
+  );
+  return status;
+}
+
+void
+scm::scm_machine::startWorkers(bool reset) {
+  std::unique_lock<std::mutex> lock(workers_lock);
+  workers_done = 0;
+  workers_reset = reset;
+  run_number++;
+  workers_cv.notify_all();
+  workers_cv.wait(lock, [&] { return workers_done == threads_cfg.numThreads(); });
+}
+
+scm::run_status
+scm::scm_machine::runThreads() {
+  startWorkers(false);
+  return SCM_RUN_SUCCESS;
+}
+
+scm::run_status
+scm::scm_machine::runOpenMP() {
   int run_result = 0;
-#pragma omp parallel reduction(+: run_result) shared(alive)
+  // One thread for the SU and one for each CU, regardless of OMP_NUM_THREADS
+#pragma omp parallel num_threads(threads_cfg.numThreads()) reduction(+: run_result) shared(alive)
   {
     #pragma omp master 
     {
       SCMULATE_INFOMSG(1, "Running with %d threads ", omp_get_num_threads());
     }
-    switch (omp_get_thread_num()) {
-      case SU_THREAD:
-        fetch_decode_m.behavior();
-        break;
-      case CU_THREADS:
-        // Find my executor
-        for (auto it = executors_m.begin(); it < executors_m.end(); ++it) {
-          if ((*it)->get_executor_id() == omp_get_thread_num()) {
-            (*it)->behavior();
-            break; // exit for loop
-          }
-        }
-        break;
-      default:
-        {
-          // Initialization barrier
-          #pragma omp barrier 
-          SCMULATE_WARNING(0, "Thread created with no purpose. What's my purpose? You pass the butter");
-        }
+    uint32_t threadNum = omp_get_thread_num();
+    // All the threads see the same team size, so either all of them run or none does
+    if (static_cast<uint32_t>(omp_get_num_threads()) != threads_cfg.numThreads()) {
+      #pragma omp master
+      SCMULATE_ERROR(0, "The SU and %u CUs need %u threads, OpenMP created %d", threads_cfg.numCUs(), threads_cfg.numThreads(), omp_get_num_threads());
+      run_result++;
+    } else {
+      if (!threads_cfg.pinThread(threadNum))
+        SCMULATE_WARNING(0, "Thread %u is not pinned", threadNum);
+      // Initialization barrier
+      #pragma omp barrier 
+      runUnit(threadNum);
+      #pragma omp barrier 
     }
-    #pragma omp barrier 
-
   }
 
-  TIMERS_COUNTERS_GUARD(
-    this->time_cnt_m.addEvent("SCM_MACHINE",SYS_END);
-  );
-
   if (run_result != 0 ) return SCM_RUN_FAILURE;
   return SCM_RUN_SUCCESS;
 
 }
 
 scm::scm_machine::~scm_machine() {
+  if (!workers.empty()) {
+    {
+      std::lock_guard<std::mutex> lock(workers_lock);
+      workers_exit = true;
+    }
+    workers_cv.notify_all();
+    for (auto & worker : workers)
+      worker.join();
+  }
   for (auto it = executors_m.begin(); it < executors_m.end(); ++it) 
     delete (*it);
+  delete l2_memory_m;
   TIMERS_COUNTERS_GUARD(
     this->time_cnt_m.dumpTimers();
   );
@@ -0,0 +1,238 @@
+#include "scm_multi_machine.hpp"
+#include <chrono>
+
+scm::su_partition::su_partition(uint32_t suNumber, scm_job_t * firstJob, uint32_t maxCUs, ILP_MODES ilp_mode, SCHED_POLICIES sched_policy, const register_geometry & registers) :
+  alive(false),
+  job(firstJob),
+  running_cus(0),
+  reg_file_m(registers),
+  inst_mem_m(firstJob->filename, &reg_file_m),
+  control_store_m(0, CU_QUEUE_DEPTH, maxCUs),
+  fetch_decode_m(&inst_mem_m, &reg_file_m, &control_store_m, &alive, ilp_mode, sched_policy, suNumber) {
+    SCMULATE_ERROR_IF(0, !inst_mem_m.isValid(), "Error when loading file %s", firstJob->filename);
+}
+
+bool
+scm::su_partition::load(scm_job_t * newJob) {
+  this->job = newJob;
+  // All the CUs left the previous program, so its slots are empty
+  for (auto executor : executors_m)
+    delete executor;
+  executors_m.clear();
+  control_store_m.setNumExecutors(0);
+  if (!inst_mem_m.load(newJob->filename)) {
+    SCMULATE_ERROR(0, "Error when loading file %s", newJob->filename);
+    return false;
+  }
+  reg_file_m.reset();
+  return true;
+}
+
+scm::cu_executor_module *
+scm::su_partition::addCU(uint32_t cuNumber, const threads_config & threads) {
+  uint32_t slot = control_store_m.numExecutors();
+  if (slot == control_store_m.maxExecutors())
+    return nullptr;
+  cu_executor_module * executor = new cu_executor_module(cuNumber + 1, &control_store_m, slot, &alive, job->memory, threads);
+  executors_m.push_back(executor);
+  control_store_m.setNumExecutors(slot + 1);
+  running_cus++;
+  return executor;
+}
+
+scm::su_partition::~su_partition() {
+  for (auto executor : executors_m)
+    delete executor;
+}
+
+scm::scm_multi_machine::scm_multi_machine(uint32_t numSUs, ILP_MODES ilp, SCHED_POLICIES sched, const threads_config & threads, std::vector<uint32_t> partitionCUs) :
+  num_sus(numSUs),
+  ilp_mode(ilp),
+  sched_policy(sched),
+  threads_cfg(threads),
+  partition_cus(partitionCUs),
+  rebalance(true),
+  registers(numSUs),
+  init_correct(true),
+  jobs(nullptr),
+  next_job(0) {
+    SCMULATE_INFOMSG(0, "Initializing SCM machine with %u SUs and %u CUs", numSUs, threads.numCUs());
+    if (!threads_cfg.isValid() || num_sus == 0 || num_sus > threads_cfg.numCUs()) {
+      SCMULATE_ERROR(0, "The machine needs at least one SU, and one CU for each SU");
+      init_correct = false;
+      return;
+    }
+    if (partition_cus.empty()) {
+      for (uint32_t su = 0; su < num_sus; su++)
+        partition_cus.push_back(threads_cfg.numCUs()/num_sus + (su < threads_cfg.numCUs()%num_sus ? 1 : 0));
+    }
+    uint32_t totalCUs = 0;
+    for (uint32_t cus : partition_cus) {
+      if (cus == 0)
+        init_correct = false;
+      totalCUs += cus;
+    }
+    if (partition_cus.size() != num_sus || totalCUs != threads_cfg.numCUs()) {
+      SCMULATE_ERROR(0, "The partitions must have at least one CU, and all the %u CUs of the machine", threads_cfg.numCUs());
+      init_correct = false;
+    }
+    TIMERS_COUNTERS_GUARD(
+      this->time_cnt_m.addTimer("SCM_MACHINE", scm::SYS_TIMER);
+    )
+}
+
+int32_t
+scm::scm_multi_machine::smallestRunningPartition() {
+  int32_t selected = -1;
+  for (uint32_t su = 0; su < num_sus; su++) {
+    if (!su_running[su] || !partitions[su]->alive)
+      continue;
+    if (selected == -1 || partitions[su]->control_store_m.numExecutors() < partitions[selected]->control_store_m.numExecutors())
+      selected = su;
+  }
+  return selected;
+}
+
+void
+scm::scm_multi_machine::suLoop(uint32_t su) {
+  std::unique_lock<std::mutex> guard(batch_lock);
+  while (next_job < jobs->size()) {
+    scm_job_t * job = &(*jobs)[next_job++];
+    job->su = su;
+    su_partition * partition = partitions[su];
+    // Other SUs can take programs while this one is loaded
+    guard.unlock();
+    std::chrono::time_point<std::chrono::high_resolution_clock> initTimer = std::chrono::high_resolution_clock::now();
+    bool loaded;
+    if (partition == nullptr) {
+      partition = new su_partition(su, job, threads_cfg.numCUs(), ilp_mode, sched_policy, registers[su]);
+      TIMERS_COUNTERS_GUARD(
+        partition->fetch_decode_m.setTimerCounter(&this->time_cnt_m);
+      )
+      loaded = partition->inst_mem_m.isValid();
+    } else {
+      loaded = partition->load(job);
+    }
+    if (loaded) {
+      partition->fetch_decode_m.reset();
+      partition->alive = true;
+    }
+    guard.lock();
+    partitions[su] = partition;
+    if (!loaded)
+      continue;
+    su_running[su] = true;
+    batch_changed.notify_all();
+    guard.unlock();
+
+    SCMULATE_INFOMSG(1, "SU %u running %s", su, job->filename);
+    int result = partition->fetch_decode_m.behavior();
+
+    // The executors are not released until all the CUs left them
+    guard.lock();
+    su_running[su] = false;
+    batch_changed.wait(guard, [&] { return partition->running_cus == 0; });
+    std::chrono::duration<double> diff = std::chrono::high_resolution_clock::now() - initTimer;
+    job->seconds = diff.count();
+    job->max_cus = partition->control_store_m.numExecutors();
+    job->status = (result == 0) ? SCM_RUN_SUCCESS : SCM_RUN_FAILURE;
+  }
+  su_retired[su] = true;
+  batch_changed.notify_all();
+}
+
+void
+scm::scm_multi_machine::cuLoop(uint32_t cu) {
+  std::unique_lock<std::mutex> guard(batch_lock);
+  while (true) {
+    uint32_t owner = cu_owner[cu];
+    if (su_retired[owner]) {
+      bool allRetired = true;
+      for (uint32_t su = 0; su < num_sus; su++)
+        allRetired = allRetired && su_retired[su];
+      int32_t donee = rebalance ? smallestRunningPartition() : -1;
+      if (donee != -1) {
+        SCMULATE_INFOMSG(2, "CU %u moves from SU %u to SU %d", cu, owner, donee);
+        cu_owner[cu] = donee;
+      } else if (allRetired || !rebalance) {
+        return;
+      } else {
+        batch_changed.wait(guard);
+      }
+      continue;
+    }
+
+    // Wait for a program of the SU. The CU joins each program once, it is not alive after the CU leaves it
+    su_partition * partition = partitions[owner];
+    cu_executor_module * executor = nullptr;
+    if (su_running[owner] && partition->alive)
+      executor = partition->addCU(cu, threads_cfg);
+    if (executor == nullptr) {
+      batch_changed.wait(guard);
+      continue;
+    }
+    TIMERS_COUNTERS_GUARD(
+      // The events of the CU in the previous programs are replaced
+      executor->setTimerCnt(&this->time_cnt_m);
+    )
+    guard.unlock();
+    executor->behavior();
+    guard.lock();
+    partition->running_cus--;
+    batch_changed.notify_all();
+  }
+}
+
+bool
+scm::scm_multi_machine::setRegisterGeometry(uint32_t su, const register_geometry & geometry) {
+  if (su >= num_sus) {
+    SCMULATE_ERROR(0, "There is no SU %u, the machine has %u SUs", su, num_sus);
+    return false;
+  }
+  registers[su] = geometry;
+  return true;
+}
+
+scm::run_status
+scm::scm_multi_machine::run(std::vector<scm_job_t> & batch) {
+  if (!this->init_correct) return SCM_RUN_FAILURE;
+  TIMERS_COUNTERS_GUARD(
+    this->time_cnt_m.resetTimer();
+    this->time_cnt_m.addEvent("SCM_MACHINE", SYS_START);
+  );
+  this->jobs = &batch;
+  this->next_job = 0;
+  this->partitions.assign(num_sus, nullptr);
+  this->su_running.assign(num_sus, false);
+  this->su_retired.assign(num_sus, false);
+  this->cu_owner.clear();
+  for (uint32_t su = 0; su < num_sus; su++)
+    this->cu_owner.insert(this->cu_owner.end(), partition_cus[su], su);
+
+  std::vector<std::thread> threads;
+  for (uint32_t su = 0; su < num_sus; su++)
+    threads.emplace_back(&scm_multi_machine::suLoop, this, su);
+  for (uint32_t cu = 0; cu < threads_cfg.numCUs(); cu++)
+    threads.emplace_back(&scm_multi_machine::cuLoop, this, cu);
+  for (auto & thread : threads)
+    thread.join();
+
+  for (auto partition : this->partitions)
+    delete partition;
+  this->partitions.clear();
+  this->jobs = nullptr;
+  TIMERS_COUNTERS_GUARD(
+    this->time_cnt_m.addEvent("SCM_MACHINE", SYS_END);
+  );
+
+  for (auto & job : batch)
+    if (job.status != SCM_RUN_SUCCESS)
+      return SCM_RUN_FAILURE;
+  return SCM_RUN_SUCCESS;
+}
+
+scm::scm_multi_machine::~scm_multi_machine() {
+  TIMERS_COUNTERS_GUARD(
+    this->time_cnt_m.dumpTimers();
+  );
+}
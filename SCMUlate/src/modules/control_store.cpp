@@ -1,32 +1,120 @@
 #include "control_store.hpp"
+#include <algorithm>
+#include <thread>
 
-void 
+scm::completion_queue::completion_queue(uint32_t minCapacity) : tail(0), head(0) {
+  uint64_t size = 1;
+  while (size < minCapacity)
+    size <<= 1;
+  this->mask = size - 1;
+  this->cells = std::vector<cell_t>(size);
+  for (uint64_t i = 0; i < size; i++)
+    this->cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+bool 
 scm::execution_slot::assign(scm::decoded_instruction_t *newInstruction) {
-  this->executionInstruction = newInstruction;
-  #pragma omp atomic write
-  this->state = BUSY;
+  if (this->is_full())
+    return false;
+  int64_t b = this->bottom.load(std::memory_order_relaxed);
+  int64_t t = this->top.load(std::memory_order_acquire);
+  if (b - t >= static_cast<int64_t>(this->instructions.size()))
+    return false;
+  this->instructions[b % this->instructions.size()].store(newInstruction, std::memory_order_relaxed);
+  // The instruction must be visible before the new bottom
+  std::atomic_thread_fence(std::memory_order_release);
+  this->bottom.store(b + 1, std::memory_order_relaxed);
+  // The new bottom must be visible before checking if the CU is sleeping
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (this->sleeping.load(std::memory_order_relaxed))
+    this->wake();
+  return true;
 }
 
-void 
-scm::execution_slot::empty_slot() {
-  this->executionInstruction = NULL;
-  #pragma omp atomic write
-  this->state = EMPTY;
+scm::decoded_instruction_t *
+scm::execution_slot::steal(execution_slot * thief) {
+  int64_t t = this->top.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t b = this->bottom.load(std::memory_order_acquire);
+  if (t >= b)
+    return nullptr;
+  decoded_instruction_t * inst = this->instructions[t % this->instructions.size()].load(std::memory_order_relaxed);
+  // The instruction is in the occupancy of the thief before it leaves this slot
+  thief->executing.store(inst, std::memory_order_seq_cst);
+  // Another CU may have taken it, and the SU may have reused the entry since
+  if (!this->top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+    thief->executing.store(nullptr, std::memory_order_release);
+    return nullptr;
+  }
+  return inst;
+}
+
+void
+scm::execution_slot::wait_for_work(volatile bool * alive) {
+  std::unique_lock<std::mutex> lock(this->sleep_lock);
+  this->sleeping.store(true, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  while (this->pending() == 0 && *alive)
+    this->wake_up.wait(lock);
+  this->sleeping.store(false, std::memory_order_relaxed);
+}
+
+void
+scm::execution_slot::wake() {
+  std::lock_guard<std::mutex> lock(this->sleep_lock);
+  this->wake_up.notify_one();
+}
+
+void
+scm::execution_slot::reset() {
+  this->top.store(0, std::memory_order_relaxed);
+  this->bottom.store(0, std::memory_order_relaxed);
+  this->executing.store(nullptr, std::memory_order_relaxed);
+  this->sleeping.store(false, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
 }
 
 void 
 scm::execution_slot::done_execution() {
-  #pragma omp atomic write
-  this->state = DONE;
+  decoded_instruction_t * finished = this->executing.load(std::memory_order_relaxed);
+  // The instruction is in the completion queue before the slot is free, so the SU cannot 
+  // fill the slot again and have more instructions of this slot in flight than the queue can hold
+  for (uint32_t tries = 0; !this->completed->push(finished); tries++) {
+    // The SU drains the queue on every iteration, back off until it does
+    if (tries < CU_IDLE_SPIN_ITERATIONS)
+      cpuRelax();
+    else
+      std::this_thread::yield();
+  }
+  this->executing.store(nullptr, std::memory_order_release);
 }
 
-scm::control_store_module::control_store_module(const int numExecUnits) {
+scm::control_store_module::control_store_module(const int numExecUnits, const uint32_t queueDepth, const int maxExecUnits) : 
+  active_slots(numExecUnits), 
+  // The SU assigns instructions once between two drains of the queue, so each slot can 
+  // finish its whole queue and the instructions that were assigned to refill it
+  completed(std::max(numExecUnits, maxExecUnits)*queueDepth*2) {
   // Creating all the execution slots
-  for (int i = 0; i < numExecUnits; i ++) {
-    this->execution_slots.push_back(new execution_slot());
+  for (int i = 0; i < std::max(numExecUnits, maxExecUnits); i ++) {
+    this->execution_slots.push_back(new execution_slot(&this->completed, queueDepth));
   }
 }
 
+bool
+scm::control_store_module::setNumExecutors(uint32_t numExecUnits) {
+  if (numExecUnits > this->execution_slots.size())
+    return false;
+  // The new slot must be empty before the SU can assign to it
+  this->active_slots.store(numExecUnits, std::memory_order_release);
+  return true;
+}
+void
+scm::control_store_module::reset() {
+  for (auto slot : this->execution_slots)
+    slot->reset();
+  this->completed.clear();
+}
+
 scm::control_store_module::~control_store_module() {
   // Deleting the execution slots
   for (auto it = this->execution_slots.rbegin(); it < this->execution_slots.rend(); ++it)
@@ -1,8 +1,11 @@
 #include "executor.hpp"
 
-scm::cu_executor_module::cu_executor_module(int CU_ID, control_store_module * const control_store_m, unsigned int execSlotNumber, bool * aliveSig, l2_memory_t upperMem):
+scm::cu_executor_module::cu_executor_module(int CU_ID, control_store_module * const control_store_m, unsigned int execSlotNumber, bool * aliveSig, l2_memory_t upperMem, const threads_config & threads):
   cu_executor_id(CU_ID),
-  aliveSignal(aliveSig) {
+  ctrl_st_m(control_store_m),
+  slot_number(execSlotNumber),
+  aliveSignal(aliveSig),
+  idleBackoff(threads) {
     this->myExecutor = control_store_m->get_executor(execSlotNumber);
     this->mem_interface_t = new mem_interface_module(upperMem);
 }
@@ -13,12 +16,16 @@ scm::cu_executor_module::behavior() {
     this->timer_cnt_m->addEvent(this->cu_timer_name, CUMEM_START);
   );
   SCMULATE_INFOMSG(1, "Starting CUMEM %d behavior", cu_executor_id);
-  // Initialization barrier
-  #pragma omp barrier
   while (*(this->aliveSignal)) {
-    if (myExecutor->is_busy()) {
+    // Our own instructions first, otherwise help a busy CU
+    scm::decoded_instruction_t * curInstruction = myExecutor->steal(myExecutor);
+    if (!curInstruction)
+      curInstruction = stealInstruction();
+    if (!curInstruction) {
+      idleBackoff.idle(myExecutor, this->aliveSignal);
+    } else {
+      idleBackoff.reset();
       SCMULATE_INFOMSG(4, "  CUMEM[%d]: Executing instruction ", cu_executor_id);
-      scm::decoded_instruction_t * curInstruction = myExecutor->getHead();
       if (curInstruction->getType() == scm::instType::MEMORY_INST) {
         TIMERS_COUNTERS_GUARD(
           this->timer_cnt_m->addEvent(this->cu_timer_name, CUMEM_EXECUTION_MEM, curInstruction->getInstruction());
@@ -48,6 +55,22 @@ scm::cu_executor_module::behavior() {
 }
  
 
+scm::decoded_instruction_t *
+scm::cu_executor_module::stealInstruction() {
+  uint32_t numSlots = this->ctrl_st_m->numExecutors();
+  for (uint32_t i = 1; i < numSlots; i++) {
+    execution_slot * victim = this->ctrl_st_m->get_executor((this->slot_number + i) % numSlots);
+    if (victim->pending() == 0)
+      continue;
+    decoded_instruction_t * stolen = victim->steal(myExecutor);
+    if (stolen) {
+      SCMULATE_INFOMSG(4, "  CUMEM[%d]: Stole an instruction from slot %u", cu_executor_id, (this->slot_number + i) % numSlots);
+      return stolen;
+    }
+  }
+  return nullptr;
+}
+
 int scm::cu_executor_module::codeletExecutor() {
     scm::decoded_instruction_t * curInstruction = myExecutor->getHead();
     scm::codelet * curCodelet = curInstruction->getExecCodelet();
@@ -1,18 +1,41 @@
 #include "fetch_decode.hpp"
+#include "register_arith.hpp"
 #include <string>
 #include <vector>
 
 scm::fetch_decode_module::fetch_decode_module(inst_mem_module *const inst_mem, 
+                                              reg_file_module *const reg_file,
                                               control_store_module *const control_store_m, 
                                               bool *const aliveSig, 
-                                              ILP_MODES ilp_mode) : 
+                                              ILP_MODES ilp_mode,
+                                              SCHED_POLICIES sched_policy,
+                                              uint32_t suNumber) : 
                                               inst_mem_m(inst_mem),
                                               ctrl_st_m(control_store_m),
                                               aliveSignal(aliveSig),
                                               PC(0),
-                                              su_number(0), 
-                                              instructionLevelParallelism(ilp_mode)
+                                              su_number(suNumber), 
+                                              instructionLevelParallelism(ilp_mode, reg_file->numRegisters()),
+                                              renameStage(inst_mem, reg_file, RESERVATION_TABLE_SIZE + control_store_m->maxExecutors()*control_store_m->queueDepth(), ilp_mode == SUPERSCALAR),
+                                              fetchStalled(false),
+                                              failed(false),
+                                              schedPolicy(cu_sched_policy::create(sched_policy, control_store_m, reg_file->numRegisters()))
 {
+  SCMULATE_INFOMSG(3, "Using the %s scheduling policy", this->schedPolicy->getName());
+  this->reservationTableSize = instructionLevelParallelism.reservationTableSize();
+  this->reservationTable.reserve(this->reservationTableSize);
+}
+
+void scm::fetch_decode_module::reset()
+{
+  this->PC = 0;
+  this->reservationTable.clear();
+  this->fetchStalled = false;
+  this->failed = false;
+  this->schedPolicy->reset();
+  this->instructionLevelParallelism.reset();
+  this->ctrl_st_m->reset();
+  this->renameStage.load(this->inst_mem_m);
 }
 
 int scm::fetch_decode_module::behavior()
@@ -20,153 +43,207 @@ int scm::fetch_decode_module::behavior()
   TIMERS_COUNTERS_GUARD(
       this->time_cnt_m->addEvent(this->su_timer_name, SU_START););
   SCMULATE_INFOMSG(1, "Initializing the SU");
-// Initialization barrier
-#pragma omp barrier
+  // The reservation table is only visited when something changed since the last time
+  bool scheduleTable = true;
+  // CUs can join while the program runs
+  uint32_t numExecutors = this->ctrl_st_m->numExecutors();
   while (*(this->aliveSignal))
   {
-    SCMULATE_INFOMSG(5, "Executing PC = %d", this->PC);
+    if (fetchInstructions())
+      scheduleTable = true;
+    if (this->ctrl_st_m->numExecutors() != numExecutors)
+    {
+      numExecutors = this->ctrl_st_m->numExecutors();
+      scheduleTable = true;
+    }
+    if (scheduleTable)
+    {
+      scheduleTable = false;
+      scheduleReservationTable();
+    }
+    // Release the instructions that have finished
+    scm::decoded_instruction_t *finished;
+    while ((finished = this->ctrl_st_m->getCompletionQueue()->pop()) != nullptr)
+    {
+      SCMULATE_INFOMSG(5, "Instruction %s has finished executing", finished->getInstruction().c_str());
+      instructionLevelParallelism.instructionFinished(finished);
+      renameStage.retire(finished);
+      scheduleTable = true;
+    }
+  }
+  // The CUs that are blocked must see the machine is done
+  this->ctrl_st_m->wakeAll();
+  SCMULATE_INFOMSG(1, "Shutting down fetch decode unit");
+  TIMERS_COUNTERS_GUARD(
+      this->time_cnt_m->addEvent(this->su_timer_name, SU_END););
+  return this->failed ? 1 : 0;
+}
+
+bool scm::fetch_decode_module::fetchInstructions()
+{
+  bool fetched = false;
+  while (!this->fetchStalled && this->reservationTable.size() < this->reservationTableSize)
+  {
+    SCMULATE_INFOMSG(5, "Fetching PC = %d", this->PC);
     TIMERS_COUNTERS_GUARD(
         this->time_cnt_m->addEvent(this->su_timer_name, FETCH_DECODE_INSTRUCTION););
     scm::decoded_instruction_t *cur_inst = this->inst_mem_m->fetch(this->PC);
     SCMULATE_ERROR_IF(0, !cur_inst, "Returned instruction is NULL. This should not happen");
     if (!cur_inst)
     {
+      this->failed = true;
       *(this->aliveSignal) = false;
-      continue;
+      return fetched;
     }
-    // Depending on the instruction do something
+    // Wait for instructions to commit if there is no room for a new one
+    cur_inst = renameStage.rename(cur_inst);
+    if (!cur_inst)
+      return fetched;
     TIMERS_COUNTERS_GUARD(
         this->time_cnt_m->addEvent(this->su_timer_name, DISPATCH_INSTRUCTION, cur_inst->getInstruction()););
+    this->reservationTable.push_back(cur_inst);
+    fetched = true;
+    // Control instructions modify the PC when they are executed, and nothing comes after a COMMIT
+    if (cur_inst->getType() == CONTROL_INST || cur_inst->getType() == COMMIT)
+      this->fetchStalled = true;
+    else
+      this->PC++;
+  }
+  return fetched;
+}
+
+void scm::fetch_decode_module::scheduleReservationTable()
+{
+  // Free entries in the queues of the CUs
+  uint32_t freeExecutors = 0;
+  for (uint32_t i = 0; i < this->ctrl_st_m->numExecutors(); i++)
+    freeExecutors += this->ctrl_st_m->get_executor(i)->freeEntries();
+
+  // Scheduled instructions are removed, the rest are compacted keeping the program order
+  uint32_t remaining = 0;
+  for (uint32_t pos = 0; pos < this->reservationTable.size(); pos++)
+  {
+    scm::decoded_instruction_t *cur_inst = this->reservationTable[pos];
+    // Depending on the instruction do something
     bool hasBeenSched = false;
-    bool canSchedule = false;
-    bool showOnlyOnce = false;
-    while (!hasBeenSched)
+    switch (cur_inst->getType())
     {
-      switch (cur_inst->getType())
-      {
-      case COMMIT:
-        canSchedule = instructionLevelParallelism.checkMarkInstructionToSched(cur_inst, false);
-        if (canSchedule) {
-          SCMULATE_INFOMSG(4, "Scheduling and Exec a COMMIT");
-          SCMULATE_INFOMSG(1, "Turning off machine alive = false");
-          hasBeenSched = true;
-          #pragma omp atomic write
-          *(this->aliveSignal) = false;
-        }
-        break;
-      case CONTROL_INST:
-        canSchedule = instructionLevelParallelism.checkMarkInstructionToSched(cur_inst, false);
-        if (canSchedule) {
-          SCMULATE_INFOMSG(4, "Scheduling a CONTROL_INST %s", cur_inst->getInstruction().c_str());
-          hasBeenSched = true;
-          TIMERS_COUNTERS_GUARD(
-              this->time_cnt_m->addEvent(this->su_timer_name, EXECUTE_CONTROL_INSTRUCTION, cur_inst->getInstruction()););
-          executeControlInstruction(cur_inst);
-          TIMERS_COUNTERS_GUARD(
-              this->time_cnt_m->addEvent(this->su_timer_name, SU_IDLE););
-          instructionLevelParallelism.instructionFinished(cur_inst);
-        }
-        break;
-      case BASIC_ARITH_INST:
-        canSchedule = (!canSchedule) ? instructionLevelParallelism.checkMarkInstructionToSched(cur_inst, false) : canSchedule;
-        if (canSchedule) {
-          SCMULATE_INFOMSG(4, "Scheduling a BASIC_ARITH_INST %s", cur_inst->getInstruction().c_str());
-          hasBeenSched = true;
-          TIMERS_COUNTERS_GUARD(
-              this->time_cnt_m->addEvent(this->su_timer_name, EXECUTE_ARITH_INSTRUCTION););
-          executeArithmeticInstructions(cur_inst);
-          TIMERS_COUNTERS_GUARD(
-              this->time_cnt_m->addEvent(this->su_timer_name, SU_IDLE););
-          instructionLevelParallelism.instructionFinished(cur_inst);
-        }
-        break;
-      case EXECUTE_INST:
-        canSchedule = instructionLevelParallelism.checkMarkInstructionToSched(cur_inst);
-        if (canSchedule) {
-          SCMULATE_INFOMSG(4, "Scheduling an EXECUTE_INST %s", cur_inst->getInstruction().c_str());
-          hasBeenSched = attemptAssignExecuteInstruction(cur_inst);
-          TIMERS_COUNTERS_GUARD(
-              this->time_cnt_m->addEvent(this->su_timer_name, SU_IDLE););
-        }
-        break;
-      case MEMORY_INST:
-        canSchedule = instructionLevelParallelism.checkMarkInstructionToSched(cur_inst);
-        if (canSchedule) {
-          SCMULATE_INFOMSG(4, "Scheduling a MEMORY_INST %s", cur_inst->getInstruction().c_str());
-          hasBeenSched = attemptAssignExecuteInstruction(cur_inst);
-          TIMERS_COUNTERS_GUARD(
-              this->time_cnt_m->addEvent(this->su_timer_name, SU_IDLE););
-        }
-        break;
-      default:
-        SCMULATE_ERROR(0, "Instruction not recognized");
+    case COMMIT:
+      if (instructionLevelParallelism.checkMarkInstructionToSched(cur_inst, false)) {
+        SCMULATE_INFOMSG(4, "Scheduling and Exec a COMMIT");
+        SCMULATE_INFOMSG(1, "Turning off machine alive = false");
         hasBeenSched = true;
+        renameStage.retire(cur_inst);
+        renameStage.commit();
         #pragma omp atomic write
         *(this->aliveSignal) = false;
-        break;
       }
-
-      if (!canSchedule && !showOnlyOnce) {
-        SCMULATE_INFOMSG(4, "Instruction %s cannot be scheduled yet", cur_inst->getInstruction().c_str());
-        showOnlyOnce = true;
+      break;
+    case CONTROL_INST:
+      if (instructionLevelParallelism.checkMarkInstructionToSched(cur_inst, false)) {
+        SCMULATE_INFOMSG(4, "Scheduling a CONTROL_INST %s", cur_inst->getInstruction().c_str());
+        hasBeenSched = true;
+        TIMERS_COUNTERS_GUARD(
+            this->time_cnt_m->addEvent(this->su_timer_name, EXECUTE_CONTROL_INSTRUCTION, cur_inst->getInstruction()););
+        // Fetch stopped at this instruction, therefore PC still points to it
+        executeControlInstruction(cur_inst);
         TIMERS_COUNTERS_GUARD(
-              this->time_cnt_m->addEvent(this->su_timer_name, SU_IDLE););
+            this->time_cnt_m->addEvent(this->su_timer_name, SU_IDLE););
+        instructionLevelParallelism.instructionFinished(cur_inst);
+        renameStage.retire(cur_inst);
+        this->PC++;
+        this->fetchStalled = false;
       }
-      // Check if instructions have finished
-      for (uint32_t i = 0; i < this->ctrl_st_m->numExecutors(); i++)
-      {
-        if (this->ctrl_st_m->get_executor(i)->is_done())
-        {
-          SCMULATE_INFOMSG(5, "Instruction %s has finished executing", this->ctrl_st_m->get_executor(i)->getHead()->getInstruction().c_str());
-          instructionLevelParallelism.instructionFinished(this->ctrl_st_m->get_executor(i)->getHead());
-          this->ctrl_st_m->get_executor(i)->empty_slot();
+      break;
+    case BASIC_ARITH_INST:
+      if (instructionLevelParallelism.checkMarkInstructionToSched(cur_inst, false)) {
+        SCMULATE_INFOMSG(4, "Scheduling a BASIC_ARITH_INST %s", cur_inst->getInstruction().c_str());
+        hasBeenSched = true;
+        TIMERS_COUNTERS_GUARD(
+            this->time_cnt_m->addEvent(this->su_timer_name, EXECUTE_ARITH_INSTRUCTION););
+        executeArithmeticInstructions(cur_inst);
+        TIMERS_COUNTERS_GUARD(
+            this->time_cnt_m->addEvent(this->su_timer_name, SU_IDLE););
+        instructionLevelParallelism.instructionFinished(cur_inst);
+        renameStage.retire(cur_inst);
+      }
+      break;
+    case EXECUTE_INST:
+    case MEMORY_INST:
+      // Only mark the hazards if there is a CU that can take the instruction
+      if (freeExecutors != 0 && instructionLevelParallelism.checkMarkInstructionToSched(cur_inst)) {
+        SCMULATE_INFOMSG(4, "Scheduling %s %s", cur_inst->getType() == EXECUTE_INST ? "an EXECUTE_INST" : "a MEMORY_INST", cur_inst->getInstruction().c_str());
+        hasBeenSched = attemptAssignExecuteInstruction(cur_inst);
+        if (hasBeenSched) {
+          freeExecutors--;
+        } else {
+          // The free entries were counted before the CUs took more instructions. The marks are 
+          // undone, otherwise the instruction would see a hazard with itself in the next pass
+          SCMULATE_INFOMSG(5, "Could not assign %s to a free CU, it stays in the reservation table", cur_inst->getInstruction().c_str());
+          instructionLevelParallelism.instructionFinished(cur_inst);
+          freeExecutors = 0;
         }
+        TIMERS_COUNTERS_GUARD(
+            this->time_cnt_m->addEvent(this->su_timer_name, SU_IDLE););
       }
+      break;
+    default:
+      SCMULATE_ERROR(0, "Instruction not recognized");
+      hasBeenSched = true;
+      this->failed = true;
+      #pragma omp atomic write
+      *(this->aliveSignal) = false;
+      break;
+    }
+
+    if (!hasBeenSched) {
+      SCMULATE_INFOMSG(5, "Instruction %s cannot be scheduled yet", cur_inst->getInstruction().c_str());
+      instructionLevelParallelism.instructionPending(cur_inst);
+      this->reservationTable[remaining++] = cur_inst;
     }
-    this->PC++;
   }
-  SCMULATE_INFOMSG(1, "Shutting down fetch decode unit");
+  this->reservationTable.resize(remaining);
+  instructionLevelParallelism.reservationTableScanned();
   TIMERS_COUNTERS_GUARD(
-      this->time_cnt_m->addEvent(this->su_timer_name, SU_END););
-  return 0;
+      this->time_cnt_m->addEvent(this->su_timer_name, SU_IDLE););
 }
 
 void scm::fetch_decode_module::executeControlInstruction(scm::decoded_instruction_t *inst)
 {
-
+  switch (inst->getOpcode())
+  {
   /////////////////////////////////////////////////////
   ///// CONTROL LOGIC FOR THE JMPLBL INSTRUCTION
   /////////////////////////////////////////////////////
-  if (inst->getInstruction() == "JMPLBL")
+  case OPC_JMPLBL:
   {
-    int newPC = this->inst_mem_m->getMemoryLabel(inst->getOp1Str()) - 1;
-    SCMULATE_ERROR_IF(0, newPC == -1, "Incorrect label translation");
-    PC = newPC;
-    return;
+    // The label was resolved to an absolute PC by the instruction memory
+    PC = inst->getOp1().value.immediate - 1;
+    break;
   }
   /////////////////////////////////////////////////////
   ///// CONTROL LOGIC FOR THE JMPPC INSTRUCTION
   /////////////////////////////////////////////////////
-  if (inst->getInstruction() == "JMPPC")
+  case OPC_JMPPC:
   {
     int offset = inst->getOp1().value.immediate;
     int target = offset + PC - 1;
     SCMULATE_ERROR_IF(0, ((uint32_t)target > this->inst_mem_m->getMemSize() || target < 0), "Incorrect destination offset");
     PC = target;
-    return;
+    break;
   }
   /////////////////////////////////////////////////////
   ///// CONTROL LOGIC FOR THE BREQ INSTRUCTION
   /////////////////////////////////////////////////////
-  if (inst->getInstruction() == "BREQ")
+  case OPC_BREQ:
   {
     decoded_reg_t reg1 = inst->getOp1().value.reg;
     decoded_reg_t reg2 = inst->getOp2().value.reg;
     unsigned char *reg1_ptr = reg1.reg_ptr;
     unsigned char *reg2_ptr = reg2.reg_ptr;
-    SCMULATE_INFOMSG(4, "Comparing register %s %d to %s %d", reg1.reg_size.c_str(), reg1.reg_number, reg2.reg_size.c_str(), reg2.reg_number);
+    SCMULATE_INFOMSG(4, "Comparing register %s %d to %s %d", reg_file_module::getRegisterSizeName(reg1.reg_size_class), reg1.reg_number, reg_file_module::getRegisterSizeName(reg2.reg_size_class), reg2.reg_number);
     bool bitComparison = true;
-    SCMULATE_ERROR_IF(0, reg1.reg_size != reg2.reg_size, "Attempting to compare registers of different size");
+    SCMULATE_ERROR_IF(0, reg1.reg_size_class != reg2.reg_size_class, "Attempting to compare registers of different size");
     for (uint32_t i = 0; i < reg1.reg_size_bytes; ++i)
     {
       if (reg1_ptr[i] ^ reg2_ptr[i])
@@ -182,20 +259,20 @@ void scm::fetch_decode_module::executeControlInstruction(scm::decoded_instructio
       SCMULATE_ERROR_IF(0, ((uint32_t)target > this->inst_mem_m->getMemSize() || target < 0), "Incorrect destination offset");
       PC = target;
     }
-    return;
+    break;
   }
   /////////////////////////////////////////////////////
   ///// CONTROL LOGIC FOR THE BGT INSTRUCTION
   /////////////////////////////////////////////////////
-  if (inst->getInstruction() == "BGT")
+  case OPC_BGT:
   {
     decoded_reg_t reg1 = inst->getOp1().value.reg;
     decoded_reg_t reg2 = inst->getOp2().value.reg;
     unsigned char *reg1_ptr = reg1.reg_ptr;
     unsigned char *reg2_ptr = reg2.reg_ptr;
-    SCMULATE_INFOMSG(4, "Comparing register %s %d to %s %d", reg1.reg_size.c_str(), reg1.reg_number, reg2.reg_size.c_str(), reg2.reg_number);
+    SCMULATE_INFOMSG(4, "Comparing register %s %d to %s %d", reg_file_module::getRegisterSizeName(reg1.reg_size_class), reg1.reg_number, reg_file_module::getRegisterSizeName(reg2.reg_size_class), reg2.reg_number);
     bool reg1_gt_reg2 = false;
-    SCMULATE_ERROR_IF(0, reg1.reg_size != reg2.reg_size, "Attempting to compare registers of different size");
+    SCMULATE_ERROR_IF(0, reg1.reg_size_class != reg2.reg_size_class, "Attempting to compare registers of different size");
     for (uint32_t i = 0; i < reg1.reg_size_bytes; ++i)
     {
       // Find the first byte from MSB to LSB that is different in reg1 and reg2. If reg1 > reg2 in that byte, then reg1 > reg2 in general
@@ -212,20 +289,20 @@ void scm::fetch_decode_module::executeControlInstruction(scm::decoded_instructio
       SCMULATE_ERROR_IF(0, ((uint32_t)target > this->inst_mem_m->getMemSize() || target < 0), "Incorrect destination offset");
       PC = target;
     }
-    return;
+    break;
   }
   /////////////////////////////////////////////////////
   ///// CONTROL LOGIC FOR THE BGET INSTRUCTION
   /////////////////////////////////////////////////////
-  if (inst->getInstruction() == "BGET")
+  case OPC_BGET:
   {
     decoded_reg_t reg1 = inst->getOp1().value.reg;
     decoded_reg_t reg2 = inst->getOp2().value.reg;
     unsigned char *reg1_ptr = reg1.reg_ptr;
     unsigned char *reg2_ptr = reg2.reg_ptr;
-    SCMULATE_INFOMSG(4, "Comparing register %s %d to %s %d", reg1.reg_size.c_str(), reg1.reg_number, reg2.reg_size.c_str(), reg2.reg_number);
+    SCMULATE_INFOMSG(4, "Comparing register %s %d to %s %d", reg_file_module::getRegisterSizeName(reg1.reg_size_class), reg1.reg_number, reg_file_module::getRegisterSizeName(reg2.reg_size_class), reg2.reg_number);
     bool reg1_get_reg2 = false;
-    SCMULATE_ERROR_IF(0, reg1.reg_size != reg2.reg_size, "Attempting to compare registers of different size");
+    SCMULATE_ERROR_IF(0, reg1.reg_size_class != reg2.reg_size_class, "Attempting to compare registers of different size");
     uint32_t size_reg_bytes = reg1.reg_size_bytes;
     for (uint32_t i = 0; i < size_reg_bytes; ++i)
     {
@@ -246,20 +323,20 @@ void scm::fetch_decode_module::executeControlInstruction(scm::decoded_instructio
       SCMULATE_ERROR_IF(0, ((uint32_t)target > this->inst_mem_m->getMemSize() || target < 0), "Incorrect destination offset");
       PC = target;
     }
-    return;
+    break;
   }
   /////////////////////////////////////////////////////
   ///// CONTROL LOGIC FOR THE BLT INSTRUCTION
   /////////////////////////////////////////////////////
-  if (inst->getInstruction() == "BLT")
+  case OPC_BLT:
   {
     decoded_reg_t reg1 = inst->getOp1().value.reg;
     decoded_reg_t reg2 = inst->getOp2().value.reg;
     unsigned char *reg1_ptr = reg1.reg_ptr;
     unsigned char *reg2_ptr = reg2.reg_ptr;
-    SCMULATE_INFOMSG(4, "Comparing register %s %d to %s %d", reg1.reg_size.c_str(), reg1.reg_number, reg2.reg_size.c_str(), reg2.reg_number);
+    SCMULATE_INFOMSG(4, "Comparing register %s %d to %s %d", reg_file_module::getRegisterSizeName(reg1.reg_size_class), reg1.reg_number, reg_file_module::getRegisterSizeName(reg2.reg_size_class), reg2.reg_number);
     bool reg1_lt_reg2 = false;
-    SCMULATE_ERROR_IF(0, reg1.reg_size != reg2.reg_size, "Attempting to compare registers of different size");
+    SCMULATE_ERROR_IF(0, reg1.reg_size_class != reg2.reg_size_class, "Attempting to compare registers of different size");
     for (uint32_t i = 0; i < reg1.reg_size_bytes; ++i)
     {
       // Find the first byte from MSB to LSB that is different in reg1 and reg2. If reg1 < reg2 in that byte, then reg1 < reg2 in general
@@ -276,20 +353,20 @@ void scm::fetch_decode_module::executeControlInstruction(scm::decoded_instructio
       SCMULATE_ERROR_IF(0, ((uint32_t)target > this->inst_mem_m->getMemSize() || target < 0), "Incorrect destination offset");
       PC = target;
     }
-    return;
+    break;
   }
   /////////////////////////////////////////////////////
   ///// CONTROL LOGIC FOR THE BLET INSTRUCTION
   /////////////////////////////////////////////////////
-  if (inst->getInstruction() == "BLET")
+  case OPC_BLET:
   {
     decoded_reg_t reg1 = inst->getOp1().value.reg;
     decoded_reg_t reg2 = inst->getOp2().value.reg;
     unsigned char *reg1_ptr = reg1.reg_ptr;
     unsigned char *reg2_ptr = reg2.reg_ptr;
-    SCMULATE_INFOMSG(4, "Comparing register %s %d to %s %d", reg1.reg_size.c_str(), reg1.reg_number, reg2.reg_size.c_str(), reg2.reg_number);
+    SCMULATE_INFOMSG(4, "Comparing register %s %d to %s %d", reg_file_module::getRegisterSizeName(reg1.reg_size_class), reg1.reg_number, reg_file_module::getRegisterSizeName(reg2.reg_size_class), reg2.reg_number);
     bool reg1_let_reg2 = false;
-    SCMULATE_ERROR_IF(0, reg1.reg_size != reg2.reg_size, "Attempting to compare registers of different size");
+    SCMULATE_ERROR_IF(0, reg1.reg_size_class != reg2.reg_size_class, "Attempting to compare registers of different size");
     uint32_t size_reg_bytes = reg1.reg_size_bytes;
     for (uint32_t i = 0; i < size_reg_bytes; ++i)
     {
@@ -310,174 +387,139 @@ void scm::fetch_decode_module::executeControlInstruction(scm::decoded_instructio
       SCMULATE_ERROR_IF(0, ((uint32_t)target > this->inst_mem_m->getMemSize() || target < 0), "Incorrect destination offset");
       PC = target;
     }
-    return;
+    break;
+  }
+  default:
+    SCMULATE_ERROR(0, "Instruction %s is not a control instruction", inst->getInstruction().c_str());
+    break;
   }
 }
+
 void scm::fetch_decode_module::executeArithmeticInstructions(scm::decoded_instruction_t *inst)
 {
+  switch (inst->getOpcode())
+  {
   /////////////////////////////////////////////////////
   ///// ARITHMETIC LOGIC FOR THE ADD INSTRUCTION
   /////////////////////////////////////////////////////
-  if (inst->getInstruction() == "ADD")
+  case OPC_ADD:
   {
     decoded_reg_t reg1 = inst->getOp1().value.reg;
     decoded_reg_t reg2 = inst->getOp2().value.reg;
-    // Second operand may be register or immediate. We assumme immediate are no longer than a long long
+    // Second operand may be register or immediate. The immediate is signed, and no longer than a long long
     if (inst->getOp3().type == scm::operand_t::IMMEDIATE_VAL)
     {
       // IMMEDIATE ADDITION CASE
-      // TODO: Think about the signed option of these operands
-      uint64_t immediate_val = inst->getOp3().value.immediate;
-
-      unsigned char *reg2_ptr = reg2.reg_ptr;
-
-      // Where to store the result
-      unsigned char *reg1_ptr = reg1.reg_ptr;
-      int32_t size_reg_bytes = reg1.reg_size_bytes;
-
-      // Addition
-      uint32_t temp = 0;
-      for (int32_t i = size_reg_bytes - 1; i >= 0; --i)
-      {
-        temp += (immediate_val & 255) + (reg2_ptr[i]);
-        reg1_ptr[i] = temp & 255;
-        immediate_val >>= 8;
-        // Carry on
-        temp = temp > 255 ? 1 : 0;
-      }
+      int64_t immediate_val = inst->getOp3().value.immediate;
+      bool carry = register_arith::addImmediate(reg1.reg_ptr, reg1.reg_size_bytes, reg2.reg_ptr, reg2.reg_size_bytes, immediate_val);
+      SCMULATE_ERROR_IF(0, carry && immediate_val < 0, "Registers must be possitive numbers, ADD of a negative immediate resulted in a negative number. Borrow was 1 at the end of the operation");
+      (void) carry;
     }
     else
     {
       // REGISTER REGISTER ADD CASE
       decoded_reg_t reg3 = inst->getOp3().value.reg;
-      unsigned char *reg2_ptr = reg2.reg_ptr;
-      unsigned char *reg3_ptr = reg3.reg_ptr;
-
-      // Where to store the result
-      unsigned char *reg1_ptr = reg1.reg_ptr;
-      int32_t size_reg_bytes = reg1.reg_size_bytes;
-
-      // Addition
-      int temp = 0;
-      for (int32_t i = size_reg_bytes - 1; i >= 0; --i)
-      {
-        temp += (reg3_ptr[i]) + (reg2_ptr[i]);
-        reg1_ptr[i] = temp & 255;
-        // Carry on
-        temp = temp > 255 ? 1 : 0;
-      }
+      register_arith::add(reg1.reg_ptr, reg1.reg_size_bytes, reg2.reg_ptr, reg2.reg_size_bytes, reg3.reg_ptr, reg3.reg_size_bytes);
     }
-    return;
+    break;
   }
 
   /////////////////////////////////////////////////////
   ///// ARITHMETIC LOGIC FOR THE SUB INSTRUCTION
   /////////////////////////////////////////////////////
-  if (inst->getInstruction() == "SUB")
+  case OPC_SUB:
   {
     decoded_reg_t reg1 = inst->getOp1().value.reg;
     decoded_reg_t reg2 = inst->getOp2().value.reg;
 
-    // Second operand may be register or immediate. We assumme immediate are no longer than a long long
+    // Second operand may be register or immediate. The immediate is signed, and no longer than a long long
     if (inst->getOp3().type == scm::operand_t::IMMEDIATE_VAL)
     {
-      // IMMEDIATE ADDITION CASE
-      // TODO: Think about the signed option of these operands
-      uint16_t immediate_val = inst->getOp3().value.immediate;
-
-      unsigned char *reg2_ptr = reg2.reg_ptr;
-
-      // Where to store the result
-      unsigned char *reg1_ptr = reg1.reg_ptr;
-      int32_t size_reg_bytes = reg1.reg_size_bytes;
-
-      // Subtraction
-      uint32_t temp = 0;
-      for (int32_t i = size_reg_bytes - 1; i >= 0; --i)
-      {
-        uint32_t cur_byte = immediate_val & 255;
-        if (reg2_ptr[i] < cur_byte + temp)
-        {
-          reg1_ptr[i] = reg2_ptr[i] + 256 - temp - cur_byte;
-          temp = 1; // Increase carry
-        }
-        else
-        {
-          reg1_ptr[i] = reg2_ptr[i] - temp - cur_byte;
-          temp = 0; // Carry has been used
-        }
-        immediate_val >>= 8;
-      }
-      SCMULATE_ERROR_IF(0, temp == 1, "Registers must be possitive numbers, addition of numbers resulted in negative number. Carry was 1 at the end of the operation");
+      // IMMEDIATE SUBTRACTION CASE
+      int64_t immediate_val = inst->getOp3().value.immediate;
+      bool borrow = register_arith::subImmediate(reg1.reg_ptr, reg1.reg_size_bytes, reg2.reg_ptr, reg2.reg_size_bytes, immediate_val);
+      SCMULATE_ERROR_IF(0, borrow && immediate_val >= 0, "Registers must be possitive numbers, SUB resulted in a negative number. Borrow was 1 at the end of the operation");
+      (void) borrow;
     }
     else
     {
-      // REGISTER REGISTER ADD CASE
+      // REGISTER REGISTER SUB CASE
       decoded_reg_t reg3 = inst->getOp3().value.reg;
-      unsigned char *reg2_ptr = reg2.reg_ptr;
-      unsigned char *reg3_ptr = reg3.reg_ptr;
-
-      // Where to store the result
-      unsigned char *reg1_ptr = reg1.reg_ptr;
-      int32_t size_reg_bytes = reg1.reg_size_bytes;
-
-      // Subtraction
-      uint32_t temp = 0;
-      for (int32_t i = size_reg_bytes - 1; i >= 0; --i)
-      {
-        if (reg2_ptr[i] < reg3_ptr[i] + temp)
-        {
-          reg1_ptr[i] = reg2_ptr[i] + 256 - temp - reg3_ptr[i];
-          temp = 1; // Increase carry
-        }
-        else
-        {
-          reg1_ptr[i] = reg2_ptr[i] - temp - reg3_ptr[i];
-          temp = 0; // Carry has been used
-        }
-      }
-      SCMULATE_ERROR_IF(0, temp == 1, "Registers must be possitive numbers, addition of numbers resulted in negative number. Carry was 1 at the end of the operation");
+      bool borrow = register_arith::sub(reg1.reg_ptr, reg1.reg_size_bytes, reg2.reg_ptr, reg2.reg_size_bytes, reg3.reg_ptr, reg3.reg_size_bytes);
+      SCMULATE_ERROR_IF(0, borrow, "Registers must be possitive numbers, SUB resulted in a negative number. Borrow was 1 at the end of the operation");
+      (void) borrow;
     }
-    return;
+    break;
   }
 
   /////////////////////////////////////////////////////
-  ///// ARITHMETIC LOGIC FOR THE SHFL INSTRUCTION
+  ///// ARITHMETIC LOGIC FOR THE SHFL AND SHFR INSTRUCTIONS
   /////////////////////////////////////////////////////
-  if (inst->getInstruction() == "SHFL")
+  case OPC_SHFL:
+  case OPC_SHFR:
   {
-    SCMULATE_ERROR(0, "THE SHFL OPERATION HAS NOT BEEN IMPLEMENTED. KILLING THIS")
-#pragma omp atomic write
-    *(this->aliveSignal) = false;
+    decoded_reg_t reg1 = inst->getOp1().value.reg;
+    bool left = inst->getOpcode() == OPC_SHFL;
+    uint64_t bits;
+    if (inst->getOp2().type == scm::operand_t::IMMEDIATE_VAL)
+    {
+      // A negative immediate shifts to the other side
+      int64_t immediate_val = inst->getOp2().value.immediate;
+      left = immediate_val < 0 ? !left : left;
+      bits = immediate_val < 0 ? -static_cast<uint64_t>(immediate_val) : immediate_val;
+    }
+    else
+    {
+      decoded_reg_t reg2 = inst->getOp2().value.reg;
+      bits = register_arith::toUint64(reg2.reg_ptr, reg2.reg_size_bytes);
+    }
+    if (left)
+      register_arith::shiftLeft(reg1.reg_ptr, reg1.reg_size_bytes, bits);
+    else
+      register_arith::shiftRight(reg1.reg_ptr, reg1.reg_size_bytes, bits);
+    break;
   }
 
   /////////////////////////////////////////////////////
-  ///// ARITHMETIC LOGIC FOR THE SHFR INSTRUCTION
+  ///// ARITHMETIC LOGIC FOR THE MULT INSTRUCTION
   /////////////////////////////////////////////////////
-  if (inst->getInstruction() == "SHFR")
+  case OPC_MULT:
   {
-    SCMULATE_ERROR(0, "THE SHFR OPERATION HAS NOT BEEN IMPLEMENTED. KILLING THIS")
+    decoded_reg_t reg1 = inst->getOp1().value.reg;
+    decoded_reg_t reg2 = inst->getOp2().value.reg;
+    if (inst->getOp3().type == scm::operand_t::IMMEDIATE_VAL)
+    {
+      int64_t immediate_val = inst->getOp3().value.immediate;
+      if (immediate_val < 0)
+      {
+        SCMULATE_ERROR(0, "Registers must be possitive numbers, MULT by a negative immediate is not supported. KILLING THIS")
+        this->failed = true;
 #pragma omp atomic write
-    *(this->aliveSignal) = false;
+        *(this->aliveSignal) = false;
+        break;
+      }
+      register_arith::multImmediate(reg1.reg_ptr, reg1.reg_size_bytes, reg2.reg_ptr, reg2.reg_size_bytes, immediate_val);
+    }
+    else
+    {
+      decoded_reg_t reg3 = inst->getOp3().value.reg;
+      register_arith::mult(reg1.reg_ptr, reg1.reg_size_bytes, reg2.reg_ptr, reg2.reg_size_bytes, reg3.reg_ptr, reg3.reg_size_bytes);
+    }
+    break;
+  }
+  default:
+    SCMULATE_ERROR(0, "Instruction %s is not a basic arithmetic instruction", inst->getInstruction().c_str());
+    break;
   }
 }
 
+
 bool scm::fetch_decode_module::attemptAssignExecuteInstruction(scm::decoded_instruction_t *inst)
 {
-  // TODO: Jose this is the point where you can select scheduing policies
-  static uint32_t curSched = 0;
-  bool sched = false;
-  uint32_t attempts = 0;
-  // We try scheduling on all the sched units
-  while (!sched && attempts++ < this->ctrl_st_m->numExecutors()) {
-    curSched++;
-    curSched %= this->ctrl_st_m->numExecutors();
-    if (this->ctrl_st_m->get_executor(curSched)->is_empty())
-    {
-      this->ctrl_st_m->get_executor(curSched)->assign(inst);
-      sched = true;
-    }
-  }
+  int32_t curSched = this->schedPolicy->selectExecutor(inst);
+  bool sched = curSched != -1 && this->ctrl_st_m->get_executor(curSched)->assign(inst);
+  if (sched)
+    this->schedPolicy->instructionAssigned(inst, curSched);
   if (!sched)
   {
     SCMULATE_INFOMSG(5, "Could not find a free unit");
@@ -1,5 +1,9 @@
 #include "instruction_mem.hpp"
 #include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 using namespace std;
 
@@ -24,8 +28,8 @@ scm::inst_mem_module::loader(char* filename) {
             SCMULATE_INFOMSG(4, "Found label: '%s'", label.c_str());
             labels[label] = curInst; 
           } else if (!instructions::isComment(line)) {
-            scm::decoded_instruction_t * inst = scm::instructions::findInstType(line); 
-            if (!inst->decodeOperands(this->reg_file_m)) {
+            scm::decoded_instruction_t inst = scm::instructions::findInstType(line, this->debug_text.emplace_back()); 
+            if (!inst.decodeOperands(this->reg_file_m, !this->assemble_only)) {
               SCMULATE_ERROR(0, "PROBLEM DECODING OPERANDS %s", filename);
               return false;
             }
@@ -39,21 +43,285 @@ scm::inst_mem_module::loader(char* filename) {
       SCMULATE_ERROR(0, "PROGRAM DOES NOT EXIST %s", filename);
       return false;
     }
-    return true;
+    return resolveLabels();
 }
 
-scm::inst_mem_module::inst_mem_module(char * filename, reg_file_module * const reg_file_m):
-  reg_file_m(reg_file_m) {
+bool
+scm::inst_mem_module::resolveLabels() {
+  for (auto & inst : this->memory) {
+    if (inst.getOpcode() != OPC_JMPLBL || inst.getOp1().type != operand_t::UNKNOWN)
+      continue;
+    int target = getMemoryLabel(inst.getOp1Str());
+    if (target == -1) {
+      SCMULATE_ERROR(0, "LABEL '%s' DOES NOT EXIST", inst.getOp1Str().c_str());
+      return false;
+    }
+    operand_t newOp;
+    newOp.type = operand_t::IMMEDIATE_VAL;
+    newOp.value.immediate = target;
+    inst.setOp1(newOp);
+  }
+  return true;
+}
+
+bool
+scm::inst_mem_module::isImage(char * filename) {
+  uint32_t magic = 0;
+  ifstream file_stream(filename, ios::binary);
+  if (!file_stream.read(reinterpret_cast<char *>(&magic), sizeof(magic)))
+    return false;
+  return magic == SCM_IMAGE_MAGIC;
+}
+
+bool
+scm::inst_mem_module::imageLoader(char * filename) {
+  SCMULATE_INFOMSG(2, "LOADING IMAGE %s", filename);
+  int fd = open(filename, O_RDONLY);
+  if (fd == -1) {
+    SCMULATE_ERROR(0, "PROGRAM DOES NOT EXIST %s", filename);
+    return false;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) == -1 || static_cast<size_t>(file_stat.st_size) < sizeof(image_header_t)) {
+    SCMULATE_ERROR(0, "INVALID PROGRAM IMAGE %s", filename);
+    close(fd);
+    return false;
+  }
+  size_t file_size = file_stat.st_size;
+  void * mapped = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+  close(fd);
+  if (mapped == MAP_FAILED) {
+    SCMULATE_ERROR(0, "COULD NOT MAP PROGRAM IMAGE %s", filename);
+    return false;
+  }
+
+  const unsigned char * base = static_cast<const unsigned char *>(mapped);
+  const image_header_t * header = reinterpret_cast<const image_header_t *>(base);
+  // The header is checked before any of its counts is used to find the sections
+  if (header->magic != SCM_IMAGE_MAGIC || header->version != SCM_IMAGE_VERSION || header->byte_order != SCM_IMAGE_BYTE_ORDER) {
+    SCMULATE_ERROR(0, "PROGRAM IMAGE %s IS NOT AN IMAGE OR HAS AN INCOMPATIBLE VERSION OR BYTE ORDER", filename);
+    munmap(mapped, file_size);
+    return false;
+  }
+  uint64_t expected_size = sizeof(image_header_t) + static_cast<uint64_t>(header->num_insts)*sizeof(image_inst_t) + 
+                           static_cast<uint64_t>(header->num_labels)*sizeof(image_label_t) + 
+                           static_cast<uint64_t>(header->num_codelets)*sizeof(uint32_t) + header->strings_size;
+  if (expected_size != file_size) {
+    SCMULATE_ERROR(0, "PROGRAM IMAGE %s IS TRUNCATED OR CORRUPTED", filename);
+    munmap(mapped, file_size);
+    return false;
+  }
+  const image_inst_t * insts = reinterpret_cast<const image_inst_t *>(base + sizeof(image_header_t));
+  const image_label_t * img_labels = reinterpret_cast<const image_label_t *>(insts + header->num_insts);
+  const uint32_t * codelets = reinterpret_cast<const uint32_t *>(img_labels + header->num_labels);
+  const char * strings = reinterpret_cast<const char *>(codelets + header->num_codelets);
+
+  bool correct = true;
+  if (header->strings_size != 0 && strings[header->strings_size - 1] != '\0') {
+    SCMULATE_ERROR(0, "PROGRAM IMAGE %s IS TRUNCATED OR CORRUPTED", filename);
+    correct = false;
+  }
+
+  // Codelets are resolved once per ID, not once per instruction
+  std::vector<creatorFnc> creators(correct ? header->num_codelets : 0, nullptr);
+  for (uint32_t i = 0; i < creators.size() && correct; i++) {
+    if (codelets[i] >= header->strings_size || (creators[i] = codeletFactory::getCreator(strings + codelets[i])) == nullptr) {
+      SCMULATE_ERROR(0, "PROGRAM IMAGE %s USES AN UNKNOWN CODELET", filename);
+      correct = false;
+    }
+  }
+
+  for (uint32_t i = 0; i < header->num_labels && correct; i++) {
+    if (img_labels[i].name >= header->strings_size) {
+      correct = false;
+      break;
+    }
+    labels[strings + img_labels[i].name] = img_labels[i].pc;
+  }
+
+  this->memory.reserve(correct ? header->num_insts : 0);
+  for (uint32_t i = 0; i < header->num_insts && correct; i++) {
+    const image_inst_t & cur = insts[i];
+    instType type = static_cast<instType>(cur.type);
+    size_t group_size = 0;
+    const inst_def_t * group = instructions::getDefGroup(type, group_size);
+    inst_text_t & text = this->debug_text.emplace_back();
+    decoded_instruction_t inst;
+
+    if (type == COMMIT) {
+      text.instruction = "COMMIT";
+      inst = decoded_instruction_t(COMMIT, &text);
+    } else if (type == EXECUTE_INST && cur.def_index < creators.size()) {
+      text.instruction = strings + codelets[cur.def_index];
+      inst = decoded_instruction_t(EXECUTE_INST, &text);
+    } else if (group != nullptr && cur.def_index < group_size) {
+      text.instruction = group[cur.def_index].inst_name;
+      inst = decoded_instruction_t(type, group[cur.def_index].opcode, &text);
+    } else {
+      SCMULATE_ERROR(0, "PROGRAM IMAGE %s CONTAINS AN UNKNOWN INSTRUCTION", filename);
+      correct = false;
+      break;
+    }
+    inst.setOpIO(cur.op_in_out);
+
+    for (int op = 0; op < 3; op++) {
+      const image_operand_t & cur_op = cur.ops[op];
+      operand_t newOp;
+      if (cur_op.type == operand_t::REGISTER) {
+        newOp.type = operand_t::REGISTER;
+        newOp.value.reg = decoded_reg_t(cur_op.reg_size_class, reg_file_m->getRegisterSizeInBytes(cur_op.reg_size_class), cur_op.reg_number, 
+                                        reg_file_m->getRegisterId(cur_op.reg_size_class, cur_op.reg_number),
+                                        reg_file_m->getRegisterByClass(cur_op.reg_size_class, cur_op.reg_number));
+        if (newOp.value.reg.reg_ptr == nullptr || newOp.value.reg.reg_id == reg_file_m->numRegisters()) {
+          correct = false;
+          break;
+        }
+      } else if (cur_op.type == operand_t::IMMEDIATE_VAL) {
+        newOp.type = operand_t::IMMEDIATE_VAL;
+        newOp.value.immediate = cur_op.value;
+      } else if (cur_op.value != 0 || cur_op.reg_number != 0) {
+        // Undecoded operand (JMPLBL label of images that were written before the labels were resolved)
+        if (cur_op.value >= header->strings_size) {
+          correct = false;
+          break;
+        }
+        if (op == 0) text.op1_s = strings + cur_op.value;
+        continue;
+      } else {
+        continue;
+      }
+      newOp.read = (cur.op_in_out >> (op*2)) & OP_IO::OP1_RD;
+      newOp.write = (cur.op_in_out >> (op*2)) & OP_IO::OP1_WR;
+      if (op == 0) inst.setOp1(newOp);
+      else if (op == 1) inst.setOp2(newOp);
+      else inst.setOp3(newOp);
+    }
+
+    if (correct && type == EXECUTE_INST)
+      correct = inst.bindCodelet(creators[cur.def_index]);
+    // An instruction with an operand that could not be decoded is not added
+    if (!correct)
+      break;
+    this->memory.push_back(inst);
+  }
+  SCMULATE_ERROR_IF(0, !correct, "PROBLEM LOADING PROGRAM IMAGE %s", filename);
+
+  munmap(mapped, file_size);
+  return correct && resolveLabels();
+}
+
+bool
+scm::inst_mem_module::writeImage(char * filename) {
+  std::vector<image_inst_t> insts(this->memory.size());
+  std::vector<image_label_t> img_labels;
+  std::vector<uint32_t> codelets;
+  std::map<std::string, uint32_t> codeletIDs;
+  std::map<std::string, uint32_t> stringOffsets;
+  std::string strings(1, '\0'); // Offset 0 is the empty string
+  auto addString = [&strings, &stringOffsets] (std::string str) {
+    auto found = stringOffsets.find(str);
+    if (found != stringOffsets.end())
+      return found->second;
+    uint32_t offset = strings.size();
+    strings.append(str);
+    strings.push_back('\0');
+    stringOffsets[str] = offset;
+    return offset;
+  };
+
+  for (size_t i = 0; i < this->memory.size(); i++) {
+    decoded_instruction_t * inst = &this->memory[i];
+    image_inst_t & cur = insts[i];
+    std::memset(&cur, 0, sizeof(image_inst_t));
+    cur.type = inst->getType();
+    cur.op_in_out = inst->getOpIO();
+
+    if (inst->getType() == EXECUTE_INST) {
+      auto found = codeletIDs.find(inst->getInstruction());
+      if (found == codeletIDs.end()) {
+        found = codeletIDs.emplace(inst->getInstruction(), codelets.size()).first;
+        codelets.push_back(addString(inst->getInstruction()));
+      }
+      cur.def_index = found->second;
+    } else if (inst->getType() != COMMIT) {
+      size_t group_size = 0;
+      const inst_def_t * group = instructions::getDefGroup(inst->getType(), group_size);
+      cur.def_index = group_size;
+      for (size_t def = 0; def < group_size; def++)
+        if (group[def].inst_name == inst->getInstruction())
+          cur.def_index = def;
+      if (cur.def_index == group_size) {
+        SCMULATE_ERROR(0, "INSTRUCTION %lu CANNOT BE WRITTEN IN THE IMAGE", i);
+        return false;
+      }
+    }
+
+    operand_t * ops[3] = {&inst->getOp1(), &inst->getOp2(), &inst->getOp3()};
+    for (int op = 0; op < 3; op++) {
+      cur.ops[op].type = ops[op]->type;
+      if (ops[op]->type == operand_t::REGISTER) {
+        cur.ops[op].reg_size_class = ops[op]->value.reg.reg_size_class;
+        cur.ops[op].reg_number = ops[op]->value.reg.reg_number;
+      } else if (ops[op]->type == operand_t::IMMEDIATE_VAL) {
+        cur.ops[op].value = ops[op]->value.immediate;
+      }
+    }
+  }
+
+  for (auto & label : this->labels)
+    img_labels.push_back({addString(label.first), static_cast<uint32_t>(label.second)});
+
+  image_header_t header;
+  std::memset(&header, 0, sizeof(image_header_t));
+  header.magic = SCM_IMAGE_MAGIC;
+  header.version = SCM_IMAGE_VERSION;
+  header.byte_order = SCM_IMAGE_BYTE_ORDER;
+  header.num_insts = insts.size();
+  header.num_labels = img_labels.size();
+  header.num_codelets = codelets.size();
+  header.strings_size = strings.size();
+
+  ofstream file_stream(filename, ios::binary | ios::trunc);
+  if (!file_stream.is_open()) {
+    SCMULATE_ERROR(0, "COULD NOT WRITE PROGRAM IMAGE %s", filename);
+    return false;
+  }
+  file_stream.write(reinterpret_cast<char *>(&header), sizeof(header));
+  file_stream.write(reinterpret_cast<char *>(insts.data()), insts.size()*sizeof(image_inst_t));
+  file_stream.write(reinterpret_cast<char *>(img_labels.data()), img_labels.size()*sizeof(image_label_t));
+  file_stream.write(reinterpret_cast<char *>(codelets.data()), codelets.size()*sizeof(uint32_t));
+  file_stream.write(strings.data(), strings.size());
+  file_stream.close();
+  SCMULATE_INFOMSG(2, "WROTE IMAGE %s WITH %u INSTRUCTIONS", filename, header.num_insts);
+  return file_stream.good();
+}
+
+scm::inst_mem_module::inst_mem_module(char * filename, reg_file_module * const reg_file_m, bool assembleOnly):
+  reg_file_m(reg_file_m), assemble_only(assembleOnly) {
   SCMULATE_INFOMSG(3, "CREATING INSTRUCTION MEMORY");
+  this->load(filename);
+}
+
+bool
+scm::inst_mem_module::load(char * filename) {
+  for (auto & it : this->memory)
+    it.releaseCodelet();
+  this->memory.clear();
+  this->debug_text.clear();
+  this->labels.clear();
   this->is_valid = true;
   // Open the file, if specified, otherwise read from stdio
   string line = "";
   if (strlen(filename) != 0) {
-    this->is_valid = this->loader(filename);
+    if (isImage(filename))
+      this->is_valid = this->imageLoader(filename);
+    else
+      this->is_valid = this->loader(filename);
   } else {
     while ((cin >> line) && line != "-")
-      this->memory.push_back(scm::instructions::findInstType(line));
+      this->memory.push_back(scm::instructions::findInstType(line, this->debug_text.emplace_back()));
   }
+  return this->is_valid;
 }
 
 void
@@ -61,11 +329,11 @@ scm::inst_mem_module::dumpMemory() {
 
   auto it = this->memory.rbegin();
   for (; it != this->memory.rend(); it++) 
-    cout << "-" << static_cast<int>(it - memory.rbegin()) << " " << *it << endl;
+    cout << "-" << static_cast<int>(it - memory.rbegin()) << " " << it->getInstruction() << " " << it->getOp1Str() << " " << it->getOp2Str() << " " << it->getOp3Str() << endl;
 }
 
 scm::inst_mem_module::~inst_mem_module() {
-  for (auto it : this->memory) {
-    delete it;
+  for (auto & it : this->memory) {
+    it.releaseCodelet();
   }
 }
@@ -0,0 +1,71 @@
+#include "l2_memory.hpp"
+#include <iterator>
+
+scm::l2_memory_module::l2_memory_module(uint64_t memSize, bool hugePages) :
+  size((memSize + HUGE_PAGE_SIZE - 1)/HUGE_PAGE_SIZE*HUGE_PAGE_SIZE) {
+    memory = static_cast<l2_memory_t>(memory_pages::map(size, hugePages, pages));
+    if (memory == nullptr) {
+      SCMULATE_ERROR(0, "Could not map %lu bytes of L2 memory", size);
+      return;
+    }
+    SCMULATE_INFOMSG(1, "L2 memory of %lu bytes with %s", size, memory_pages::getName(pages));
+    free_ranges[0] = size;
+}
+
+l2_memory_t
+scm::l2_memory_module::l2Malloc(uint64_t bytes, uint64_t alignment) {
+  if (bytes == 0 || alignment == 0)
+    return nullptr;
+  for (auto it = free_ranges.begin(); it != free_ranges.end(); ++it) {
+    uint64_t start = it->first, end = it->first + it->second;
+    uint64_t aligned = (start + alignment - 1)/alignment*alignment;
+    if (aligned + bytes > end)
+      continue;
+    // The gaps before and after the array are still free
+    free_ranges.erase(it);
+    if (aligned > start)
+      free_ranges[start] = aligned - start;
+    if (aligned + bytes < end)
+      free_ranges[aligned + bytes] = end - aligned - bytes;
+    allocations[aligned] = bytes;
+    return memory + aligned;
+  }
+  SCMULATE_ERROR(0, "There is no free range of %lu bytes in the L2 memory", bytes);
+  return nullptr;
+}
+
+bool
+scm::l2_memory_module::l2Free(l2_memory_t array) {
+  auto allocation = allocations.find(offsetOf(array));
+  if (array < memory || allocation == allocations.end())
+    return false;
+  uint64_t start = allocation->first, end = allocation->first + allocation->second;
+  allocations.erase(allocation);
+  // Merge with the free ranges next to it
+  auto next = free_ranges.lower_bound(start);
+  if (next != free_ranges.end() && next->first == end) {
+    end += next->second;
+    next = free_ranges.erase(next);
+  }
+  if (next != free_ranges.begin()) {
+    auto prev = std::prev(next);
+    if (prev->first + prev->second == start) {
+      start = prev->first;
+      free_ranges.erase(prev);
+    }
+  }
+  free_ranges[start] = end - start;
+  return true;
+}
+
+uint64_t
+scm::l2_memory_module::freeBytes() {
+  uint64_t total = 0;
+  for (auto & range : free_ranges)
+    total += range.second;
+  return total;
+}
+
+scm::l2_memory_module::~l2_memory_module() {
+  memory_pages::unmap(memory, size);
+}
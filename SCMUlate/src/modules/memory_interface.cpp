@@ -2,7 +2,9 @@
 
 scm::mem_interface_module::mem_interface_module(l2_memory_t const memory):
   myInstructionSlot(nullptr),
-  memorySpace(memory)
+  memorySpace(memory),
+  bytes_read(0),
+  bytes_written(0)
   { }
 
 int
@@ -16,12 +18,13 @@ scm::mem_interface_module::behavior() {
  
 void
 scm::mem_interface_module::executeMemoryInstructions() {
+  switch (this->myInstructionSlot->getOpcode()) {
   /////////////////////////////////////////////////////
   ///// LOGIC FOR THE LDIMM INSTRUCTION
   ///// Operand 1 is where to load the instructions
   ///// Operand 2 the inmediate value to be used
   /////////////////////////////////////////////////////
-  if (this->myInstructionSlot->getInstruction() == "LDIMM") {
+  case OPC_LDIMM: {
     // Obtain destination register
     decoded_reg_t reg1 = myInstructionSlot->getOp1().value.reg;
     unsigned char * reg1_ptr = reg1.reg_ptr;
@@ -43,14 +46,14 @@ scm::mem_interface_module::executeMemoryInstructions() {
         reg1_ptr[i] = 0;
       }
     }
-    return;
+    break;
   }
   /////////////////////////////////////////////////////
-  ///// LOGIC FOR THE LDADDR INSTRUCTION
+  ///// LOGIC FOR THE LDADR INSTRUCTION
   ///// Operand 1 is where to load the instructions
   ///// Operand 2 is the memory address either a register or immediate value. Only consider 64 bits
   /////////////////////////////////////////////////////
-  if (this->myInstructionSlot->getInstruction() == "LDADDR") {
+  case OPC_LDADR: {
     // Obtain destination register
     decoded_reg_t reg1 = myInstructionSlot->getOp1().value.reg;
     unsigned char * reg1_ptr = reg1.reg_ptr;
@@ -78,7 +81,8 @@ scm::mem_interface_module::executeMemoryInstructions() {
     }
     // Perform actual memory copy
     std::memcpy(reg1_ptr, this->getAddress(base_addr), size_reg1_bytes);
-    return;
+    this->bytes_read += size_reg1_bytes;
+    break;
   }
   /////////////////////////////////////////////////////
   ///// LOGIC FOR THE LDOFF INSTRUCTION
@@ -86,7 +90,7 @@ scm::mem_interface_module::executeMemoryInstructions() {
   ///// Operand 2 is the memory address either a register or inmediate value. Only consider 64 bits
   ///// Operand 3 is the offset from the address memoery. Either register or inmediate value. Only consider 64 bits
   /////////////////////////////////////////////////////
-  if (this->myInstructionSlot->getInstruction() == "LDOFF") {
+  case OPC_LDOFF: {
     // Destination register
     decoded_reg_t reg1 = myInstructionSlot->getOp1().value.reg;
     unsigned char * reg1_ptr = reg1.reg_ptr;
@@ -133,12 +137,13 @@ scm::mem_interface_module::executeMemoryInstructions() {
     }
 
     std::memcpy(reg1_ptr, this->getAddress(base_addr+offset), size_reg1_bytes);
-    return;
+    this->bytes_read += size_reg1_bytes;
+    break;
   }
   /////////////////////////////////////////////////////
-  ///// LOGIC FOR THE STADDR INSTRUCTION
+  ///// LOGIC FOR THE STADR INSTRUCTION
   /////////////////////////////////////////////////////
-  if (this->myInstructionSlot->getInstruction() == "STADR") {
+  case OPC_STADR: {
     // Obtain destination register
     decoded_reg_t reg1 = myInstructionSlot->getOp1().value.reg;
     unsigned char * reg1_ptr = reg1.reg_ptr;
@@ -166,12 +171,13 @@ scm::mem_interface_module::executeMemoryInstructions() {
     }
     // Perform actual memory copy
     std::memcpy(this->getAddress(base_addr), reg1_ptr, size_reg1_bytes);
-    return;
+    this->bytes_written += size_reg1_bytes;
+    break;
   }
   /////////////////////////////////////////////////////
   ///// LOGIC FOR THE STOFF INSTRUCTION
   /////////////////////////////////////////////////////
-  if (this->myInstructionSlot->getInstruction() == "STOFF") {
+  case OPC_STOFF: {
     // Destination register
     decoded_reg_t reg1 = myInstructionSlot->getOp1().value.reg;
     unsigned char * reg1_ptr = reg1.reg_ptr;
@@ -218,6 +224,11 @@ scm::mem_interface_module::executeMemoryInstructions() {
     }
 
     std::memcpy(this->getAddress(base_addr+offset), reg1_ptr, size_reg1_bytes);
-    return;
+    this->bytes_written += size_reg1_bytes;
+    break;
+  }
+  default:
+    SCMULATE_ERROR(0, "Instruction %s is not a memory instruction", this->myInstructionSlot->getInstruction().c_str());
+    break;
   }
 }
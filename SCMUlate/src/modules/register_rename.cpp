@@ -0,0 +1,79 @@
+#include "register_rename.hpp"
+
+scm::register_rename_module::register_rename_module(inst_mem_module * const inst_mem,
+                                                    reg_file_module * const reg_file,
+                                                    uint32_t maxInstructions,
+                                                    bool enable) :
+                                                    reg_file_m(reg_file),
+                                                    enabled(enable),
+                                                    mapping(reg_file->numRegisters()),
+                                                    references(reg_file->numRegisters(), 1),
+                                                    in_pool(reg_file->numRegisters(), false),
+                                                    instances(enable ? maxInstructions : 0),
+                                                    num_renamed(0)
+{
+  this->load(inst_mem);
+}
+
+void
+scm::register_rename_module::load(inst_mem_module * const inst_mem) {
+  if (!enabled)
+    return;
+  for (uint32_t id = 0; id < reg_file_m->numRegisters(); id++)
+    mapping[id] = id;
+  std::fill(references.begin(), references.end(), 1);
+  std::fill(in_pool.begin(), in_pool.end(), false);
+  for (auto & pool : free_registers)
+    pool.clear();
+  free_instances.clear();
+  for (uint32_t i = instances.size(); i > 0; i--)
+    free_instances.push_back(i - 1);
+
+  // Registers that are not used by the program are the physical registers
+  std::vector<bool> used(reg_file_m->numRegisters(), false);
+  for (uint32_t pc = 0; pc < inst_mem->getMemSize(); pc++) {
+    decoded_instruction_t * inst = inst_mem->fetch(pc);
+    operand_t * ops[3] = {&inst->getOp1(), &inst->getOp2(), &inst->getOp3()};
+    for (int i = 0; i < 3; i++)
+      if (ops[i]->type == operand_t::REGISTER && ops[i]->value.reg.reg_id < reg_file_m->numRegisters())
+        used[ops[i]->value.reg.reg_id] = true;
+  }
+  for (uint8_t sizeClass = RENAMING_MIN_REG_SIZE_CLASS; sizeClass < reg_file_module::NUM_REG_SIZE_CLASSES; sizeClass++) {
+    for (uint32_t num = 0; reg_file_m->getRegisterId(sizeClass, num) != reg_file_m->numRegisters(); num++) {
+      uint32_t id = reg_file_m->getRegisterId(sizeClass, num);
+      if (used[id])
+        continue;
+      in_pool[id] = true;
+      references[id] = 0;
+      free_registers[sizeClass].push_back(id);
+    }
+    SCMULATE_INFOMSG(3, "Renaming R%s registers with %lu physical registers", reg_file_module::getRegisterSizeName(sizeClass), free_registers[sizeClass].size());
+  }
+}
+
+void
+scm::register_rename_module::commit() {
+  if (!enabled)
+    return;
+  for (uint8_t sizeClass = RENAMING_MIN_REG_SIZE_CLASS; sizeClass < reg_file_module::NUM_REG_SIZE_CLASSES; sizeClass++) {
+    for (uint32_t num = 0; reg_file_m->getRegisterId(sizeClass, num) != reg_file_m->numRegisters(); num++) {
+      uint32_t arch = reg_file_m->getRegisterId(sizeClass, num);
+      uint32_t phys = mapping[arch];
+      if (phys == arch)
+        continue;
+      SCMULATE_INFOMSG(4, "Committing R%s_%u from physical register %u", reg_file_module::getRegisterSizeName(sizeClass), num, phys);
+      std::memcpy(reg_file_m->getRegisterByClass(sizeClass, num), 
+                  reg_file_m->getRegisterByClass(sizeClass, phys - reg_file_m->getRegisterId(sizeClass, 0)),
+                  reg_file_module::getRegisterSizeInBytes(sizeClass));
+      mapping[arch] = arch;
+      releaseReference(phys, sizeClass);
+      references[arch]++;
+    }
+  }
+}
+
+scm::register_rename_module::~register_rename_module() {
+  for (auto & entry : instances)
+    if (entry.owns_codelet)
+      delete entry.inst.getExecCodelet();
+}
@@ -1,67 +1,121 @@
 #include "register.hpp"
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
+#include <fstream>
 
-scm::reg_file_module::reg_file_module() {
+scm::reg_file_module::reg_file_module(const register_geometry & registers, bool hugePages) :
+  geometry(registers) {
   SCMULATE_INFOMSG(3, "Initializing Register file");
-  reg_file = new register_file_t();
-  // Initialize the memory that represents the register
-  // file to zero
-  for (int i = 0; i < REG_FILE_SIZE_KB*1000 ; ++ i) {
-    reg_file->space[i] = 0;
-  }
+  // The new pages are zero, they are not touched here
+  reg_file = static_cast<unsigned char *>(memory_pages::map(getMappedSize(), hugePages, pages));
+  SCMULATE_INFOMSG(3, "Register file with %s", memory_pages::getName(pages));
   this->describeRegisterFile();
   this->checkRegisterConfig();
 }
 
+void
+scm::reg_file_module::reset() {
+  this->reset(0, 1);
+}
+
+void
+scm::reg_file_module::reset(uint32_t part, uint32_t parts) {
+  if (reg_file == nullptr || parts == 0)
+    return;
+  uint64_t pageSize = memory_pages::pageSize(pages);
+  uint64_t numPages = (getSpaceSize() + pageSize - 1)/pageSize;
+  uint64_t first = numPages*part/parts*pageSize;
+  uint64_t end = std::min(numPages*(part + 1)/parts*pageSize, static_cast<uint64_t>(getSpaceSize()));
+  // memset already uses the widest stores of the CPU
+  if (first < end)
+    std::memset(reg_file + first, 0, end - first);
+}
+
 void 
 scm::reg_file_module::describeRegisterFile() {
   SCMULATE_INFOMSG(0, "REGISTER FILE DEFINITION");
-  SCMULATE_INFOMSG(0, " SIZE = %ld", CALCULATE_REG_SIZE);
-  SCMULATE_INFOMSG(1, " %ld registers of 64BITS, each of %d bytes. Total size = %ld  -- %f percent ", NUM_REG_64BITS, 64/8, NUM_REG_64BITS*64/8, (NUM_REG_64BITS*64/8)*100.0f/CALCULATE_REG_SIZE);
-  SCMULATE_INFOMSG(1, " %ld registers of 1LINE each of %ld bytes. Total size = %ld  -- %f percent", NUM_REG_1LINE, CACHE_LINE_SIZE, NUM_REG_1LINE*CACHE_LINE_SIZE, NUM_REG_1LINE*CACHE_LINE_SIZE*100.0f/CALCULATE_REG_SIZE);
-  SCMULATE_INFOMSG(1, " %ld registers of 8LINE each of %ld bytes. Total size = %ld  -- %f percent", NUM_REG_8LINE, CACHE_LINE_SIZE*8, NUM_REG_8LINE*8*CACHE_LINE_SIZE, NUM_REG_8LINE*8*CACHE_LINE_SIZE*100.0f/CALCULATE_REG_SIZE);
-  SCMULATE_INFOMSG(1, " %ld registers of 16LINE each of %ld bytes. Total size = %ld  -- %f percent", NUM_REG_16LINE, CACHE_LINE_SIZE*16, NUM_REG_16LINE*16*CACHE_LINE_SIZE, NUM_REG_16LINE*16*CACHE_LINE_SIZE*100.0f/CALCULATE_REG_SIZE);
-  SCMULATE_INFOMSG(1, " %ld registers of 256LINE each of %ld bytes. Total size = %ld  -- %f percent", NUM_REG_256LINE, CACHE_LINE_SIZE*256, NUM_REG_256LINE*256*CACHE_LINE_SIZE, NUM_REG_256LINE*256*CACHE_LINE_SIZE*100.0f/CALCULATE_REG_SIZE);
-  SCMULATE_INFOMSG(1, " %ld registers of 512LINE each of %ld bytes. Total size = %ld  -- %f percent", NUM_REG_512LINE, CACHE_LINE_SIZE*512, NUM_REG_512LINE*512*CACHE_LINE_SIZE, NUM_REG_512LINE*512*CACHE_LINE_SIZE*100.0f/CALCULATE_REG_SIZE);
-  SCMULATE_INFOMSG(1, " %ld registers of 1024LINE each of %ld bytes. Total size = %ld  -- %f percent", NUM_REG_1024LINE, CACHE_LINE_SIZE*1024, NUM_REG_1024LINE*1024*CACHE_LINE_SIZE, NUM_REG_1024LINE*1024*CACHE_LINE_SIZE*100.0f/CALCULATE_REG_SIZE);
-  SCMULATE_INFOMSG(1, " %ld registers of 2048LINE each of %ld bytes. Total size = %ld  -- %f percent", NUM_REG_2048LINE, CACHE_LINE_SIZE*2048, NUM_REG_2048LINE*2048*CACHE_LINE_SIZE, NUM_REG_2048LINE*2048*CACHE_LINE_SIZE*100.0f/CALCULATE_REG_SIZE);
-
+  SCMULATE_INFOMSG(0, " SIZE = %ld", geometry.getUsedSize());
+  for (uint8_t sizeClass = 0; sizeClass < NUM_REG_SIZE_CLASSES; sizeClass++) {
+    SCMULATE_INFOMSG(1, " %u registers of %s, each of %u bytes. Total size = %ld  -- %f percent", geometry.numRegisters(sizeClass), 
+                     getRegisterSizeName(sizeClass), getRegisterSizeInBytes(sizeClass), 
+                     static_cast<uint64_t>(geometry.numRegisters(sizeClass))*getRegisterSizeInBytes(sizeClass),
+                     geometry.numRegisters(sizeClass)*getRegisterSizeInBytes(sizeClass)*100.0f/std::max(geometry.getUsedSize(), 1ul));
+  }
 }
 
+bool
+scm::register_geometry::readFile(const char * fileName) {
+  std::ifstream file(fileName);
+  if (!file.is_open()) {
+    SCMULATE_ERROR(0, "Could not open the machine description %s", fileName);
+    return false;
+  }
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream fields(line);
+    std::string key;
+    uint64_t value;
+    if (!(fields >> key) || key[0] == '#')
+      continue;
+    if (!(fields >> value)) {
+      SCMULATE_ERROR(0, "Missing the value of %s in the machine description %s", key.c_str(), fileName);
+      return false;
+    }
+    uint8_t sizeClass = reg_file_module::getRegisterSizeClass(key);
+    if (key == "REG_FILE_SIZE_KB") {
+      setFileSize(value*1000);
+    } else if (sizeClass < REG_SIZE_CLASSES) {
+      setNumRegisters(sizeClass, value);
+    } else {
+      SCMULATE_ERROR(0, "Unknown key %s in the machine description %s", key.c_str(), fileName);
+      return false;
+    }
+  }
+  return true;
+}
 
 bool
 scm::reg_file_module::checkRegisterConfig() {
-  if (CALCULATE_REG_SIZE > REG_FILE_SIZE_KB*1000) {
-    // This is an error, because it could cause seg fault
+  if (reg_file == nullptr) {
+    SCMULATE_ERROR(0, "THE REGISTER FILE COULD NOT BE MAPPED");
+    return 0;
+  }
+  uint64_t used = geometry.getUsedSize();
+  uint64_t size = geometry.getFileSize();
+  if (used > size) {
+    // This is an error, the registers do not fit in the cache
     SCMULATE_ERROR(0, "DEFINED REGISTER IS LARGER THAN DEFINED REG_FILE_SIZE_KB");
-    SCMULATE_ERROR(0, "REG_FILE_SIZE_KB = %ld", REG_FILE_SIZE_KB*1000l);
-    SCMULATE_ERROR(0, "CALCULATE_REG_SIZE = %ld", CALCULATE_REG_SIZE);
-    SCMULATE_ERROR(0, "EXCESS = %ld", CALCULATE_REG_SIZE - REG_FILE_SIZE_KB*1000l);
+    SCMULATE_ERROR(0, "REG_FILE_SIZE_KB = %ld", size);
+    SCMULATE_ERROR(0, "CALCULATE_REG_SIZE = %ld", used);
+    SCMULATE_ERROR(0, "EXCESS = %ld", used - size);
     return 0;
-  } else if (CALCULATE_REG_SIZE < REG_FILE_SIZE_KB*1000) {
+  } else if (used < size) {
     // This is just a warning, you are not using the whole register file
     SCMULATE_WARNING(0, "DEFINED REGISTER IS SMALLER THAN DEFINED REG_FILE_SIZE_KB");
-    SCMULATE_WARNING(0, "REG_FILE_SIZE_KB = %ld", REG_FILE_SIZE_KB*1000l);
-    SCMULATE_WARNING(0, "CALCULATE_REG_SIZE = %ld", CALCULATE_REG_SIZE);
-    SCMULATE_WARNING(0, "REMAINING = %ld", (REG_FILE_SIZE_KB*1000l) - CALCULATE_REG_SIZE);
+    SCMULATE_WARNING(0, "REG_FILE_SIZE_KB = %ld", size);
+    SCMULATE_WARNING(0, "CALCULATE_REG_SIZE = %ld", used);
+    SCMULATE_WARNING(0, "REMAINING = %ld", size - used);
   }
 
   return 1;
 }
 
 void 
-scm::reg_file_module::dumpRegister(std::string size, int num) {
+scm::reg_file_module::dumpRegister(std::string_view size, uint32_t num) {
   int len_in_bytes = getRegisterSizeInBytes(size);
+  unsigned char * reg = getRegisterByName(size, num);
+  if (reg == nullptr)
+    return;
   std::cout << "reg_" << size <<"_"<< num <<" = 0x" ;
   for (int i = 0; i < len_in_bytes; i++)
-    std::cout<< std::setfill('0')<<std::setw(2) << std::hex << static_cast<unsigned short>(getRegisterByName(size, num)[i] & 255) << (i%2 != 0? " ":"");
+    std::cout<< std::setfill('0')<<std::setw(2) << std::hex << static_cast<unsigned short>(reg[i] & 255) << (i%2 != 0? " ":"");
   std::cout << std::endl;
 
 }
 
 scm::reg_file_module::~reg_file_module() {
-  delete reg_file;
+  memory_pages::unmap(reg_file, getMappedSize());
 }
 
 
@@ -0,0 +1,95 @@
+#include "sched_policy.hpp"
+
+scm::cu_sched_policy *
+scm::cu_sched_policy::create(SCHED_POLICIES policy, control_store_module * const control_store, uint32_t numRegisters) {
+  switch (policy) {
+    case SCHED_POLICIES::ROUND_ROBIN:
+      return new cu_sched_round_robin(control_store);
+    case SCHED_POLICIES::LEAST_LOADED:
+      return new cu_sched_least_loaded(control_store);
+    case SCHED_POLICIES::REG_AFFINITY:
+      return new cu_sched_reg_affinity(control_store, numRegisters);
+    default:
+      SCMULATE_ERROR(0, "Unknown scheduling policy %d, using ROUND_ROBIN", policy);
+      return new cu_sched_round_robin(control_store);
+  }
+}
+
+int32_t
+scm::cu_sched_policy::leastLoaded() {
+  uint32_t numExecutors = this->ctrl_st_m->numExecutors();
+  int32_t selected = -1;
+  uint32_t minOccupancy = 0;
+  for (uint32_t i = 0; i < numExecutors; i++) {
+    uint32_t cur = (this->nextExecutor + i) % numExecutors;
+    execution_slot * slot = this->ctrl_st_m->get_executor(cur);
+    uint32_t occupancy = slot->occupancy();
+    if (occupancy < slot->depth() && (selected == -1 || occupancy < minOccupancy)) {
+      selected = cur;
+      minOccupancy = occupancy;
+    }
+  }
+  if (selected != -1)
+    this->nextExecutor = (selected + 1) % numExecutors;
+  return selected;
+}
+
+int32_t
+scm::cu_sched_round_robin::selectExecutor(decoded_instruction_t * inst) {
+  (void) inst;
+  uint32_t numExecutors = this->ctrl_st_m->numExecutors();
+  // Idle units first. Otherwise the instruction waits in the queue of a busy unit
+  for (int pass = 0; pass < 2; pass++) {
+    for (uint32_t attempts = 0; attempts < numExecutors; attempts++) {
+      this->nextExecutor = (this->nextExecutor + 1) % numExecutors;
+      execution_slot * slot = this->ctrl_st_m->get_executor(this->nextExecutor);
+      if (pass == 0 ? slot->is_empty() : !slot->is_full())
+        return this->nextExecutor;
+    }
+  }
+  return -1;
+}
+
+int32_t
+scm::cu_sched_reg_affinity::selectExecutor(decoded_instruction_t * inst) {
+  operand_t * ops[3] = {&inst->getOp1(), &inst->getOp2(), &inst->getOp3()};
+  uint_fast16_t io = inst->getOpIO();
+  std::fill(this->score.begin(), this->score.end(), 0);
+  for (int i = 0; i < 3; i++) {
+    if (ops[i]->type != operand_t::REGISTER || !((io >> (i*2)) & OP_IO::OP1_RD))
+      continue;
+    decoded_reg_t & reg = ops[i]->value.reg;
+    if (reg.reg_id < this->lastWriter.size() && this->lastWriter[reg.reg_id] != -1)
+      this->score[this->lastWriter[reg.reg_id]] += reg_file_module::getRegisterSizeInBytes(reg.reg_size_class);
+  }
+
+  // Only the slots in use have a CU, the writer may be a CU that left
+  int32_t selected = -1;
+  uint32_t numExecutors = this->ctrl_st_m->numExecutors();
+  for (uint32_t i = 0; i < numExecutors; i++)
+    if (this->score[i] != 0 && !this->ctrl_st_m->get_executor(i)->is_full() && (selected == -1 || this->score[i] > this->score[selected]))
+      selected = i;
+  if (selected != -1) {
+    SCMULATE_INFOMSG(5, "%s has affinity with CUMEM %d", inst->getInstruction().c_str(), selected);
+    return selected;
+  }
+  return leastLoaded();
+}
+
+void
+scm::cu_sched_reg_affinity::instructionAssigned(decoded_instruction_t * inst, uint32_t executor) {
+  operand_t * ops[3] = {&inst->getOp1(), &inst->getOp2(), &inst->getOp3()};
+  uint_fast16_t io = inst->getOpIO();
+  for (int i = 0; i < 3; i++) {
+    if (ops[i]->type != operand_t::REGISTER || !((io >> (i*2)) & OP_IO::OP1_WR))
+      continue;
+    if (ops[i]->value.reg.reg_id < this->lastWriter.size())
+      this->lastWriter[ops[i]->value.reg.reg_id] = executor;
+  }
+}
+
+void
+scm::cu_sched_reg_affinity::reset() {
+  cu_sched_policy::reset();
+  std::fill(this->lastWriter.begin(), this->lastWriter.end(), -1);
+}
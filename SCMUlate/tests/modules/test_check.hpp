@@ -0,0 +1,11 @@
+#ifndef __TEST_CHECK__
+#define __TEST_CHECK__
+
+#include <iostream>
+
+/** \brief Check a condition in the main of a test. When it does not hold, 
+ *  the condition and its line are printed and the test returns 1
+ */
+#define CHECK(cond) if (!(cond)) { std::cout << "FAILED: " #cond " (line " << __LINE__ << ")" << std::endl; return 1; }
+
+#endif // __TEST_CHECK__
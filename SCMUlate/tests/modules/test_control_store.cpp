@@ -0,0 +1,140 @@
+#include "control_store.hpp"
+#include <omp.h>
+#include <vector>
+#include <thread>
+
+#include "test_check.hpp"
+
+int main () {
+  // Capacity is rounded up to a power of two
+  scm::completion_queue small(3);
+  CHECK(small.capacity() == 4);
+  std::vector<scm::decoded_instruction_t> insts(4);
+  CHECK(small.pop() == nullptr);
+  for (auto & inst : insts)
+    CHECK(small.push(&inst));
+  CHECK(!small.push(&insts[0]));
+  CHECK(small.pop() == &insts[0] && small.pop() == &insts[1]);
+  CHECK(small.push(&insts[0]));
+
+  // Execution slots give their instructions in order
+  scm::control_store_module control_store(2, 2);
+  scm::execution_slot * slot = control_store.get_executor(1);
+  CHECK(control_store.queueDepth() == 2 && control_store.getCompletionQueue()->capacity() >= 8);
+  CHECK(slot->is_empty() && slot->steal(slot) == nullptr && slot->freeEntries() == 2);
+  CHECK(slot->assign(&insts[2]) && slot->assign(&insts[3]));
+  CHECK(slot->is_full() && !slot->assign(&insts[0]));
+  scm::decoded_instruction_t * taken = slot->steal(slot);
+  CHECK(taken == &insts[2]);
+  CHECK(slot->is_full() && slot->freeEntries() == 0 && slot->getHead() == &insts[2] && slot->pending() == 1);
+  slot->done_execution();
+  CHECK(slot->occupancy() == 1 && control_store.getCompletionQueue()->pop() == &insts[2]);
+  // An idle CU steals the pending instruction, and it completes through its own slot
+  scm::execution_slot * thief = control_store.get_executor(0);
+  taken = slot->steal(thief);
+  CHECK(taken == &insts[3] && slot->is_empty() && thief->getHead() == &insts[3]);
+  // The stolen instruction takes an entry of the queue of the thief
+  CHECK(thief->freeEntries() == 1 && thief->assign(&insts[0]) && !thief->assign(&insts[1]));
+  thief->done_execution();
+  CHECK(thief->steal(thief) == &insts[0]);
+  thief->done_execution();
+  CHECK(thief->is_empty() && control_store.getCompletionQueue()->pop() == &insts[3]);
+  CHECK(control_store.getCompletionQueue()->pop() == &insts[0]);
+
+  // A stopped run leaves instructions in the slots and in the completion queue
+  CHECK(slot->assign(&insts[0]) && slot->steal(thief) == &insts[0]);
+  CHECK(slot->assign(&insts[1]));
+  thief->done_execution();
+  control_store.reset();
+  CHECK(slot->is_empty() && thief->is_empty() && slot->freeEntries() == 2);
+  CHECK(control_store.getCompletionQueue()->pop() == nullptr);
+
+  // Slots for the CUs that join later
+  scm::control_store_module growing(0, 2, 3);
+  CHECK(growing.numExecutors() == 0 && growing.maxExecutors() == 3);
+  CHECK(growing.queueDepth() == 2 && growing.getCompletionQueue()->capacity() >= 12);
+  CHECK(growing.setNumExecutors(2) && growing.numExecutors() == 2);
+  CHECK(!growing.setNumExecutors(4) && growing.numExecutors() == 2);
+
+  // The SU keeps assigning while several CUs take from the same slot
+  const int thieves = 3, assigned = 20000;
+  std::vector<scm::decoded_instruction_t> work(assigned);
+  std::vector<int> taken_count(work.size(), 0);
+  // Each thief executes in its own slot, and the SU drains the completion queue
+  scm::control_store_module stealing(thieves + 1, 4);
+  scm::execution_slot * victim = stealing.get_executor(0);
+  uint64_t executed = 0;
+  #pragma omp parallel num_threads(thieves + 1)
+  {
+    if (omp_get_thread_num() == 0) {
+      scm::completion_queue * completed = stealing.getCompletionQueue();
+      for (int i = 0; i < assigned; i++) {
+        while (!victim->assign(&work[i])) {
+          while (completed->pop() != nullptr);
+          std::this_thread::yield();
+        }
+      }
+      while (true) {
+        uint64_t done;
+        #pragma omp atomic read
+        done = executed;
+        if (done == work.size())
+          break;
+        while (completed->pop() != nullptr);
+        std::this_thread::yield();
+      }
+    } else {
+      scm::execution_slot * mySlot = stealing.get_executor(omp_get_thread_num());
+      while (true) {
+        uint64_t done;
+        #pragma omp atomic read
+        done = executed;
+        if (done == work.size())
+          break;
+        scm::decoded_instruction_t * inst = victim->steal(mySlot);
+        if (inst) {
+          taken_count[inst - work.data()]++;
+          mySlot->done_execution();
+          #pragma omp atomic
+          executed++;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    }
+  }
+  for (auto count : taken_count)
+    CHECK(count == 1);
+
+  // Several producers and a single consumer, every instruction is seen exactly once
+  const int producers = 4, perProducer = 100000;
+  std::vector<scm::decoded_instruction_t> many(producers * perProducer);
+  std::vector<int> seen(many.size(), 0);
+  scm::completion_queue queue(16);
+  uint64_t popped = 0;
+  #pragma omp parallel num_threads(producers + 1)
+  {
+    int id = omp_get_thread_num();
+    if (id == 0) {
+      while (popped < many.size()) {
+        scm::decoded_instruction_t * inst = queue.pop();
+        if (inst) {
+          seen[inst - many.data()]++;
+          popped++;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    } else {
+      for (int i = 0; i < perProducer; i++)
+        while (!queue.push(&many[(id - 1) * perProducer + i]))
+          std::this_thread::yield();
+    }
+  }
+  for (auto count : seen)
+    CHECK(count == 1);
+  CHECK(queue.pop() == nullptr);
+
+  std::cout << "SUCCESS" << std::endl;
+  return 0;
+}
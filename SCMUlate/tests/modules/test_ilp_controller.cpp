@@ -0,0 +1,125 @@
+#include "ilp_controller.hpp"
+#include <vector>
+#include <utility>
+#include <cstdlib>
+
+#include "test_check.hpp"
+
+static scm::decoded_instruction_t codelet(uint_fast16_t io, uint32_t id1, uint32_t id2) {
+  scm::decoded_instruction_t inst(scm::EXECUTE_INST);
+  scm::operand_t op;
+  op.type = scm::operand_t::REGISTER;
+  op.value.reg.reg_id = id1;
+  inst.setOp1(op);
+  op.value.reg.reg_id = id2;
+  inst.setOp2(op);
+  inst.setOpIO(io);
+  return inst;
+}
+
+int main () {
+  // Register scoreboard
+  scm::register_geometry geometry;
+  scm::register_scoreboard scoreboard(geometry.numRegisters());
+  uint32_t r1 = geometry.getRegisterId(0, 1);
+  uint32_t r2 = geometry.getRegisterId(7, 1);
+  CHECK(r1 != r2 && r2 < geometry.numRegisters());
+  CHECK(geometry.getRegisterId(7, NUM_REG_2048LINE) == geometry.numRegisters());
+
+  // Read after read is allowed, writes wait for all the readers
+  scoreboard.mark(r1, scm::OP_IO::OP1_RD);
+  CHECK(!scoreboard.hazardExist(r1, scm::OP_IO::OP1_RD));
+  scoreboard.mark(r1, scm::OP_IO::OP1_RD);
+  CHECK(scoreboard.hazardExist(r1, scm::OP_IO::OP1_WR));
+  scoreboard.release(r1, scm::OP_IO::OP1_RD);
+  CHECK(scoreboard.hazardExist(r1, scm::OP_IO::OP1_WR));
+  scoreboard.release(r1, scm::OP_IO::OP1_RD);
+  CHECK(!scoreboard.hazardExist(r1, scm::OP_IO::OP1_WR) && scoreboard.numReservations() == 0);
+
+  // A writer blocks readers and writers of the same register only
+  scoreboard.mark(r2, scm::OP_IO::OP1_RD | scm::OP_IO::OP1_WR);
+  CHECK(scoreboard.hazardExist(r2, scm::OP_IO::OP1_RD));
+  CHECK(!scoreboard.hazardExist(r1, scm::OP_IO::OP1_WR));
+  scoreboard.release(r2, scm::OP_IO::OP1_RD | scm::OP_IO::OP1_WR);
+  CHECK(!scoreboard.hazardExist(r2, scm::OP_IO::OP1_RD) && scoreboard.numReaders(r2) == 0);
+
+  // Memory ranges
+  scm::memory_queue_controller memCtrl;
+  scm::memory_location tile(reinterpret_cast<l2_memory_t>(1000), 100);
+  scm::memory_location inside(reinterpret_cast<l2_memory_t>(1010), 10);
+  scm::memory_location around(reinterpret_cast<l2_memory_t>(900), 300);
+  scm::memory_location next(reinterpret_cast<l2_memory_t>(1100), 100);
+  memCtrl.addRange(tile, true);
+  CHECK(memCtrl.itOverlaps(tile, false));   // Same start
+  CHECK(memCtrl.itOverlaps(inside, false));
+  CHECK(memCtrl.itOverlaps(around, true));  // Contains the range
+  CHECK(!memCtrl.itOverlaps(next, true));   // Ranges are half open
+  memCtrl.removeRange(tile, true);
+  // Overlapping reads can be in flight, and the same range can be added twice
+  memCtrl.addRange(tile, false);
+  memCtrl.addRange(tile, false);
+  CHECK(!memCtrl.itOverlaps(inside, false) && memCtrl.itOverlaps(inside, true));
+  memCtrl.removeRange(tile, false);
+  CHECK(memCtrl.itOverlaps(around, true) && memCtrl.numberOfRanges() == 1);
+  memCtrl.removeRange(tile, false);
+  CHECK(!memCtrl.itOverlaps(around, true) && memCtrl.numberOfRanges() == 0);
+
+  // Interval tree against a linear search
+  scm::memory_interval_tree tree;
+  std::vector<std::pair<uint64_t, uint64_t>> ranges;
+  srand(7);
+  for (int i = 0; i < 20000; i++) {
+    uint64_t low = rand() % 5000, high = low + rand() % 200;
+    int action = rand() % 3;
+    if (action == 0 || ranges.empty()) {
+      tree.insert(low, high);
+      ranges.push_back({low, high});
+    } else if (action == 1) {
+      size_t pos = rand() % ranges.size();
+      CHECK(tree.remove(ranges[pos].first, ranges[pos].second));
+      ranges.erase(ranges.begin() + pos);
+    } else {
+      bool expected = false;
+      for (auto & r : ranges)
+        expected |= (r.first < high && low < r.second && r.first < r.second && low < high);
+      CHECK(tree.overlaps(low, high) == expected);
+    }
+    CHECK(tree.size() == ranges.size());
+  }
+
+  // Instructions that remain in the reservation table block the younger ones that depend on them
+  scm::ilp_controller ilp(scm::SUPERSCALAR, geometry.numRegisters());
+  scm::decoded_instruction_t older = codelet(scm::OP_IO::OP1_WR | scm::OP_IO::OP2_RD, r1, r2);
+  scm::decoded_instruction_t raw = codelet(scm::OP_IO::OP1_WR | scm::OP_IO::OP2_RD, r2 + 1, r1);
+  scm::decoded_instruction_t war = codelet(scm::OP_IO::OP1_WR | scm::OP_IO::OP2_RD, r2, r2 + 1);
+  scm::decoded_instruction_t independent = codelet(scm::OP_IO::OP1_WR | scm::OP_IO::OP2_RD, r2 + 1, r2);
+  scm::decoded_instruction_t commit(scm::COMMIT);
+  ilp.instructionPending(&older);
+  CHECK(!ilp.checkMarkInstructionToSched(&raw, false));
+  CHECK(!ilp.checkMarkInstructionToSched(&war, false));
+  CHECK(!ilp.checkMarkInstructionToSched(&commit, false));
+  CHECK(ilp.checkMarkInstructionToSched(&independent));
+  ilp.reservationTableScanned();
+  // The independent instruction is in flight now
+  CHECK(!ilp.checkMarkInstructionToSched(&raw, false));
+  CHECK(ilp.checkMarkInstructionToSched(&older));
+  ilp.instructionFinished(&independent);
+  CHECK(!ilp.checkMarkInstructionToSched(&raw, false));
+  ilp.instructionFinished(&older);
+  CHECK(ilp.checkMarkInstructionToSched(&raw, false));
+  CHECK(ilp.checkMarkInstructionToSched(&commit, false));
+
+  // Instructions left in flight by a run that was stopped are forgotten by reset
+  CHECK(ilp.checkMarkInstructionToSched(&older));
+  ilp.instructionPending(&raw);
+  CHECK(!ilp.checkMarkInstructionToSched(&commit, false));
+  ilp.reset();
+  CHECK(ilp.checkMarkInstructionToSched(&commit, false) && ilp.checkMarkInstructionToSched(&raw, false));
+  scm::ilp_controller sequential(scm::SEQUENTIAL, geometry.numRegisters());
+  CHECK(sequential.checkMarkInstructionToSched(&commit, false) && !sequential.checkMarkInstructionToSched(&older));
+  sequential.reset();
+  CHECK(sequential.checkMarkInstructionToSched(&older));
+
+  std::cout << "SUCCESS" << std::endl;
+  return 0;
+}
@@ -1,10 +1,52 @@
 #include "instruction_mem.hpp"
+#include "program_image.hpp"
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "test_check.hpp"
 
 int main () {
-  //scm::inst_mem_module mem_from_file("test_mem_file.txt");
-  //mem_from_file.dumpMemory();
   //scm::inst_mem_module mem_from_stdin("");
   //mem_from_stdin.dumpMemory();
+  char fileName[] = "test_mem_file.txt";
+  scm::reg_file_module reg_file_m;
+  scm::inst_mem_module mem_from_file(fileName, &reg_file_m);
+  CHECK(mem_from_file.isValid() && mem_from_file.getMemSize() == 5);
+
+  // JMPLBL targets are resolved to absolute PCs when loading
+  CHECK(mem_from_file.fetch(0)->getOp1().type == scm::operand_t::IMMEDIATE_VAL);
+  CHECK(mem_from_file.fetch(0)->getOp1().value.immediate == 4);
+  CHECK(mem_from_file.fetch(3)->getOp1().value.immediate == 1);
+  CHECK(mem_from_file.getMemoryLabel("loop") == 1);
+
+  // Loading another program replaces the instructions and the labels
+  char otherFileName[] = "test_rename_file.txt";
+  CHECK(mem_from_file.load(otherFileName) && mem_from_file.getMemSize() == 5);
+  CHECK(mem_from_file.fetch(0)->getOp1().type == scm::operand_t::REGISTER);
+  CHECK(mem_from_file.getMemoryLabel("loop") == -1);
+  CHECK(mem_from_file.load(fileName) && mem_from_file.getMemoryLabel("loop") == 1);
+
+  // Registers out of the register file are not loaded
+  char badFileName[] = "test_bad_register_file.txt";
+  CHECK(!mem_from_file.load(badFileName));
+  // Immediates that do not fit in a signed 64 bits value
+  char badImmediateFileName[] = "test_bad_immediate_file.txt";
+  CHECK(!mem_from_file.load(badImmediateFileName));
+
+  // Binary images. Truncated images and images with wrong counts are rejected before they are read
+  char imageName[] = "test_mem_file.scmb";
+  CHECK(mem_from_file.load(fileName) && mem_from_file.writeImage(imageName));
+  CHECK(mem_from_file.load(imageName) && mem_from_file.getMemSize() == 5 && mem_from_file.fetch(0)->getOp1().value.immediate == 4);
+  std::ifstream imageFile(imageName, std::ios::binary);
+  std::vector<char> image((std::istreambuf_iterator<char>(imageFile)), std::istreambuf_iterator<char>());
+  char badImageName[] = "test_bad_image.scmb";
+  std::ofstream(badImageName, std::ios::binary).write(image.data(), image.size()/2);
+  CHECK(!mem_from_file.load(badImageName));
+  reinterpret_cast<scm::image_header_t *>(image.data())->num_insts = 0x10000000;
+  std::ofstream(badImageName, std::ios::binary).write(image.data(), image.size());
+  CHECK(!mem_from_file.load(badImageName));
 
+  std::cout << "SUCCESS" << std::endl;
   return 0;
 }
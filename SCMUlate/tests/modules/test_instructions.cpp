@@ -0,0 +1,63 @@
+#include "instructions.hpp"
+
+#include "test_check.hpp"
+
+int main () {
+  // Labels and comments
+  CHECK(scm::instructions::isLabel("  loop:"));
+  CHECK(scm::instructions::getLabel("  loop_2 : // comment") == "loop_2");
+  CHECK(!scm::instructions::isLabel("  JMPLBL loop;"));
+  CHECK(scm::instructions::isComment("   // LDIMM R64B_1, 0;"));
+  CHECK(!scm::instructions::isComment("LDIMM R64B_1, 0; // comment"));
+
+  // Operands
+  CHECK(scm::instructions::isRegister("R2048L_12"));
+  CHECK(!scm::instructions::isRegister("-100"));
+  CHECK(scm::instructions::isImmediate("-100"));
+  scm::decoded_reg_t reg = scm::instructions::decodeRegister("R2048L_12");
+  CHECK(reg.reg_size_class == scm::reg_file_module::getRegisterSizeClass("2048L") && reg.reg_number == 12);
+  CHECK(scm::instructions::decodeRegister("R3L_1").reg_size_class == scm::reg_file_module::NUM_REG_SIZE_CLASSES);
+  CHECK(scm::reg_file_module::getRegisterSizeClass("64B") == scm::REG_64B && scm::reg_file_module::getRegisterSizeClass("1024L") == scm::REG_1024L);
+  CHECK(scm::reg_file_module::getRegisterSizeClass("064B") == scm::REG_SIZE_CLASSES && scm::reg_file_module::getRegisterSizeClass("2048B") == scm::REG_SIZE_CLASSES);
+  CHECK(scm::reg_file_module::getRegisterSizeClass("L") == scm::REG_SIZE_CLASSES && scm::reg_file_module::getRegisterSizeClass("4096L") == scm::REG_SIZE_CLASSES);
+
+  // Instructions
+  scm::inst_text_t text;
+  scm::decoded_instruction_t inst = scm::instructions::findInstType("  LDOFF R2048L_1, R64B_1,R64B_5; // Load", text);
+  CHECK(inst.getType() == scm::MEMORY_INST && inst.getInstruction() == "LDOFF" && inst.getOpcode() == scm::OPC_LDOFF);
+  CHECK(inst.getOp1Str() == "R2048L_1" && inst.getOp2Str() == "R64B_1" && inst.getOp3Str() == "R64B_5");
+  CHECK(inst.getOpIO() == (scm::OP_IO::OP1_WR | scm::OP_IO::OP2_RD | scm::OP_IO::OP3_RD));
+
+  inst = scm::instructions::findInstType("BREQ R64B_4, R64B_6, -8;", text);
+  CHECK(inst.getType() == scm::CONTROL_INST && inst.getOp3Str() == "-8");
+
+  inst = scm::instructions::findInstType("MULT R2048L_1, R2048L_2, 3;", text);
+  CHECK(inst.getType() == scm::BASIC_ARITH_INST && inst.getOpcode() == scm::OPC_MULT && inst.getOp3Str() == "3");
+
+  inst = scm::instructions::findInstType("JMPLBL loop;", text);
+  CHECK(inst.getType() == scm::CONTROL_INST && inst.getOp1Str() == "loop" && inst.getOpcode() == scm::OPC_JMPLBL);
+
+  inst = scm::instructions::findInstType("COD vecAdd_2048L R2048L_3, R2048L_1, R2048L_2;", text);
+  CHECK(inst.getType() == scm::EXECUTE_INST && inst.getInstruction() == "vecAdd_2048L" && inst.getOp3Str() == "R2048L_2");
+  CHECK(inst.getOpcode() == scm::OPC_CODELET);
+
+  inst = scm::instructions::findInstType("COMMIT;", text);
+  CHECK(inst.getType() == scm::COMMIT && inst.getOpcode() == scm::OPC_COMMIT);
+
+  // Decoded instructions are plain records, the text lives in a side table
+  CHECK(inst.getText() == &text && text.instruction == "COMMIT");
+
+  // Every definition has its own opcode
+  CHECK(scm::instructions::getDef(scm::OPC_STADR) != nullptr && scm::instructions::getDef(scm::OPC_STADR)->inst_name == "STADR");
+  CHECK(scm::instructions::getDef(scm::OPC_CODELET) == nullptr);
+
+  // Wrong formats are not recognized
+  const char * wrong[] = {"BREQ R64B_4, 10, 8;", "MULT R64B_1, 5, R64B_2;", "SUB R64B_1, 1, R64B_2;", "ADD R64B_1, R64B_2;", "LDIMM R64B_1, 0", "COMMIT", "FOO R64B_1;", "ADDR64B_1, 1, 1;"};
+  for (auto line : wrong) {
+    inst = scm::instructions::findInstType(line, text);
+    CHECK(inst.getType() == scm::UNKNOWN && inst.getOpcode() == scm::OPC_UNKNOWN);
+    }
+
+  std::cout << "SUCCESS" << std::endl;
+  return 0;
+}
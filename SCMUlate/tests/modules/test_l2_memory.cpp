@@ -0,0 +1,42 @@
+#include "l2_memory.hpp"
+#include <iostream>
+
+#include "test_check.hpp"
+
+int main () {
+  // The size is rounded up to huge pages, and the memory is zero until it is written
+  scm::l2_memory_module l2(3*HUGE_PAGE_SIZE - 1);
+  CHECK(l2.isValid() && l2.getSize() == 3*HUGE_PAGE_SIZE);
+  CHECK(reinterpret_cast<uintptr_t>(l2.getMemory()) % HUGE_PAGE_SIZE == 0);
+  std::cout << "L2 memory with " << scm::memory_pages::getName(l2.getPages()) << std::endl;
+  CHECK(l2.getMemory()[0] == 0 && l2.getMemory()[l2.getSize() - 1] == 0);
+
+  // First fit, aligned
+  l2_memory_t A = l2.l2Malloc(100);
+  l2_memory_t B = l2.l2Malloc(100);
+  l2_memory_t C = l2.l2Malloc(1000, 4096);
+  CHECK(A == l2.getMemory() && l2.offsetOf(B) == 128 && l2.offsetOf(C) == 4096);
+  CHECK(l2.getAddress(l2.offsetOf(C)) == C);
+  CHECK(l2.freeBytes() == l2.getSize() - 1200);
+  CHECK(l2.l2Malloc(l2.getSize()) == nullptr);
+
+  // The gap before C is used again
+  l2_memory_t D = l2.l2Malloc(1000);
+  CHECK(l2.offsetOf(D) == 256);
+
+  // Freed arrays are merged with the free ranges next to them
+  CHECK(!l2.l2Free(A + 1));
+  CHECK(l2.l2Free(A) && l2.l2Free(B) && l2.l2Free(D));
+  CHECK(!l2.l2Free(B));
+  CHECK(l2.l2Malloc(4096) == A);
+  CHECK(l2.l2Free(A) && l2.l2Free(C));
+  CHECK(l2.freeBytes() == l2.getSize());
+  CHECK(l2.l2Malloc(l2.getSize()) == l2.getMemory());
+
+  // Normal pages
+  scm::l2_memory_module small(4096, false);
+  CHECK(small.isValid() && small.getPages() == scm::SMALL_PAGES && small.getSize() == HUGE_PAGE_SIZE);
+
+  std::cout << "SUCCESS" << std::endl;
+  return 0;
+}
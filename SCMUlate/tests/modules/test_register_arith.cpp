@@ -0,0 +1,143 @@
+#include "register_arith.hpp"
+#include <iostream>
+#include <vector>
+#include <random>
+
+#include "test_check.hpp"
+
+using scm::register_arith;
+
+// Registers are big-endian
+static void setValue(unsigned char * reg, uint32_t size, uint64_t value) {
+  for (uint32_t i = 0; i < size; i++, value >>= 8)
+    reg[size - 1 - i] = i < 8 ? value & 255 : 0;
+}
+
+static bool isValue(const unsigned char * reg, uint32_t size, uint64_t low, unsigned char high) {
+  for (uint32_t i = 0; i < size; i++, low >>= 8)
+    if (reg[size - 1 - i] != (i < 8 ? (low & 255) : high))
+      return false;
+  return true;
+}
+
+// Byte by byte product, truncated to the size of r
+static void mulReference(unsigned char * r, uint32_t rSize, const unsigned char * a, uint32_t aSize, const unsigned char * b, uint32_t bSize) {
+  std::vector<uint32_t> acc(rSize + 1, 0);
+  for (uint32_t i = 0; i < aSize; i++)
+    for (uint32_t j = 0; j < bSize && i + j < rSize; j++)
+      acc[i + j] += a[aSize - 1 - i]*b[bSize - 1 - j];
+  uint64_t carry = 0;
+  for (uint32_t k = 0; k < rSize; k++) {
+    carry += acc[k];
+    r[rSize - 1 - k] = carry & 255;
+    carry >>= 8;
+  }
+}
+
+int main () {
+  unsigned char a[8], b[8], c[8];
+
+  // R64B
+  setValue(a, 8, 0x1122334455667788);
+  setValue(b, 8, 0x0102030405060708);
+  CHECK(!register_arith::add(c, 8, a, 8, b, 8) && isValue(c, 8, 0x122436485a6c7e90, 0));
+  CHECK(!register_arith::sub(c, 8, a, 8, b, 8) && isValue(c, 8, 0x1020304050607080, 0));
+  CHECK(register_arith::sub(c, 8, b, 8, a, 8));
+  setValue(a, 8, ~0ul);
+  CHECK(register_arith::addImmediate(c, 8, a, 8, 1) && isValue(c, 8, 0, 0));
+
+  // Signed immediates
+  setValue(a, 8, 10);
+  CHECK(!register_arith::addImmediate(c, 8, a, 8, -3) && isValue(c, 8, 7, 0));
+  CHECK(!register_arith::subImmediate(c, 8, a, 8, -3) && isValue(c, 8, 13, 0));
+  CHECK(register_arith::addImmediate(c, 8, a, 8, -11));
+  CHECK(register_arith::subImmediate(c, 8, a, 8, 11));
+  // The result can be the source
+  CHECK(!register_arith::subImmediate(a, 8, a, 8, 10) && isValue(a, 8, 0, 0));
+
+  // Wide registers, the carry goes through all the limbs
+  const uint32_t wide = 64*16;
+  unsigned char wa[wide], wb[wide], wc[wide];
+  setValue(wa, wide, ~0ul);
+  CHECK(!register_arith::addImmediate(wc, wide, wa, wide, 1) && wc[wide - 9] == 1 && wc[wide - 1] == 0);
+  CHECK(!register_arith::subImmediate(wa, wide, wc, wide, 1) && isValue(wa, wide, ~0ul, 0));
+  setValue(wb, wide, 0);
+  CHECK(register_arith::subImmediate(wc, wide, wb, wide, 1) && isValue(wc, wide, ~0ul, 255));
+  CHECK(register_arith::add(wb, wide, wc, wide, wc, wide) && isValue(wb, wide, ~1ul, 255));
+  CHECK(!register_arith::sub(wa, wide, wc, wide, wc, wide) && isValue(wa, wide, 0, 0));
+
+  // A smaller source is extended with zeros
+  setValue(a, 8, 5);
+  CHECK(register_arith::add(wb, wide, wc, wide, a, 8) && isValue(wb, wide, 4, 0));
+  CHECK(register_arith::sub(wa, wide, wb, wide, a, 8) && isValue(wa, wide, ~0ul, 255));
+  setValue(wb, wide, 7);
+  CHECK(!register_arith::sub(wa, wide, wb, wide, a, 8) && isValue(wa, wide, 2, 0));
+
+  // Shifts, R64B and wide registers
+  setValue(a, 8, 0x8000000000000001);
+  register_arith::shiftLeft(a, 8, 1);
+  CHECK(isValue(a, 8, 2, 0));
+  register_arith::shiftRight(a, 8, 1);
+  CHECK(isValue(a, 8, 1, 0));
+  register_arith::shiftLeft(a, 8, 64);
+  CHECK(isValue(a, 8, 0, 0));
+  setValue(wa, wide, 0x8000000000000001);
+  register_arith::shiftLeft(wa, wide, 1);
+  CHECK(wa[wide - 9] == 1 && wa[wide - 1] == 2);
+  register_arith::shiftLeft(wa, wide, 64*100 + 7);
+  CHECK(wa[wide - 802] == 1 && wa[wide - 809] == 128 && wa[wide - 1] == 0);
+  register_arith::shiftRight(wa, wide, 64*100 + 8);
+  CHECK(isValue(wa, wide, 0x8000000000000001, 0));
+  register_arith::shiftRight(wa, wide, wide*8);
+  CHECK(isValue(wa, wide, 0, 0));
+  setValue(a, 8, 1);
+  setValue(wb, wide, 3);
+  register_arith::shiftLeft(wb, wide, 200);
+  CHECK(register_arith::toUint64(wb, wide) == UINT64_MAX);
+  register_arith::shiftRight(wb, wide, 200);
+  CHECK(register_arith::toUint64(wb, wide) == 3 && register_arith::toUint64(a, 8) == 1);
+
+  // MULT, R64B
+  setValue(a, 8, 1000000007);
+  setValue(b, 8, 998244353);
+  register_arith::mult(c, 8, a, 8, b, 8);
+  CHECK(isValue(c, 8, 1000000007ul*998244353ul, 0));
+  register_arith::multImmediate(c, 8, c, 8, 4);
+  CHECK(isValue(c, 8, 1000000007ul*998244353ul*4, 0));
+  // A power of two is a shift
+  setValue(wa, wide, 0x123456789abcdef);
+  register_arith::shiftLeft(wa, wide, 3000);
+  std::vector<unsigned char> shifted(wa, wa + wide);
+  setValue(wa, wide, 0x123456789abcdef);
+  setValue(wb, wide, 1);
+  register_arith::shiftLeft(wb, wide, 3000);
+  register_arith::mult(wc, wide, wa, wide, wb, wide);
+  CHECK(std::equal(shifted.begin(), shifted.end(), wc));
+
+  // Schoolbook and Karatsuba against the byte by byte product, the destination can be smaller or larger
+  std::mt19937_64 random(42);
+  for (uint32_t size : {8u, 64u, 64u*8, 64u*16}) {
+    std::vector<unsigned char> x(size), y(size), product(2*size), expected(2*size);
+    for (auto & byte : x)
+      byte = random();
+    for (auto & byte : y)
+      byte = random();
+    for (uint32_t dstSize : {size/2 < 8 ? 8 : size/2, size, 2*size}) {
+      register_arith::mult(product.data(), dstSize, x.data(), size, y.data(), size);
+      mulReference(expected.data(), dstSize, x.data(), size, y.data(), size);
+      CHECK(std::equal(expected.begin(), expected.begin() + dstSize, product.begin()));
+    }
+    // Operands of different size
+    register_arith::mult(product.data(), 2*size, x.data(), size, y.data(), 8);
+    mulReference(expected.data(), 2*size, x.data(), size, y.data(), 8);
+    CHECK(std::equal(expected.begin(), expected.end(), product.begin()));
+  }
+  // All bits set is the worst case for the carries of Karatsuba
+  std::vector<unsigned char> ones(wide, 255), product(2*wide), expected(2*wide);
+  register_arith::mult(product.data(), 2*wide, ones.data(), wide, ones.data(), wide);
+  mulReference(expected.data(), 2*wide, ones.data(), wide, ones.data(), wide);
+  CHECK(std::equal(expected.begin(), expected.end(), product.begin()));
+
+  std::cout << "SUCCESS" << std::endl;
+  return 0;
+}
@@ -1,5 +1,7 @@
 #include "register.hpp"
 
+#include "test_check.hpp"
+
 int main () {
   scm::reg_file_module reg_file_m;
 
@@ -7,5 +9,41 @@ int main () {
 
   reg_file_m.dumpRegister("64B", 1);
 
+  // All the size classes are in the same mapping, the registers of lines are aligned
+  CHECK(reinterpret_cast<uintptr_t>(reg_file_m.getSpace()) % HUGE_PAGE_SIZE == 0);
+  for (uint8_t sizeClass = 1; sizeClass < scm::reg_file_module::NUM_REG_SIZE_CLASSES; sizeClass++)
+    CHECK(reinterpret_cast<uintptr_t>(reg_file_m.getRegisterByClass(sizeClass, 1)) % CACHE_LINE_SIZE == 0);
+
+  // Zeroing the registers in parts
+  unsigned char * last = reg_file_m.getRegisterByName("2048L", NUM_REG_2048LINE - 1);
+  last[0] = 1;
+  reg_file_m.reset(0, 3);
+  CHECK(reg_file_m.getRegisterByName("64B", 1)[0] == 0 && last[0] == 1);
+  reg_file_m.reset(2, 3);
+  CHECK(last[0] == 0);
+
+  // Registers that do not exist
+  CHECK(reg_file_m.getRegisterByName("2048L", NUM_REG_2048LINE) == nullptr);
+  CHECK(reg_file_m.getRegisterByName("2048L", 99) == nullptr && reg_file_m.getRegisterByName("3L", 0) == nullptr);
+  CHECK(reg_file_m.getRegisterByClass(scm::REG_SIZE_CLASSES, 0) == nullptr);
+
+  // Geometry from a machine description
+  scm::register_geometry geometry;
+  CHECK(geometry.numRegisters() == reg_file_m.numRegisters() && geometry.numRegisters(7) == NUM_REG_2048LINE);
+  CHECK(!geometry.readFile("missing_machine_file.txt"));
+  CHECK(geometry.readFile("test_machine_file.txt"));
+  CHECK(geometry.getFileSize() == 4096*1000 && geometry.numRegisters() == 50 && geometry.numRegisters(7) == 30);
+  CHECK(geometry.getRegisterId(7, 0) == 20 && geometry.getRegisterId(7, 30) == 50 && geometry.getRegisterId(1, 0) == 50);
+  // The first 2048L register is aligned after the 64B registers
+  CHECK(geometry.getOffset(7, 1) == 3*64 + 64*2048 && geometry.getUsedSize() == 3*64 + 30*64*2048);
+  scm::reg_file_module tiles_m(geometry);
+  CHECK(tiles_m.checkRegisterConfig() && tiles_m.numRegisters() == 50);
+  CHECK(tiles_m.getRegisterByName("2048L", 29) == tiles_m.getSpace() + geometry.getOffset(7, 29));
+  tiles_m.getRegisterByName("2048L", 29)[64*2048 - 1] = 1;
+  geometry.setNumRegisters(7, 40);
+  scm::reg_file_module tooLarge_m(geometry);
+  CHECK(!tooLarge_m.checkRegisterConfig());
+
+  std::cout << "SUCCESS" << std::endl;
   return 0;
 }
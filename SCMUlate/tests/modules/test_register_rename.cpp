@@ -0,0 +1,53 @@
+#include "register_rename.hpp"
+
+#include "test_check.hpp"
+
+int main () {
+  char fileName[] = "test_rename_file.txt";
+  scm::reg_file_module reg_file_m;
+  scm::inst_mem_module inst_mem_m(fileName, &reg_file_m);
+  CHECK(inst_mem_m.isValid() && inst_mem_m.getMemSize() == 5);
+
+  const uint8_t sizeClass = 7; // 2048L
+  uint32_t arch = reg_file_m.getRegisterId(sizeClass, 1);
+  scm::register_rename_module rename(&inst_mem_m, &reg_file_m, 4, true);
+  // Only R2048L_1 is used by the program, the rest of the 2048L registers are physical registers
+  uint32_t poolSize = rename.numFreeRegisters(sizeClass);
+  CHECK(poolSize == NUM_REG_2048LINE - 1);
+  CHECK(rename.getMapping(arch) == arch);
+
+  // Each load gets a new register, and the store that follows it reads that register
+  scm::decoded_instruction_t * load1 = rename.rename(inst_mem_m.fetch(0));
+  scm::decoded_instruction_t * store1 = rename.rename(inst_mem_m.fetch(1));
+  scm::decoded_instruction_t * load2 = rename.rename(inst_mem_m.fetch(2));
+  scm::decoded_instruction_t * store2 = rename.rename(inst_mem_m.fetch(3));
+  CHECK(load1 != inst_mem_m.fetch(0) && inst_mem_m.fetch(0)->getOp1().value.reg.reg_id == arch);
+  uint32_t phys1 = load1->getOp1().value.reg.reg_id;
+  uint32_t phys2 = load2->getOp1().value.reg.reg_id;
+  CHECK(phys1 != arch && phys2 != arch && phys1 != phys2);
+  CHECK(store1->getOp1().value.reg.reg_id == phys1 && store2->getOp1().value.reg.reg_id == phys2);
+  CHECK(store2->getOp1().value.reg.reg_ptr == reg_file_m.getRegisterByClass(sizeClass, phys2 - reg_file_m.getRegisterId(sizeClass, 0)));
+  CHECK(rename.getMapping(arch) == phys2 && rename.numRenamed() == 2);
+  // The 64 bits registers are not renamed
+  CHECK(load1->getOp2().value.reg.reg_id == inst_mem_m.fetch(0)->getOp2().value.reg.reg_id);
+  // All the entries are in use
+  CHECK(rename.rename(inst_mem_m.fetch(4)) == nullptr);
+
+  // The first register is released when the instructions that use it commit
+  CHECK(rename.numFreeRegisters(sizeClass) == poolSize - 2);
+  rename.retire(load1);
+  CHECK(rename.numFreeRegisters(sizeClass) == poolSize - 2);
+  rename.retire(store1);
+  CHECK(rename.numFreeRegisters(sizeClass) == poolSize - 1);
+
+  // The last value of R2048L_1 is copied back into the architectural register
+  store2->getOp1().value.reg.reg_ptr[0] = 42;
+  rename.retire(load2);
+  rename.retire(store2);
+  rename.commit();
+  CHECK(reg_file_m.getRegisterByClass(sizeClass, 1)[0] == 42);
+  CHECK(rename.getMapping(arch) == arch && rename.numFreeRegisters(sizeClass) == poolSize);
+
+  std::cout << "SUCCESS" << std::endl;
+  return 0;
+}
@@ -0,0 +1,93 @@
+#include "sched_policy.hpp"
+#include <vector>
+
+#include "test_check.hpp"
+
+// Default register file
+static const scm::register_geometry geometry;
+
+static scm::decoded_instruction_t codelet(uint_fast16_t io, uint8_t class1, uint32_t num1, uint8_t class2, uint32_t num2) {
+  scm::decoded_instruction_t inst(scm::EXECUTE_INST);
+  scm::operand_t op;
+  op.type = scm::operand_t::REGISTER;
+  op.value.reg.reg_size_class = class1;
+  op.value.reg.reg_id = geometry.getRegisterId(class1, num1);
+  inst.setOp1(op);
+  op.value.reg.reg_size_class = class2;
+  op.value.reg.reg_id = geometry.getRegisterId(class2, num2);
+  inst.setOp2(op);
+  inst.setOpIO(io);
+  return inst;
+}
+
+// Select a CU with the policy and assign the instruction to it
+static int32_t schedule(scm::cu_sched_policy * policy, scm::control_store_module & ctrl, scm::decoded_instruction_t * inst) {
+  int32_t cu = policy->selectExecutor(inst);
+  if (cu != -1 && ctrl.get_executor(cu)->assign(inst))
+    policy->instructionAssigned(inst, cu);
+  return cu;
+}
+
+int main () {
+  std::vector<scm::decoded_instruction_t> insts(12, scm::decoded_instruction_t(scm::EXECUTE_INST));
+
+  // Round robin prefers idle CUs, then any CU with room in its queue
+  scm::control_store_module rrCtrl(3, 2);
+  scm::cu_sched_policy * rr = scm::cu_sched_policy::create(scm::ROUND_ROBIN, &rrCtrl, geometry.numRegisters());
+  CHECK(schedule(rr, rrCtrl, &insts[0]) == 1);
+  CHECK(schedule(rr, rrCtrl, &insts[1]) == 2);
+  CHECK(schedule(rr, rrCtrl, &insts[2]) == 0);
+  CHECK(schedule(rr, rrCtrl, &insts[3]) == 1);
+  CHECK(schedule(rr, rrCtrl, &insts[4]) == 2);
+  CHECK(schedule(rr, rrCtrl, &insts[5]) == 0);
+  CHECK(schedule(rr, rrCtrl, &insts[6]) == -1);
+  delete rr;
+
+  // Least loaded selects the shortest queue
+  scm::control_store_module llCtrl(3, 2);
+  scm::cu_sched_policy * ll = scm::cu_sched_policy::create(scm::LEAST_LOADED, &llCtrl, geometry.numRegisters());
+  llCtrl.get_executor(0)->assign(&insts[0]);
+  llCtrl.get_executor(0)->assign(&insts[1]);
+  llCtrl.get_executor(2)->assign(&insts[2]);
+  CHECK(schedule(ll, llCtrl, &insts[3]) == 1);
+  CHECK(schedule(ll, llCtrl, &insts[4]) == 1 || llCtrl.get_executor(2)->is_full());
+  CHECK(schedule(ll, llCtrl, &insts[5]) != 0);
+  CHECK(schedule(ll, llCtrl, &insts[6]) == -1);
+  delete ll;
+
+  // Register affinity follows the CU that wrote the largest input registers
+  scm::control_store_module afCtrl(3, 2);
+  scm::cu_sched_reg_affinity affinity(&afCtrl, geometry.numRegisters());
+  scm::decoded_instruction_t loadA = codelet(scm::OP_IO::OP1_WR | scm::OP_IO::OP2_RD, 7, 1, 0, 1);
+  scm::decoded_instruction_t loadB = codelet(scm::OP_IO::OP1_WR | scm::OP_IO::OP2_RD, 0, 2, 0, 1);
+  scm::decoded_instruction_t mult = codelet(scm::OP_IO::OP1_RD | scm::OP_IO::OP2_RD, 7, 1, 0, 2);
+  // Nothing was written yet, least loaded
+  int32_t cuA = schedule(&affinity, afCtrl, &loadA);
+  int32_t cuB = schedule(&affinity, afCtrl, &loadB);
+  CHECK(cuA != -1 && cuB != -1 && cuA != cuB);
+  CHECK(affinity.getLastWriter(loadA.getOp1().value.reg.reg_id) == cuA);
+  CHECK(affinity.getLastWriter(loadA.getOp2().value.reg.reg_id) == -1);
+  CHECK(schedule(&affinity, afCtrl, &mult) == cuA);
+  // The CU of the tile is full, the CU that wrote the other input is next
+  scm::decoded_instruction_t mult2 = mult;
+  CHECK(schedule(&affinity, afCtrl, &mult2) == cuB);
+  // Otherwise the least loaded CU
+  scm::decoded_instruction_t mult3 = codelet(scm::OP_IO::OP1_RD, 7, 1, 0, 0);
+  int32_t other = schedule(&affinity, afCtrl, &mult3);
+  CHECK(other != -1 && other != cuA && other != cuB);
+
+  // Only the slots in use are selected, and the writers are forgotten with the program
+  scm::control_store_module partCtrl(0, 2, 3);
+  CHECK(partCtrl.setNumExecutors(3));
+  scm::cu_sched_reg_affinity partAffinity(&partCtrl, geometry.numRegisters());
+  partAffinity.instructionAssigned(&loadA, 2);
+  CHECK(partAffinity.selectExecutor(&mult) == 2);
+  CHECK(partCtrl.setNumExecutors(2));
+  int32_t remaining = partAffinity.selectExecutor(&mult);
+  CHECK(remaining == 0 || remaining == 1);
+  partAffinity.reset();
+  CHECK(partAffinity.getLastWriter(loadA.getOp1().value.reg.reg_id) == -1);
+
+  std::cout << "SUCCESS" << std::endl;
+  return 0;
+}
@@ -0,0 +1,49 @@
+#include "scm_machine.hpp"
+#include <vector>
+
+#include "test_check.hpp"
+
+// Copied by test_run_file.txt
+static const uint64_t COPY_SIZE = 131072;
+static const uint64_t COPY_DESTINATION = 262144;
+
+static uint64_t readRegister64B(scm::scm_machine & machine, uint32_t num) {
+  unsigned char * reg = machine.getRegFile()->getRegisterByClass(scm::REG_64B, num);
+  uint64_t value = 0;
+  for (int i = 0; i < 8; i++)
+    value = (value << 8) | reg[i];
+  return value;
+}
+
+int main () {
+  char runFile[] = "test_run_file.txt";
+  char errorFile[] = "test_run_error_file.txt";
+  scm::ILP_MODES modes[] = {scm::SEQUENTIAL, scm::SUPERSCALAR, scm::SEQUENTIAL, scm::SUPERSCALAR};
+  for (int test = 0; test < 4; test++) {
+    scm::ILP_MODES mode = modes[test];
+    scm::threads_config threads(2, std::vector<int>());
+    threads.setBackend(test < 2 ? scm::OPENMP_BACKEND : scm::STD_THREAD_BACKEND);
+    scm::scm_machine machine(runFile, 4*COPY_DESTINATION, mode, scm::ROUND_ROBIN, threads, false);
+    l2_memory_t memory = machine.getL2Memory()->getMemory();
+    for (uint64_t i = 0; i < COPY_SIZE; i++)
+      memory[i] = i % 251;
+
+    // The same program runs again
+    for (int run = 0; run < 3; run++) {
+      CHECK(machine.run() == scm::SCM_RUN_SUCCESS);
+      CHECK(readRegister64B(machine, 3) == 12);
+      CHECK(memory[COPY_DESTINATION + COPY_SIZE - 1] == (COPY_SIZE - 1) % 251);
+    }
+
+    // A program stopped by an error leaves instructions in flight, the next program still runs
+    CHECK(machine.load(errorFile));
+    CHECK(machine.run() == scm::SCM_RUN_FAILURE);
+    CHECK(machine.load(runFile));
+    machine.reset();
+    CHECK(machine.run() == scm::SCM_RUN_SUCCESS);
+    CHECK(readRegister64B(machine, 3) == 12);
+  }
+
+  std::cout << "SUCCESS" << std::endl;
+  return 0;
+}
@@ -0,0 +1,51 @@
+#include "scm_multi_machine.hpp"
+#include <vector>
+
+#include "test_check.hpp"
+
+// Copied by test_run_file.txt
+static const uint64_t COPY_SIZE = 131072;
+static const uint64_t COPY_DESTINATION = 262144;
+
+int main () {
+  char runFile[] = "test_run_file.txt";
+  char errorFile[] = "test_run_error_file.txt";
+  scm::ILP_MODES modes[] = {scm::SEQUENTIAL, scm::SUPERSCALAR};
+  // One SU that runs all the programs one after the other, and two SUs that share three CUs
+  uint32_t numSUs[] = {1, 2};
+  uint32_t numCUs[] = {1, 3};
+  for (scm::ILP_MODES mode : modes) {
+    for (int config = 0; config < 2; config++) {
+      scm::threads_config threads(numCUs[config], std::vector<int>());
+      scm::scm_multi_machine machine(numSUs[config], mode, scm::ROUND_ROBIN, threads);
+      CHECK(machine.isValid());
+
+      // A failed program does not stop the programs that run after it in the same SU
+      const int numJobs = 5;
+      std::vector<std::vector<unsigned char>> memories(numJobs, std::vector<unsigned char>(4*COPY_DESTINATION, 0));
+      std::vector<scm::scm_job_t> batch;
+      for (int job = 0; job < numJobs; job++) {
+        for (uint64_t i = 0; i < COPY_SIZE; i++)
+          memories[job][i] = (i + job) % 251;
+        batch.emplace_back(job == 1 ? errorFile : runFile, memories[job].data());
+      }
+      CHECK(machine.run(batch) == scm::SCM_RUN_FAILURE);
+      for (int job = 0; job < numJobs; job++) {
+        CHECK(batch[job].su != -1);
+        if (job == 1) {
+          CHECK(batch[job].status == scm::SCM_RUN_FAILURE);
+        } else {
+          CHECK(batch[job].status == scm::SCM_RUN_SUCCESS);
+          CHECK(memories[job][COPY_DESTINATION + COPY_SIZE - 1] == (COPY_SIZE - 1 + job) % 251);
+        }
+      }
+
+      // The machine runs another batch
+      batch.erase(batch.begin() + 1);
+      CHECK(machine.run(batch) == scm::SCM_RUN_SUCCESS);
+    }
+  }
+
+  std::cout << "SUCCESS" << std::endl;
+  return 0;
+}
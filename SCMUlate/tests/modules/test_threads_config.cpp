@@ -0,0 +1,66 @@
+#include "threads_configuration.hpp"
+#include "numa_placement.hpp"
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <unistd.h>
+
+#include "test_check.hpp"
+
+int main () {
+  // CPU lists
+  std::vector<int> cpus;
+  CHECK(scm::threads_config::parseCPUList("0,2,4-6", cpus));
+  CHECK(cpus == std::vector<int>({0, 2, 4, 5, 6}));
+  CHECK(scm::threads_config::parseCPUList("3", cpus) && cpus.size() == 1 && cpus[0] == 3);
+  CHECK(!scm::threads_config::parseCPUList("", cpus));
+  CHECK(!scm::threads_config::parseCPUList("1,a", cpus));
+  CHECK(!scm::threads_config::parseCPUList("5-2", cpus));
+
+  std::vector<int> available = scm::threads_config::availableCPUs();
+  CHECK(!available.empty());
+
+  // The SU and one CU per thread
+  scm::threads_config unpinned(3, std::vector<int>());
+  CHECK(unpinned.isValid() && unpinned.numThreads() == 4 && !unpinned.isPinned());
+  CHECK(unpinned.getCPU(0) == -1 && unpinned.pinThread(0));
+
+  // The map needs a distinct CPU for each thread
+  CHECK(!scm::threads_config(1, std::vector<int>({available[0]})).isValid());
+  CHECK(!scm::threads_config(1, std::vector<int>({available[0], available[0]})).isValid());
+  CHECK(!scm::threads_config(0, std::vector<int>()).isValid());
+  CHECK(!scm::threads_config(1, "x").isValid());
+
+  // Not pinned by default. The automatic map is pinned only if there are enough CPUs
+  scm::threads_config defaults(available.size());
+  CHECK(defaults.isValid() && !defaults.isPinned());
+  if (available.size() > 1) {
+    scm::threads_config automatic(available.size() - 1, "auto");
+    CHECK(automatic.isValid() && automatic.isPinned() && automatic.getCPU(0) == available[0]);
+    CHECK(automatic.pinThread(0));
+  }
+  scm::threads_config tooMany(available.size(), "auto");
+  CHECK(tooMany.isValid() && !tooMany.isPinned());
+
+  // NUMA topology and placement
+  scm::NUMA_PLACEMENTS placement;
+  CHECK(scm::threads_config::parsePlacement("blocked", placement) && placement == scm::NUMA_BLOCKED);
+  CHECK(!scm::threads_config::parsePlacement("local", placement));
+  CHECK(unpinned.getNode(1) == -1 && unpinned.cuNodes().empty());
+  std::vector<int> nodes = scm::numa_placement::memoryNodes();
+  if (!nodes.empty()) {
+    size_t size = 4*sysconf(_SC_PAGESIZE);
+    unsigned char * buffer = static_cast<unsigned char *>(aligned_alloc(sysconf(_SC_PAGESIZE), size));
+    // mbind may not be allowed, e.g. in a container
+    if (scm::numa_placement::bind(buffer, size, nodes.back())) {
+      memset(buffer, 1, size);
+      CHECK(scm::numa_placement::nodeOfAddress(buffer + size - 1) == nodes.back());
+    }
+    CHECK(scm::numa_placement::interleave(buffer, size, std::vector<int>()));
+    free(buffer);
+  }
+
+  std::cout << "SUCCESS" << std::endl;
+  return 0;
+}